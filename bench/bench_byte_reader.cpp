@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/byte_reader.hpp>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using cpp_result::ByteReader;
+using cpp_result::DecodeError;
+
+// Reference reader reporting out-of-bounds reads with exceptions.
+class ThrowingReader {
+public:
+  ThrowingReader(const std::byte *data, std::size_t size)
+      : pos_(data), end_(data + size) {}
+
+  template <typename T> T read() {
+    if (static_cast<std::size_t>(end_ - pos_) < sizeof(T))
+      throw std::out_of_range("read past end");
+    T value;
+    std::memcpy(&value, pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  std::uint64_t read_varint() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      auto b = static_cast<std::uint64_t>(read<std::byte>());
+      value |= (b & 0x7f) << shift;
+      if (!(b & 0x80))
+        return value;
+    }
+    throw std::overflow_error("varint too long");
+  }
+
+  std::string_view read_string_view() {
+    auto len = read_varint();
+    if (static_cast<std::uint64_t>(end_ - pos_) < len)
+      throw std::out_of_range("read past end");
+    std::string_view s(reinterpret_cast<const char *>(pos_), len);
+    pos_ += len;
+    return s;
+  }
+
+  bool empty() const { return pos_ == end_; }
+
+private:
+  const std::byte *pos_;
+  const std::byte *end_;
+};
+
+// Records of {u32 id, u16 flags, varint value, length-prefixed name}.
+static std::vector<std::byte> make_records(int n) {
+  std::vector<std::byte> out;
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < n; ++i) {
+    std::uint32_t id = static_cast<std::uint32_t>(i);
+    std::uint16_t flags = static_cast<std::uint16_t>(rng());
+    const auto *p = reinterpret_cast<const std::byte *>(&id);
+    out.insert(out.end(), p, p + sizeof(id));
+    p = reinterpret_cast<const std::byte *>(&flags);
+    out.insert(out.end(), p, p + sizeof(flags));
+    std::uint64_t v = rng() >> (rng() % 64);
+    while (v >= 0x80) {
+      out.push_back(static_cast<std::byte>((v & 0x7f) | 0x80));
+      v >>= 7;
+    }
+    out.push_back(static_cast<std::byte>(v));
+    std::size_t len = rng() % 24;
+    out.push_back(static_cast<std::byte>(len));
+    for (std::size_t j = 0; j < len; ++j)
+      out.push_back(static_cast<std::byte>('a' + j));
+  }
+  return out;
+}
+
+static void BM_ByteReader_Result(benchmark::State &state) {
+  auto buf = make_records(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    ByteReader r(buf.data(), buf.size());
+    std::uint64_t sum = 0;
+    while (!r.empty()) {
+      auto id = r.read<std::uint32_t>();
+      auto flags = r.read<std::uint16_t>();
+      auto value = r.read_varint();
+      auto name = r.read_string_view();
+      if (id.is_err() || flags.is_err() || value.is_err() || name.is_err())
+        break;
+      sum += id.unwrap() + flags.unwrap() + value.unwrap() +
+             name.unwrap().size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(buf.size()));
+}
+BENCHMARK(BM_ByteReader_Result)->Arg(1000)->Arg(100000);
+
+static void BM_ByteReader_Reserve(benchmark::State &state) {
+  auto buf = make_records(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    ByteReader r(buf.data(), buf.size());
+    std::uint64_t sum = 0;
+    while (!r.empty()) {
+      auto fixed = r.reserve(sizeof(std::uint32_t) + sizeof(std::uint16_t));
+      if (fixed.is_err())
+        break;
+      auto &rec = fixed.unwrap();
+      sum += rec.read<std::uint32_t>();
+      sum += rec.read<std::uint16_t>();
+      auto value = r.read_varint();
+      auto name = r.read_string_view();
+      if (value.is_err() || name.is_err())
+        break;
+      sum += value.unwrap() + name.unwrap().size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(buf.size()));
+}
+BENCHMARK(BM_ByteReader_Reserve)->Arg(1000)->Arg(100000);
+
+static void BM_ByteReader_Throwing(benchmark::State &state) {
+  auto buf = make_records(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    ThrowingReader r(buf.data(), buf.size());
+    std::uint64_t sum = 0;
+    try {
+      while (!r.empty()) {
+        sum += r.read<std::uint32_t>();
+        sum += r.read<std::uint16_t>();
+        sum += r.read_varint();
+        sum += r.read_string_view().size();
+      }
+    } catch (const std::exception &) {
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(buf.size()));
+}
+BENCHMARK(BM_ByteReader_Throwing)->Arg(1000)->Arg(100000);
+
+// Truncated inputs: every decode ends with an out-of-bounds read.
+static void BM_ByteReader_Result_Truncated(benchmark::State &state) {
+  auto buf = make_records(1);
+  for (auto _ : state) {
+    ByteReader r(buf.data(), buf.size() - 1);
+    auto id = r.read<std::uint32_t>();
+    auto flags = r.read<std::uint16_t>();
+    auto value = r.read_varint();
+    auto name = r.read_string_view();
+    benchmark::DoNotOptimize(id);
+    benchmark::DoNotOptimize(flags);
+    benchmark::DoNotOptimize(value);
+    benchmark::DoNotOptimize(name);
+  }
+}
+BENCHMARK(BM_ByteReader_Result_Truncated);
+
+static void BM_ByteReader_Throwing_Truncated(benchmark::State &state) {
+  auto buf = make_records(1);
+  for (auto _ : state) {
+    ThrowingReader r(buf.data(), buf.size() - 1);
+    try {
+      benchmark::DoNotOptimize(r.read<std::uint32_t>());
+      benchmark::DoNotOptimize(r.read<std::uint16_t>());
+      benchmark::DoNotOptimize(r.read_varint());
+      benchmark::DoNotOptimize(r.read_string_view());
+    } catch (const std::exception &) {
+    }
+  }
+}
+BENCHMARK(BM_ByteReader_Throwing_Truncated);
+
+BENCHMARK_MAIN();
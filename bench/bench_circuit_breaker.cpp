@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/circuit_breaker.hpp>
+
+using Call = cpp_result::Result<int, int>;
+
+// A trivial downstream call, so the breaker's own cost dominates.
+static Call cheap_call(int x) {
+  benchmark::DoNotOptimize(x);
+  return Call::Ok(x);
+}
+
+// A downstream call that burns CPU before failing, e.g. a timed-out RPC.
+static Call failing_call() {
+  std::uint64_t h = 1;
+  for (int i = 0; i < 5000; ++i)
+    h = h * 6364136223846793005ull + 1442695040888963407ull;
+  benchmark::DoNotOptimize(h);
+  return Call::Err(503);
+}
+
+static void BM_DirectCall(benchmark::State &state) {
+  int x = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(cheap_call(++x));
+}
+BENCHMARK(BM_DirectCall);
+
+static void BM_BreakerClosed(benchmark::State &state) {
+  static cpp_result::CircuitBreaker<int> breaker(-1);
+  int x = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(breaker.call([&] { return cheap_call(++x); }));
+}
+BENCHMARK(BM_BreakerClosed)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_BreakerClosedSteadyClock(benchmark::State &state) {
+  cpp_result::CircuitBreaker<int, std::chrono::steady_clock> breaker(-1);
+  int x = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(breaker.call([&] { return cheap_call(++x); }));
+}
+BENCHMARK(BM_BreakerClosedSteadyClock);
+
+// Downstream is failing: without a breaker every call pays for it.
+static void BM_FailingDirect(benchmark::State &state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(failing_call());
+}
+BENCHMARK(BM_FailingDirect);
+
+static void BM_FailingBreakerOpen(benchmark::State &state) {
+  cpp_result::BreakerPolicy policy;
+  policy.cooldown = std::chrono::hours(1);
+  cpp_result::CircuitBreaker<int> breaker(-1, policy);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(breaker.call(failing_call));
+  state.counters["rejected"] = static_cast<double>(breaker.rejected());
+}
+BENCHMARK(BM_FailingBreakerOpen);
+
+BENCHMARK_MAIN();
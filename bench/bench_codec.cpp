@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <cpp_result/codec.hpp>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using Item = cpp_result::Result<std::uint64_t, std::int32_t>;
+
+static const std::vector<Item> &items() {
+  static const std::vector<Item> v = [] {
+    std::vector<Item> out;
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 100000; ++i)
+      out.push_back(rng() % 10 == 0
+                        ? Item::Err(static_cast<std::int32_t>(rng() % 1000))
+                        : Item::Ok(rng() % 1000000000));
+    return out;
+  }();
+  return v;
+}
+
+// Hand-written JSON baseline: one object per line,
+// {"ok":123} or {"err":45}.
+static void json_encode(std::string &out, const Item &item) {
+  char buf[32];
+  if (item.is_ok()) {
+    out += "{\"ok\":";
+    auto r = std::to_chars(buf, buf + sizeof(buf), item.unwrap());
+    out.append(buf, r.ptr);
+  } else {
+    out += "{\"err\":";
+    auto r = std::to_chars(buf, buf + sizeof(buf), item.unwrap_err());
+    out.append(buf, r.ptr);
+  }
+  out += "}\n";
+}
+
+static bool json_decode(const char *&p, const char *end, Item &out) {
+  if (end - p < 6 || std::memcmp(p, "{\"", 2) != 0)
+    return false;
+  p += 2;
+  if (std::memcmp(p, "ok\":", 4) == 0) {
+    std::uint64_t v = 0;
+    auto r = std::from_chars(p + 4, end, v);
+    if (r.ec != std::errc())
+      return false;
+    out = Item::Ok(v);
+    p = r.ptr;
+  } else if (end - p >= 5 && std::memcmp(p, "err\":", 5) == 0) {
+    std::int32_t e = 0;
+    auto r = std::from_chars(p + 5, end, e);
+    if (r.ec != std::errc())
+      return false;
+    out = Item::Err(e);
+    p = r.ptr;
+  } else {
+    return false;
+  }
+  if (end - p < 2 || p[0] != '}' || p[1] != '\n')
+    return false;
+  p += 2;
+  return true;
+}
+
+static void BM_EncodeBatch(benchmark::State &state) {
+  const auto &in = items();
+  std::vector<std::byte> buf;
+  for (auto _ : state) {
+    buf.clear();
+    cpp_result::ByteWriter w(buf);
+    cpp_result::encode_batch(w, in);
+    benchmark::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(in.size()));
+  state.counters["bytes/item"] =
+      static_cast<double>(buf.size()) / static_cast<double>(in.size());
+}
+BENCHMARK(BM_EncodeBatch);
+
+static void BM_EncodeEach(benchmark::State &state) {
+  const auto &in = items();
+  std::vector<std::byte> buf;
+  for (auto _ : state) {
+    buf.clear();
+    cpp_result::ByteWriter w(buf);
+    for (const auto &item : in)
+      cpp_result::encode(w, item);
+    benchmark::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(in.size()));
+  state.counters["bytes/item"] =
+      static_cast<double>(buf.size()) / static_cast<double>(in.size());
+}
+BENCHMARK(BM_EncodeEach);
+
+static void BM_EncodeJson(benchmark::State &state) {
+  const auto &in = items();
+  std::string buf;
+  for (auto _ : state) {
+    buf.clear();
+    for (const auto &item : in)
+      json_encode(buf, item);
+    benchmark::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(in.size()));
+  state.counters["bytes/item"] =
+      static_cast<double>(buf.size()) / static_cast<double>(in.size());
+}
+BENCHMARK(BM_EncodeJson);
+
+static void BM_DecodeBatch(benchmark::State &state) {
+  const auto &in = items();
+  std::vector<std::byte> buf;
+  cpp_result::ByteWriter w(buf);
+  cpp_result::encode_batch(w, in);
+  for (auto _ : state) {
+    cpp_result::ByteReader r(buf.data(), buf.size());
+    auto out = cpp_result::decode_batch<std::uint64_t, std::int32_t>(r);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK(BM_DecodeBatch);
+
+static void BM_DecodeJson(benchmark::State &state) {
+  const auto &in = items();
+  std::string buf;
+  for (const auto &item : in)
+    json_encode(buf, item);
+  for (auto _ : state) {
+    std::vector<Item> out;
+    out.reserve(in.size());
+    const char *p = buf.data();
+    const char *end = p + buf.size();
+    Item item = Item::Ok(0);
+    while (p < end && json_decode(p, end, item))
+      out.push_back(item);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK(BM_DecodeJson);
+
+BENCHMARK_MAIN();
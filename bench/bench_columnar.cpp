@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/columnar.hpp>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+// Row counts come from the benchmark argument, e.g.
+//   bench_columnar --benchmark_filter='/100000000'
+// for the 100M-row runs.
+
+enum class Fault : std::uint32_t { Timeout, Refused, Corrupt, Throttled };
+using Row = cpp_result::Result<std::uint64_t, Fault>;
+
+static Row make(std::uint64_t i, std::mt19937_64 &rng) {
+  // About 2% errors, spread over four kinds.
+  const std::uint64_t r = rng();
+  if (r % 50 == 0)
+    return Row::Err(static_cast<Fault>((r >> 8) % 4));
+  return Row::Ok(i);
+}
+
+static std::string temp_path(const char *kind, std::int64_t rows) {
+  return "/tmp/cpp_result_bench_" + std::string(kind) + "_" +
+         std::to_string(getpid()) + "_" + std::to_string(rows);
+}
+
+// Column file for `rows` rows, written once per process.
+static const std::string &column_file(std::int64_t rows) {
+  static std::map<std::int64_t, std::string> files;
+  auto found = files.find(rows);
+  if (found != files.end())
+    return found->second;
+  std::string path = temp_path("col", rows);
+  auto w = std::move(
+      cpp_result::ColumnarWriter<std::uint64_t, Fault>::create(path.c_str())
+          .unwrap());
+  std::mt19937_64 rng(9);
+  for (std::int64_t i = 0; i < rows; ++i)
+    (void)w.append(make(static_cast<std::uint64_t>(i), rng));
+  (void)w.finish();
+  std::atexit([] {
+    for (auto &f : files)
+      std::remove(f.second.c_str());
+  });
+  return files.emplace(rows, std::move(path)).first->second;
+}
+
+// Row-oriented baseline: the Result structs written back to back.
+static const std::string &row_file(std::int64_t rows) {
+  static std::map<std::int64_t, std::string> files;
+  auto found = files.find(rows);
+  if (found != files.end())
+    return found->second;
+  std::string path = temp_path("row", rows);
+  int fd = cpp_result::posix::open(path.c_str(),
+                                   O_WRONLY | O_CREAT | O_TRUNC, 0644)
+               .unwrap();
+  std::mt19937_64 rng(9);
+  std::vector<Row> buf;
+  for (std::int64_t i = 0; i < rows; ++i) {
+    buf.push_back(make(static_cast<std::uint64_t>(i), rng));
+    if (buf.size() == 65536 || i + 1 == rows) {
+      (void)cpp_result::posix::write_full(fd, buf.data(),
+                                          buf.size() * sizeof(Row));
+      buf.clear();
+    }
+  }
+  (void)cpp_result::posix::close(fd);
+  std::atexit([] {
+    for (auto &f : files)
+      std::remove(f.second.c_str());
+  });
+  return files.emplace(rows, std::move(path)).first->second;
+}
+
+static void BM_ColumnarWrite(benchmark::State &state) {
+  const std::int64_t rows = state.range(0);
+  const std::string path = temp_path("write", rows);
+  for (auto _ : state) {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<std::uint64_t, Fault>::create(path.c_str())
+            .unwrap());
+    std::mt19937_64 rng(9);
+    for (std::int64_t i = 0; i < rows; ++i)
+      (void)w.append(make(static_cast<std::uint64_t>(i), rng));
+    benchmark::DoNotOptimize(w.finish());
+  }
+  std::remove(path.c_str());
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+static void BM_ColumnarCountErrorsOf(benchmark::State &state) {
+  auto col = std::move(cpp_result::ColumnarReader<std::uint64_t, Fault>::open(
+                           column_file(state.range(0)).c_str())
+                           .unwrap());
+  for (auto _ : state)
+    benchmark::DoNotOptimize(col.count_errors_of(Fault::Throttled));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ColumnarSumOk(benchmark::State &state) {
+  auto col = std::move(cpp_result::ColumnarReader<std::uint64_t, Fault>::open(
+                           column_file(state.range(0)).c_str())
+                           .unwrap());
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    const std::uint64_t *values = col.values();
+    for (std::uint64_t i = 0; i < col.ok_rows(); ++i)
+      sum += values[i];
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_RowCountErrorsOf(benchmark::State &state) {
+  auto file = std::move(
+      cpp_result::MappedFile::open(row_file(state.range(0)).c_str()).unwrap());
+  const Row *rows = reinterpret_cast<const Row *>(file.data());
+  const std::size_t n = file.size() / sizeof(Row);
+  for (auto _ : state) {
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < n; ++i)
+      count += rows[i].is_err() && rows[i].unwrap_err() == Fault::Throttled;
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ColumnarWrite)
+    ->Arg(1 << 20)
+    ->Arg(100000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ColumnarCountErrorsOf)
+    ->Arg(1 << 20)
+    ->Arg(100000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ColumnarSumOk)
+    ->Arg(1 << 20)
+    ->Arg(100000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RowCountErrorsOf)
+    ->Arg(1 << 20)
+    ->Arg(100000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
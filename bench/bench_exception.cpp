@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/exception.hpp>
+#include <stdexcept>
+#include <vector>
+
+using cpp_result::Result;
+
+enum class Code { Invalid, Range };
+using R = Result<int, Code>;
+
+// Fails every `period`-th call; period 0 never fails.
+__attribute__((noinline)) static int may_throw(int i, int period) {
+  if (period != 0 && i % period == 0)
+    throw std::invalid_argument("bad input");
+  return i;
+}
+
+static R handwritten(int i, int period) {
+  try {
+    return R::Ok(may_throw(i, period));
+  } catch (const std::out_of_range &) {
+    return R::Err(Code::Range);
+  } catch (const std::invalid_argument &) {
+    return R::Err(Code::Invalid);
+  }
+}
+
+static R adapted(int i, int period) {
+  return cpp_result::catch_as_result<Code>(
+      [&] { return may_throw(i, period); },
+      [](const std::out_of_range &) { return Code::Range; },
+      [](const std::invalid_argument &) { return Code::Invalid; });
+}
+
+// Error rate in the argument: 0 = never, else one call in `period`.
+template <R (*Call)(int, int)>
+static void BM_Catch(benchmark::State &state) {
+  const int period = static_cast<int>(state.range(0));
+  int i = 1;
+  for (auto _ : state) {
+    auto r = Call(i++, period);
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK_TEMPLATE(BM_Catch, handwritten)->Arg(0)->Arg(100)->Arg(10)->Arg(2);
+BENCHMARK_TEMPLATE(BM_Catch, adapted)->Arg(0)->Arg(100)->Arg(10)->Arg(2);
+
+static void BM_OkUnwrap(benchmark::State &state) {
+  std::vector<R> rs(1024, R::Ok(1));
+  for (auto _ : state) {
+    int sum = 0;
+    for (auto &r : rs)
+      sum += r.unwrap();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_OkUnwrap);
+
+static void BM_OkResultOrThrow(benchmark::State &state) {
+  std::vector<R> rs(1024, R::Ok(1));
+  for (auto _ : state) {
+    int sum = 0;
+    for (auto &r : rs)
+      sum += cpp_result::result_or_throw(r);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_OkResultOrThrow);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/fallible.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Success-path cost: the fallible containers against their std
+// counterparts, building the same contents.
+
+static void BM_StdVectorPushBack(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::vector<std::uint64_t> v;
+    for (std::size_t i = 0; i < n; ++i)
+      v.push_back(i);
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdVectorPushBack)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_TryVectorPushBack(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    cpp_result::TryVector<std::uint64_t> v;
+    for (std::size_t i = 0; i < n; ++i)
+      if (v.try_push_back(i).is_err())
+        state.SkipWithError("allocation failed");
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TryVectorPushBack)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_StdStringAppend(benchmark::State &state) {
+  for (auto _ : state) {
+    std::string s;
+    for (int i = 0; i < 4096; ++i)
+      s.append("field=value;");
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 4096 * 12);
+}
+BENCHMARK(BM_StdStringAppend);
+
+static void BM_TryStringAppend(benchmark::State &state) {
+  for (auto _ : state) {
+    cpp_result::TryString s;
+    for (int i = 0; i < 4096; ++i)
+      if (s.try_append("field=value;").is_err())
+        state.SkipWithError("allocation failed");
+    benchmark::DoNotOptimize(s.c_str());
+  }
+  state.SetBytesProcessed(state.iterations() * 4096 * 12);
+}
+BENCHMARK(BM_TryStringAppend);
+
+static void BM_StdUnorderedMapEmplace(benchmark::State &state) {
+  const auto n = static_cast<std::uint64_t>(state.range(0));
+  for (auto _ : state) {
+    std::unordered_map<std::uint64_t, std::uint64_t> m;
+    for (std::uint64_t i = 0; i < n; ++i)
+      m.try_emplace(i * 7919, i);
+    benchmark::DoNotOptimize(m.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdUnorderedMapEmplace)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_TryHashMapEmplace(benchmark::State &state) {
+  const auto n = static_cast<std::uint64_t>(state.range(0));
+  for (auto _ : state) {
+    cpp_result::TryHashMap<std::uint64_t, std::uint64_t> m;
+    for (std::uint64_t i = 0; i < n; ++i)
+      if (m.try_emplace(i * 7919, i).is_err())
+        state.SkipWithError("allocation failed");
+    benchmark::DoNotOptimize(m.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TryHashMapEmplace)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/format.hpp>
+#include <sstream>
+
+using cpp_result::Result;
+
+enum class Code { Timeout = 110 };
+using R = Result<int, Code>;
+
+// Each iteration formats 10M results, one in 16 an error, as log lines.
+static constexpr int kResults = 10'000'000;
+
+static R make(int i) {
+  return (i & 15) == 0 ? R::Err(Code::Timeout) : R::Ok(i * 7);
+}
+
+static void BM_FormatTo(benchmark::State &state) {
+  char line[64];
+  for (auto _ : state) {
+    std::size_t bytes = 0;
+    for (int i = 0; i < kResults; ++i) {
+      auto res = cpp_result::format_to(line, line + sizeof line, make(i));
+      benchmark::DoNotOptimize(line);
+      bytes += static_cast<std::size_t>(res.ptr - line);
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * kResults);
+}
+BENCHMARK(BM_FormatTo)->Unit(benchmark::kMillisecond);
+
+// The same text through a reused std::ostringstream.
+static void BM_Ostringstream(benchmark::State &state) {
+  std::ostringstream os;
+  for (auto _ : state) {
+    std::size_t bytes = 0;
+    for (int i = 0; i < kResults; ++i) {
+      os.str(std::string());
+      R r = make(i);
+      if (r.is_ok())
+        os << "Ok(" << r.unwrap() << ')';
+      else
+        os << "Err(" << static_cast<int>(r.unwrap_err()) << ')';
+      bytes += os.str().size();
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * kResults);
+}
+BENCHMARK(BM_Ostringstream)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
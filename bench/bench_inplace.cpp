@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <result.hpp>
+#include <string>
+
+// Long-lived per-connection state updated by a few stages per message.
+struct Conn {
+  std::string buffer;
+  std::uint64_t bytes = 0;
+  std::uint32_t messages = 0;
+};
+
+using R = cpp_result::Result<Conn, int>;
+
+static void BM_MapStages(benchmark::State &state) {
+  R conn = R::Ok(Conn{std::string(256, 'x'), 0, 0});
+  for (auto _ : state) {
+    conn = std::move(conn)
+               .map([](Conn c) {
+                 c.bytes += c.buffer.size();
+                 return c;
+               })
+               .map([](Conn c) {
+                 ++c.messages;
+                 return c;
+               })
+               .map([](Conn c) {
+                 c.buffer[c.messages % c.buffer.size()] = 'y';
+                 return c;
+               });
+    benchmark::DoNotOptimize(conn);
+  }
+}
+BENCHMARK(BM_MapStages);
+
+static void BM_MapInplaceStages(benchmark::State &state) {
+  R conn = R::Ok(Conn{std::string(256, 'x'), 0, 0});
+  for (auto _ : state) {
+    conn.map_inplace([](Conn &c) { c.bytes += c.buffer.size(); })
+        .map_inplace([](Conn &c) { ++c.messages; })
+        .map_inplace(
+            [](Conn &c) { c.buffer[c.messages % c.buffer.size()] = 'y'; });
+    benchmark::DoNotOptimize(conn);
+  }
+}
+BENCHMARK(BM_MapInplaceStages);
+
+// Handing the buffer to a consumer while the connection lives on.
+static void BM_TakeOk(benchmark::State &state) {
+  R buf = R::Ok(Conn{});
+  for (auto _ : state) {
+    buf.map_inplace([](Conn &c) { c.buffer.assign(64, 'z'); });
+    auto owned = buf.take_ok();
+    benchmark::DoNotOptimize(owned);
+  }
+}
+BENCHMARK(BM_TakeOk);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cpp_result/interop.hpp>
+#include <vector>
+
+// Converting Results with large payloads: moving (rvalue overloads) against
+// copying (const& overloads).
+
+using Blob = std::vector<char>;             // heap payload, 1 MiB
+using Frame = std::array<std::uint64_t, 64>; // trivially copyable, 512 B
+
+static Blob make_blob() { return Blob(1 << 20, 'x'); }
+
+static void BM_VariantRoundTripCopy(benchmark::State &state) {
+  auto r = cpp_result::Result<Blob, int>::Ok(make_blob());
+  for (auto _ : state) {
+    auto v = cpp_result::to_variant(r);
+    auto back = cpp_result::from_variant(v);
+    benchmark::DoNotOptimize(back);
+  }
+}
+BENCHMARK(BM_VariantRoundTripCopy);
+
+static void BM_VariantRoundTripMove(benchmark::State &state) {
+  auto r = cpp_result::Result<Blob, int>::Ok(make_blob());
+  for (auto _ : state) {
+    auto v = cpp_result::to_variant(std::move(r));
+    r = cpp_result::from_variant(std::move(v));
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_VariantRoundTripMove);
+
+static void BM_OptionalOkOrMove(benchmark::State &state) {
+  std::optional<Blob> o = make_blob();
+  for (auto _ : state) {
+    auto r = cpp_result::ok_or(std::move(o), -1);
+    o = cpp_result::to_optional(std::move(r));
+    benchmark::DoNotOptimize(o);
+  }
+}
+BENCHMARK(BM_OptionalOkOrMove);
+
+// Baseline: the same round trip written by hand.
+static void BM_TrivialPayloadHandWritten(benchmark::State &state) {
+  using R = cpp_result::Result<Frame, int>;
+  auto r = R::Ok(Frame{});
+  for (auto _ : state) {
+    std::variant<Frame, int> v(std::in_place_index<0>, r.unwrap());
+    std::get<0>(v)[0] += 1;
+    r = R::Ok(std::get<0>(v));
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_TrivialPayloadHandWritten);
+
+static void BM_TrivialPayloadVariantRoundTrip(benchmark::State &state) {
+  auto r = cpp_result::Result<Frame, int>::Ok(Frame{});
+  for (auto _ : state) {
+    auto v = cpp_result::to_variant(std::move(r));
+    std::get<0>(v)[0] += 1;
+    r = cpp_result::from_variant(std::move(v));
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_TrivialPayloadVariantRoundTrip);
+
+#if defined(__cpp_lib_expected)
+static void BM_ExpectedRoundTripCopy(benchmark::State &state) {
+  auto r = cpp_result::Result<Blob, int>::Ok(make_blob());
+  for (auto _ : state) {
+    auto x = cpp_result::to_expected(r);
+    auto back = cpp_result::from_expected(x);
+    benchmark::DoNotOptimize(back);
+  }
+}
+BENCHMARK(BM_ExpectedRoundTripCopy);
+
+static void BM_ExpectedRoundTripMove(benchmark::State &state) {
+  auto r = cpp_result::Result<Blob, int>::Ok(make_blob());
+  for (auto _ : state) {
+    auto x = cpp_result::to_expected(std::move(r));
+    r = cpp_result::from_expected(std::move(x));
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_ExpectedRoundTripMove);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/mapped_file.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Sequential scan of a line-oriented file: MappedFile::lines() versus
+// std::ifstream + std::getline. The argument is the file size in MiB; pass
+// a larger value (e.g. 10240) with --benchmark_filter to reproduce
+// multi-gigabyte scans.
+
+static std::string make_file(std::size_t mib) {
+  char tmpl[] = "/tmp/cpp_result_bench_mapped_XXXXXX";
+  int fd = ::mkstemp(tmpl);
+  std::string chunk;
+  for (int i = 0; chunk.size() < (1u << 20); ++i)
+    chunk += "record-" + std::to_string(i) + ",value=" +
+             std::to_string(i * 7919 % 100003) + "\n";
+  chunk.resize(1u << 20);
+  chunk.back() = '\n';
+  for (std::size_t i = 0; i < mib; ++i)
+    if (cpp_result::posix::write_full(fd, chunk.data(), chunk.size())
+            .is_err())
+      std::abort();
+  ::close(fd);
+  return tmpl;
+}
+
+static void BM_MappedFileLines(benchmark::State &state) {
+  const auto mib = static_cast<std::size_t>(state.range(0));
+  const std::string path = make_file(mib);
+  for (auto _ : state) {
+    auto file = cpp_result::MappedFile::open(path.c_str());
+    std::size_t lines = 0, bytes = 0;
+    for (auto line : file.unwrap().lines()) {
+      ++lines;
+      bytes += line.unwrap().size();
+    }
+    benchmark::DoNotOptimize(lines);
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(mib << 20));
+  ::unlink(path.c_str());
+}
+BENCHMARK(BM_MappedFileLines)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+static void BM_IfstreamGetline(benchmark::State &state) {
+  const auto mib = static_cast<std::size_t>(state.range(0));
+  const std::string path = make_file(mib);
+  for (auto _ : state) {
+    std::ifstream in(path);
+    if (!in)
+      state.SkipWithError("open failed");
+    std::string line;
+    std::size_t lines = 0, bytes = 0;
+    while (std::getline(in, line)) {
+      ++lines;
+      bytes += line.size();
+    }
+    benchmark::DoNotOptimize(lines);
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(mib << 20));
+  ::unlink(path.c_str());
+}
+BENCHMARK(BM_IfstreamGetline)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/memoize.hpp>
+#include <random>
+
+using Lookup = cpp_result::Result<std::uint64_t, int>;
+
+// Stand-in for an expensive fallible lookup; 1 key in 16 does not exist.
+static Lookup slow_lookup(std::uint64_t key) {
+  std::uint64_t h = key;
+  for (int i = 0; i < 2000; ++i)
+    h = h * 6364136223846793005ull + 1442695040888963407ull;
+  benchmark::DoNotOptimize(h);
+  if (key % 16 == 0)
+    return Lookup::Err(404);
+  return Lookup::Ok(h);
+}
+
+static cpp_result::Memoized<std::uint64_t, Lookup (*)(std::uint64_t)> &
+cache() {
+  static auto memo = [] {
+    cpp_result::MemoizePolicy policy;
+    policy.ok_capacity = 8192;
+    policy.err_capacity = 1024;
+    policy.shards = 64;
+    return cpp_result::memoize(&slow_lookup, policy);
+  }();
+  return memo;
+}
+
+// Skewed key stream over 16384 keys: most traffic hits a hot subset.
+static std::uint64_t next_key(std::mt19937_64 &rng) {
+  const std::uint64_t r = rng();
+  return (r & 3) ? (r >> 8) % 1024 : (r >> 8) % 16384;
+}
+
+static void BM_Memoized(benchmark::State &state) {
+  if (state.thread_index() == 0)
+    cache().clear();
+  std::mt19937_64 rng(static_cast<std::uint64_t>(state.thread_index()) + 1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(cache()(next_key(rng)));
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0)
+    state.counters["hit_rate"] = cache().stats().hit_rate();
+}
+BENCHMARK(BM_Memoized)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Uncached(benchmark::State &state) {
+  std::mt19937_64 rng(static_cast<std::uint64_t>(state.thread_index()) + 1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(slow_lookup(next_key(rng)));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Uncached)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cpp_result/net.hpp>
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <thread>
+#include <vector>
+
+using cpp_result::Errno;
+using cpp_result::Result;
+namespace net = cpp_result::net;
+namespace posix = cpp_result::posix;
+
+// Each iteration sends one 64-byte message on every connection, then
+// reads all echoes back: state.range(0) round trips over loopback.
+static constexpr std::size_t kMsg = 64;
+
+static std::vector<int> connect_clients(std::uint16_t port, int n) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  std::vector<int> fds;
+  for (int i = 0; i < n; ++i) {
+    int fd = net::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC).unwrap();
+    (void)net::set_option(fd, IPPROTO_TCP, TCP_NODELAY, 1);
+    if (net::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))
+            .is_err())
+      std::abort();
+    fds.push_back(fd);
+  }
+  return fds;
+}
+
+static void ping_pong(benchmark::State &state, std::uint16_t port) {
+  const int n = static_cast<int>(state.range(0));
+  auto clients = connect_clients(port, n);
+  char out[kMsg] = {'x'}, in[kMsg];
+  for (auto _ : state) {
+    for (int fd : clients)
+      (void)posix::write_full(fd, out, kMsg);
+    for (int fd : clients)
+      if (posix::read_full(fd, in, kMsg).unwrap_or(0) != kMsg)
+        std::abort();
+  }
+  for (int fd : clients)
+    ::close(fd);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Single-threaded epoll reactor; handlers return Err to close.
+static void BM_EchoReactor(benchmark::State &state) {
+  auto created = net::Reactor<Errno>::create();
+  auto &reactor = created.unwrap();
+  int lfd = net::listen_tcp("127.0.0.1", 0).unwrap();
+  const std::uint16_t port = net::local_port(lfd).unwrap();
+
+  auto echo = [](int fd, std::uint32_t) -> Result<void, Errno> {
+    char buf[4096];
+    for (;;) {
+      auto n = net::recv(fd, buf, sizeof(buf));
+      if (n.is_pending())
+        return Result<void, Errno>::Ok();
+      std::size_t got = TRY_INTO(std::move(n).into_result());
+      if (got == 0)
+        return Result<void, Errno>::Err(Errno{0});
+      auto sent = net::send(fd, buf, got);
+      if (!sent.is_ok() || sent.unwrap() != got)
+        return Result<void, Errno>::Err(Errno{EAGAIN});
+    }
+  };
+  auto accept_all = [&](int fd, std::uint32_t) -> Result<void, Errno> {
+    for (;;) {
+      auto conn = net::accept4(fd);
+      if (conn.is_pending())
+        return Result<void, Errno>::Ok();
+      int c = TRY_INTO(std::move(conn).into_result());
+      (void)net::set_option(c, IPPROTO_TCP, TCP_NODELAY, 1);
+      if (reactor.add(c, EPOLLIN, echo).is_err())
+        ::close(c);
+    }
+  };
+  (void)reactor.add(lfd, EPOLLIN, accept_all);
+
+  std::atomic<bool> stop{false};
+  std::thread server([&] {
+    while (!stop.load(std::memory_order_relaxed))
+      (void)reactor.run_once(10);
+  });
+  ping_pong(state, port);
+  stop = true;
+  server.join();
+}
+BENCHMARK(BM_EchoReactor)->Arg(1)->Arg(8)->Arg(64)->UseRealTime();
+
+// Blocking sockets, one server thread per connection.
+static void BM_EchoThreadPerConnection(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  int lfd = net::listen_tcp("127.0.0.1", 0).unwrap();
+  ::fcntl(lfd, F_SETFL, ::fcntl(lfd, F_GETFL) & ~O_NONBLOCK);
+  const std::uint16_t port = net::local_port(lfd).unwrap();
+
+  std::vector<std::thread> workers;
+  std::thread acceptor([&] {
+    for (int i = 0; i < n; ++i) {
+      int c = ::accept4(lfd, nullptr, nullptr, SOCK_CLOEXEC);
+      if (c < 0)
+        std::abort();
+      (void)net::set_option(c, IPPROTO_TCP, TCP_NODELAY, 1);
+      workers.emplace_back([c] {
+        char buf[4096];
+        for (;;) {
+          auto got = posix::read(c, buf, sizeof(buf));
+          if (got.is_err() || got.unwrap() == 0 ||
+              posix::write_full(c, buf, got.unwrap()).is_err())
+            break;
+        }
+        ::close(c);
+      });
+    }
+  });
+  ping_pong(state, port);
+  acceptor.join();
+  for (auto &w : workers)
+    w.join();
+  ::close(lfd);
+}
+BENCHMARK(BM_EchoThreadPerConnection)->Arg(1)->Arg(8)->Arg(64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/object_pool.hpp>
+#include <mutex>
+#include <vector>
+
+struct Conn {
+  char buffer[256];
+};
+
+// Baseline: the usual free list of pointers under one mutex.
+class MutexPool {
+public:
+  explicit MutexPool(std::size_t n) : objects_(n) {
+    for (auto &o : objects_)
+      free_.push_back(&o);
+  }
+  Conn *acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.empty())
+      return nullptr;
+    Conn *c = free_.back();
+    free_.pop_back();
+    return c;
+  }
+  void release(Conn *c) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(c);
+  }
+
+private:
+  std::vector<Conn> objects_;
+  std::vector<Conn *> free_;
+  std::mutex mutex_;
+};
+
+constexpr std::uint32_t kCapacity = 1024;
+
+static void BM_LockFreePool(benchmark::State &state) {
+  static cpp_result::ObjectPool<Conn> pool(kCapacity);
+  for (auto _ : state) {
+    auto h = pool.try_acquire();
+    if (h.is_ok())
+      benchmark::DoNotOptimize(h.unwrap()->buffer[0]);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LockFreePool)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_MutexPool(benchmark::State &state) {
+  static MutexPool pool(kCapacity);
+  for (auto _ : state) {
+    Conn *c = pool.acquire();
+    if (c) {
+      benchmark::DoNotOptimize(c->buffer[0]);
+      pool.release(c);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexPool)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
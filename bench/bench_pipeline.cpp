@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <cpp_result/pipeline.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using IntResult = cpp_result::Result<long, int>;
+
+static IntResult parse_long(std::string_view s) {
+  long value = 0;
+  auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (ec != std::errc() || end != s.data() + s.size())
+    return IntResult::Err(static_cast<int>(s.size()));
+  return IntResult::Ok(value);
+}
+
+// 32 MiB of integers, one per line, about 1% invalid.
+static const std::string &input() {
+  static const std::string text = [] {
+    std::string out;
+    std::mt19937_64 rng(3);
+    while (out.size() < (32u << 20)) {
+      if (rng() % 100 == 0)
+        out += "bad";
+      else
+        out += std::to_string(rng() % 1000000000);
+      out += '\n';
+    }
+    return out;
+  }();
+  return text;
+}
+
+static void BM_Pipeline(benchmark::State &state) {
+  const std::string &text = input();
+  cpp_result::PipelineOptions opts;
+  opts.threads = static_cast<unsigned>(state.range(0));
+  opts.chunk_size = 1u << 20;
+  for (auto _ : state) {
+    long sum = 0;
+    std::size_t errors = 0;
+    auto stats = cpp_result::run_pipeline(
+        cpp_result::string_reader(text), parse_long,
+        [&](long v) { sum += v; }, [&](int, std::size_t) { ++errors; },
+        opts);
+    benchmark::DoNotOptimize(stats);
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(errors);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_Pipeline)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+
+// Naive baseline: materialize every record's Result before consuming.
+static void BM_CollectAllThenConsume(benchmark::State &state) {
+  const std::string &text = input();
+  for (auto _ : state) {
+    std::vector<IntResult> all;
+    std::string_view rest = text;
+    while (!rest.empty()) {
+      auto nl = rest.find('\n');
+      auto line = rest.substr(0, nl);
+      all.push_back(parse_long(line));
+      rest.remove_prefix(nl == std::string_view::npos ? rest.size() : nl + 1);
+    }
+    long sum = 0;
+    std::size_t errors = 0;
+    for (auto &r : all) {
+      if (r.is_ok())
+        sum += r.unwrap();
+      else
+        ++errors;
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(errors);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_CollectAllThenConsume)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
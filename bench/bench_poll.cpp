@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <cerrno>
+#include <cpp_result/poll.hpp>
+#include <string>
+
+using cpp_result::Poll;
+using cpp_result::Result;
+
+// A rich error type, as at the top of a socket stack.
+struct IoError {
+  int code;
+  std::string context;
+};
+
+// Three layers (read, decode, handle) over a source that would block on
+// most calls, the common case in an EAGAIN-driven loop.
+static constexpr int kReadyEvery = 8;
+
+__attribute__((noinline)) static Poll<int, IoError> read_poll(int i) {
+  if (i % kReadyEvery != 0)
+    return cpp_result::pending;
+  return Poll<int, IoError>::Ok(i);
+}
+__attribute__((noinline)) static Poll<int, IoError> decode_poll(int i) {
+  int n = TRY_READY(read_poll(i));
+  return Poll<int, IoError>::Ok(n + 1);
+}
+__attribute__((noinline)) static Poll<int, IoError> handle_poll(int i) {
+  int v = TRY_READY(decode_poll(i));
+  return Poll<int, IoError>::Ok(v * 2);
+}
+
+// The same with would-block encoded as an error value.
+using R = Result<int, IoError>;
+__attribute__((noinline)) static R read_sentinel(int i) {
+  if (i % kReadyEvery != 0)
+    return R::Err(IoError{EAGAIN, "read"});
+  return R::Ok(i);
+}
+__attribute__((noinline)) static R decode_sentinel(int i) {
+  int n = TRY(read_sentinel(i));
+  return R::Ok(n + 1);
+}
+__attribute__((noinline)) static R handle_sentinel(int i) {
+  int v = TRY(decode_sentinel(i));
+  return R::Ok(v * 2);
+}
+
+static void BM_Poll(benchmark::State &state) {
+  int i = 0, ready = 0;
+  for (auto _ : state) {
+    auto p = handle_poll(i++);
+    ready += p.is_ok();
+    benchmark::DoNotOptimize(p);
+  }
+  benchmark::DoNotOptimize(ready);
+}
+BENCHMARK(BM_Poll);
+
+static void BM_SentinelError(benchmark::State &state) {
+  int i = 0, ready = 0;
+  for (auto _ : state) {
+    auto r = handle_sentinel(i++);
+    ready += r.is_ok() || r.unwrap_err().code != EAGAIN;
+    benchmark::DoNotOptimize(r);
+  }
+  benchmark::DoNotOptimize(ready);
+}
+BENCHMARK(BM_SentinelError);
+
+BENCHMARK_MAIN();
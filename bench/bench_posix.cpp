@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/posix.hpp>
+#include <cstdlib>
+#include <string>
+
+namespace posix = cpp_result::posix;
+
+// Page-cache resident scratch file shared by the pread benchmarks.
+class PosixFixture : public benchmark::Fixture {
+public:
+  void SetUp(const benchmark::State &) override {
+    char tmpl[] = "/tmp/cpp_result_bench_posix_XXXXXX";
+    fd_ = ::mkstemp(tmpl);
+    ::unlink(tmpl);
+    std::string data(1 << 16, 'x');
+    if (::write(fd_, data.data(), data.size()) !=
+        static_cast<ssize_t>(data.size()))
+      std::abort();
+  }
+  void TearDown(const benchmark::State &) override { ::close(fd_); }
+
+protected:
+  int fd_ = -1;
+};
+
+BENCHMARK_DEFINE_F(PosixFixture, RawPread)(benchmark::State &state) {
+  char buf[4096];
+  const auto len = static_cast<std::size_t>(state.range(0));
+  std::size_t total = 0;
+  int errors = 0;
+  for (auto _ : state) {
+    ssize_t n = ::pread(fd_, buf, len, 0);
+    if (n == -1)
+      ++errors;
+    else
+      total += static_cast<std::size_t>(n);
+    benchmark::DoNotOptimize(buf);
+  }
+  benchmark::DoNotOptimize(total);
+  state.counters["errors"] = errors;
+}
+BENCHMARK_REGISTER_F(PosixFixture, RawPread)->Arg(8)->Arg(4096);
+
+BENCHMARK_DEFINE_F(PosixFixture, ResultPread)(benchmark::State &state) {
+  char buf[4096];
+  const auto len = static_cast<std::size_t>(state.range(0));
+  std::size_t total = 0;
+  int errors = 0;
+  for (auto _ : state) {
+    auto n = posix::pread(fd_, buf, len, 0);
+    if (n.is_err())
+      ++errors;
+    else
+      total += n.unwrap();
+    benchmark::DoNotOptimize(buf);
+  }
+  benchmark::DoNotOptimize(total);
+  state.counters["errors"] = errors;
+}
+BENCHMARK_REGISTER_F(PosixFixture, ResultPread)->Arg(8)->Arg(4096);
+
+BENCHMARK_DEFINE_F(PosixFixture, ResultPreadFull)(benchmark::State &state) {
+  char buf[4096];
+  const auto len = static_cast<std::size_t>(state.range(0));
+  std::size_t total = 0;
+  for (auto _ : state) {
+    auto n = posix::pread_full(fd_, buf, len, 0);
+    total += n.unwrap_or(0);
+    benchmark::DoNotOptimize(buf);
+  }
+  benchmark::DoNotOptimize(total);
+}
+BENCHMARK_REGISTER_F(PosixFixture, ResultPreadFull)->Arg(8)->Arg(4096);
+
+// Failing calls: errno capture versus Result construction.
+static void BM_RawFstatBadFd(benchmark::State &state) {
+  struct stat st;
+  int errors = 0;
+  for (auto _ : state) {
+    if (::fstat(-1, &st) == -1 && errno == EBADF)
+      ++errors;
+  }
+  benchmark::DoNotOptimize(errors);
+}
+BENCHMARK(BM_RawFstatBadFd);
+
+static void BM_ResultFstatBadFd(benchmark::State &state) {
+  int errors = 0;
+  for (auto _ : state) {
+    auto st = posix::fstat(-1);
+    if (st.is_err() && st.unwrap_err() == EBADF)
+      ++errors;
+  }
+  benchmark::DoNotOptimize(errors);
+}
+BENCHMARK(BM_ResultFstatBadFd);
+
+BENCHMARK_MAIN();
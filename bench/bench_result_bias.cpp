@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <result.hpp>
+#include <vector>
+
+using cpp_result::ResultBias;
+
+// Same payloads, three branch-weight policies.
+template <ResultBias B> struct Code {
+  std::uint32_t value;
+};
+
+template <typename T, ResultBias B>
+struct cpp_result::result_bias<T, Code<B>>
+    : std::integral_constant<ResultBias, B> {};
+
+template <ResultBias B> using R = cpp_result::Result<std::uint64_t, Code<B>>;
+
+// Parse-like step: fails where the schedule says so.
+template <ResultBias B>
+__attribute__((noinline)) R<B> step(std::uint64_t x, bool fail) {
+  if (fail)
+    return R<B>::Err(Code<B>{static_cast<std::uint32_t>(x)});
+  return R<B>::Ok(x * 3 + 1);
+}
+
+template <ResultBias B> R<B> pipeline(std::uint64_t x, bool fail) {
+  std::uint64_t v = TRY(step<B>(x, fail));
+  return step<B>(v, false)
+      .map([](std::uint64_t y) { return y ^ (y >> 7); })
+      .and_then([](std::uint64_t y) { return R<B>::Ok(y + 11); })
+      .map_err([](Code<B> c) {
+        // Enough work that the error path is a real block, not a cmov.
+        std::uint32_t h = c.value;
+        for (int i = 0; i < 4; ++i)
+          h = (h ^ (h >> 15)) * 0x2c1b3c6du;
+        return Code<B>{h};
+      });
+}
+
+// Error positions drawn once per rate (per mille) from a fixed seed.
+static const std::vector<bool> &schedule(int per_mille) {
+  static std::vector<bool> cache[1001];
+  auto &s = cache[per_mille];
+  if (s.empty()) {
+    std::mt19937_64 rng(per_mille + 1);
+    std::bernoulli_distribution fail(per_mille / 1000.0);
+    s.resize(1 << 16);
+    for (std::size_t i = 0; i < s.size(); ++i)
+      s[i] = fail(rng);
+  }
+  return s;
+}
+
+template <ResultBias B> static void BM_Bias(benchmark::State &state) {
+  const auto &fails = schedule(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < fails.size(); ++i) {
+      auto r = pipeline<B>(i, fails[i]);
+      sum += r.is_ok() ? r.unwrap() : r.unwrap_err().value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(fails.size()));
+}
+
+// Error rate in per mille: mostly Ok, a random mix, mostly Err.
+#define BIAS_RATES Arg(1)->Arg(100)->Arg(500)->Arg(900)->Arg(999)
+BENCHMARK_TEMPLATE(BM_Bias, ResultBias::Unbiased)->BIAS_RATES;
+BENCHMARK_TEMPLATE(BM_Bias, ResultBias::LikelyOk)->BIAS_RATES;
+BENCHMARK_TEMPLATE(BM_Bias, ResultBias::LikelyErr)->BIAS_RATES;
+
+BENCHMARK_MAIN();
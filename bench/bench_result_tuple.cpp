@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/result_tuple.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using cpp_result::Result;
+using cpp_result::ResultTuple;
+
+enum class ErrCode : std::uint16_t { Missing, Range };
+using Field = Result<std::uint32_t, ErrCode>;
+
+// 16 independently validated fields, stored as plain Results...
+struct PlainRecord {
+  Field f[16];
+};
+
+// ...and as one ResultTuple.
+template <std::size_t> using FieldAt = Field;
+template <std::size_t... I>
+ResultTuple<FieldAt<I>...> packed_type(std::index_sequence<I...>);
+using PackedRecord = decltype(packed_type(std::make_index_sequence<16>{}));
+
+static Field make_field(std::mt19937_64 &rng) {
+  if (rng() % 1000 == 0)
+    return Field::Err(ErrCode::Range);
+  return Field::Ok(static_cast<std::uint32_t>(rng()));
+}
+
+template <std::size_t... I>
+static PlainRecord make_plain(std::mt19937_64 &rng, std::index_sequence<I...>) {
+  return PlainRecord{{(static_cast<void>(I), make_field(rng))...}};
+}
+static PlainRecord make_plain(std::mt19937_64 &rng) {
+  return make_plain(rng, std::make_index_sequence<16>{});
+}
+
+template <std::size_t... I>
+static PackedRecord pack(const PlainRecord &p, std::index_sequence<I...>) {
+  return PackedRecord(p.f[I]...);
+}
+static PackedRecord make_packed(std::mt19937_64 &rng) {
+  return pack(make_plain(rng), std::make_index_sequence<16>{});
+}
+
+constexpr std::size_t kRecords = 1 << 18; // well past the caches
+
+static void BM_AllOkPlain(benchmark::State &state) {
+  std::mt19937_64 rng(1);
+  std::vector<PlainRecord> records;
+  records.reserve(kRecords);
+  for (std::size_t i = 0; i < kRecords; ++i)
+    records.push_back(make_plain(rng));
+  for (auto _ : state) {
+    std::size_t valid = 0;
+    for (const auto &r : records) {
+      bool ok = true;
+      for (const auto &f : r.f)
+        ok &= f.is_ok();
+      valid += ok;
+    }
+    benchmark::DoNotOptimize(valid);
+  }
+  state.counters["bytes_per_record"] = sizeof(PlainRecord);
+  state.SetItemsProcessed(state.iterations() * kRecords);
+}
+BENCHMARK(BM_AllOkPlain);
+
+static void BM_AllOkPacked(benchmark::State &state) {
+  std::mt19937_64 rng(1);
+  std::vector<PackedRecord> records;
+  records.reserve(kRecords);
+  for (std::size_t i = 0; i < kRecords; ++i)
+    records.push_back(make_packed(rng));
+  for (auto _ : state) {
+    std::size_t valid = 0;
+    for (const auto &r : records)
+      valid += r.all_ok();
+    benchmark::DoNotOptimize(valid);
+  }
+  state.counters["bytes_per_record"] = sizeof(PackedRecord);
+  state.SetItemsProcessed(state.iterations() * kRecords);
+}
+BENCHMARK(BM_AllOkPacked);
+
+// Summing one field: the packed layout reads fewer cache lines.
+static void BM_SumFieldPlain(benchmark::State &state) {
+  std::mt19937_64 rng(2);
+  std::vector<PlainRecord> records;
+  records.reserve(kRecords);
+  for (std::size_t i = 0; i < kRecords; ++i)
+    records.push_back(make_plain(rng));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto &r : records)
+      sum += r.f[7].unwrap_or(0);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kRecords);
+}
+BENCHMARK(BM_SumFieldPlain);
+
+static void BM_SumFieldPacked(benchmark::State &state) {
+  std::mt19937_64 rng(2);
+  std::vector<PackedRecord> records;
+  records.reserve(kRecords);
+  for (std::size_t i = 0; i < kRecords; ++i)
+    records.push_back(make_packed(rng));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto &r : records)
+      sum += r.template get<7>().unwrap_or(0);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kRecords);
+}
+BENCHMARK(BM_SumFieldPacked);
+
+BENCHMARK_MAIN();
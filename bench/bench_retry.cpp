@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/retry.hpp>
+
+using Call = cpp_result::Result<int, int>;
+
+static Call succeed(int x) {
+  benchmark::DoNotOptimize(x);
+  return Call::Ok(x);
+}
+
+// Overhead of retry() when the first attempt succeeds.
+
+static void BM_DirectCall(benchmark::State &state) {
+  int x = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(succeed(++x));
+}
+BENCHMARK(BM_DirectCall);
+
+static void BM_RetryFirstAttemptOk(benchmark::State &state) {
+  cpp_result::RetryPolicy policy;
+  int x = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        cpp_result::retry([&] { return succeed(++x); }, policy));
+}
+BENCHMARK(BM_RetryFirstAttemptOk);
+
+static void BM_RetryFirstAttemptOkBudget(benchmark::State &state) {
+  static cpp_result::RetryBudget budget(0.1);
+  cpp_result::RetryPolicy policy;
+  policy.budget = &budget;
+  int x = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        cpp_result::retry([&] { return succeed(++x); }, policy));
+}
+BENCHMARK(BM_RetryFirstAttemptOkBudget)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/shm_queue.hpp>
+#include <sys/wait.h>
+#include <utility>
+#include <vector>
+
+using Queue = cpp_result::ShmQueue<std::uint64_t, std::int32_t>;
+using Item = Queue::Item;
+
+constexpr std::uint64_t kMessages = 1 << 20;
+
+static Item make(std::uint64_t i) {
+  return i % 64 == 0 ? Item::Err(static_cast<std::int32_t>(i))
+                     : Item::Ok(i);
+}
+
+// Forked child produces kMessages in batches of state.range(0); the parent
+// consumes them.
+static void BM_ShmQueue(benchmark::State &state) {
+  const auto batch = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    auto q = std::move(Queue::create(4096).unwrap());
+    pid_t pid = fork();
+    if (pid == 0) {
+      {
+        auto tx = std::move(q.producer().unwrap());
+        std::vector<Item> items;
+        for (std::uint64_t i = 0; i < kMessages; i += batch) {
+          items.clear();
+          for (std::uint64_t j = i; j < i + batch && j < kMessages; ++j)
+            items.push_back(make(j));
+          (void)tx.push_n(items.data(), items.size());
+        }
+      }
+      _exit(0);
+    }
+    auto rx = std::move(q.consumer().unwrap());
+    std::vector<Item> out;
+    std::uint64_t received = 0;
+    while (received < kMessages) {
+      out.clear();
+      auto got = rx.pop_n(out, 1024);
+      if (got.is_err())
+        break;
+      received += got.unwrap();
+    }
+    benchmark::DoNotOptimize(received);
+    waitpid(pid, nullptr, 0);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kMessages));
+}
+BENCHMARK(BM_ShmQueue)
+    ->Arg(1)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Baseline: one write(2) per message over a pipe, batched reads.
+static void BM_Pipe(benchmark::State &state) {
+  for (auto _ : state) {
+    auto fds = cpp_result::posix::pipe().unwrap();
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds.read_end);
+      for (std::uint64_t i = 0; i < kMessages; ++i) {
+        const Item item = make(i);
+        (void)cpp_result::posix::write_full(fds.write_end, &item,
+                                            sizeof(item));
+      }
+      _exit(0);
+    }
+    close(fds.write_end);
+    std::vector<Item> buf(1024, Item::Ok(0));
+    std::uint64_t bytes = 0;
+    for (;;) {
+      auto got = cpp_result::posix::read(fds.read_end, buf.data(),
+                                         buf.size() * sizeof(Item));
+      if (got.is_err() || got.unwrap() == 0)
+        break;
+      bytes += got.unwrap();
+    }
+    benchmark::DoNotOptimize(bytes);
+    close(fds.read_end);
+    waitpid(pid, nullptr, 0);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kMessages));
+}
+BENCHMARK(BM_Pipe)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/site.hpp>
+#include <string>
+
+using cpp_result::Result;
+using cpp_result::Traced;
+
+enum class Code { Invalid };
+
+// Provenance captured as strings, the usual alternative.
+struct StringSite {
+  Code code;
+  std::string file;
+  unsigned line;
+  std::string function;
+};
+
+template <typename E, typename Make>
+__attribute__((noinline)) Result<int, E> fail(int x, Make make) {
+  if (x >= 0)
+    return Result<int, E>::Err(make());
+  return Result<int, E>::Ok(x);
+}
+
+static void BM_ErrPlain(benchmark::State &state) {
+  int x = 1;
+  for (auto _ : state) {
+    auto r = fail<Code>(x, [] { return Code::Invalid; });
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_ErrPlain);
+
+static void BM_ErrTraced(benchmark::State &state) {
+  int x = 1;
+  for (auto _ : state) {
+    auto r = fail<Traced<Code>>(x, [] { return ERR_HERE(Code::Invalid); });
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_ErrTraced);
+
+static void BM_ErrStringSite(benchmark::State &state) {
+  int x = 1;
+  for (auto _ : state) {
+    auto r = fail<StringSite>(x, [] {
+      return StringSite{Code::Invalid, __FILE__, __LINE__, __func__};
+    });
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_ErrStringSite);
+
+BENCHMARK_MAIN();
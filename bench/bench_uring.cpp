@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <cpp_result/uring.hpp>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using cpp_result::BatchIo;
+using cpp_result::IoOp;
+
+// Random 4 KiB reads from a 64 MiB page-cache resident file, in batches of
+// state.range(0) operations.
+
+constexpr std::size_t kFileSize = 64u << 20;
+constexpr std::uint32_t kBlock = 4096;
+
+class UringFixture : public benchmark::Fixture {
+public:
+  void SetUp(const benchmark::State &state) override {
+    char tmpl[] = "/tmp/cpp_result_bench_uring_XXXXXX";
+    fd_ = ::mkstemp(tmpl);
+    ::unlink(tmpl);
+    std::string chunk(1u << 20, 'x');
+    for (std::size_t i = 0; i < kFileSize / chunk.size(); ++i)
+      if (cpp_result::posix::write_full(fd_, chunk.data(), chunk.size())
+              .is_err())
+        std::abort();
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    bufs_.assign(batch * kBlock, '\0');
+    std::mt19937_64 rng(7);
+    offsets_.resize(batch * 64);
+    for (auto &off : offsets_)
+      off = (rng() % (kFileSize / kBlock)) * kBlock;
+  }
+  void TearDown(const benchmark::State &) override { ::close(fd_); }
+
+protected:
+  int fd_ = -1;
+  std::string bufs_;
+  std::vector<std::uint64_t> offsets_;
+
+  void run_batched(benchmark::State &state, BatchIo &io) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    std::vector<IoOp> ops(batch);
+    std::size_t cursor = 0, errors = 0;
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < batch; ++i) {
+        ops[i] = IoOp::read(fd_, &bufs_[i * kBlock], kBlock,
+                            offsets_[cursor++ % offsets_.size()]);
+      }
+      auto done = io.submit(ops);
+      errors += done.is_err() ? batch : done.unwrap().error_count();
+    }
+    state.counters["errors"] = static_cast<double>(errors);
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(batch));
+  }
+};
+
+BENCHMARK_DEFINE_F(UringFixture, PreadLoop)(benchmark::State &state) {
+  const auto batch = static_cast<std::size_t>(state.range(0));
+  std::size_t cursor = 0, errors = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      if (::pread(fd_, &bufs_[i * kBlock], kBlock,
+                  static_cast<off_t>(offsets_[cursor++ % offsets_.size()])) !=
+          kBlock)
+        ++errors;
+    }
+  }
+  state.counters["errors"] = static_cast<double>(errors);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(batch));
+}
+BENCHMARK_REGISTER_F(UringFixture, PreadLoop)->Arg(1)->Arg(32)->Arg(128);
+
+BENCHMARK_DEFINE_F(UringFixture, BatchIoSync)(benchmark::State &state) {
+  auto io = BatchIo::create_sync();
+  run_batched(state, io);
+}
+BENCHMARK_REGISTER_F(UringFixture, BatchIoSync)->Arg(1)->Arg(32)->Arg(128);
+
+BENCHMARK_DEFINE_F(UringFixture, BatchIoUring)(benchmark::State &state) {
+  auto io = BatchIo::create(static_cast<unsigned>(state.range(0)));
+  if (io.backend() != BatchIo::Backend::IoUring) {
+    state.SkipWithError("io_uring unavailable");
+    return;
+  }
+  run_batched(state, io);
+}
+BENCHMARK_REGISTER_F(UringFixture, BatchIoUring)->Arg(1)->Arg(32)->Arg(128);
+
+BENCHMARK_MAIN();
@@ -1,3 +1,4 @@
+#include <cpp_result/exception.hpp>
 #include <iostream>
 #include <result.hpp>
 #include <string>
@@ -8,11 +9,10 @@ inline Result Err(std::string err) { return Result::Err(std::move(err)); }
 
 // Parse an int from a string, with error reporting
 Result parse_int(const std::string &s) {
-  try {
-    return Ok(std::stoi(s));
-  } catch (...) {
-    return Err("Invalid integer: " + s);
-  }
+  // std::stoi throws std::invalid_argument or std::out_of_range.
+  return cpp_result::catch_as_result<std::string>(
+      [&] { return std::stoi(s); },
+      [&](const std::logic_error &) { return "Invalid integer: " + s; });
 }
 
 // Divide two integers, error if division by zero
@@ -0,0 +1,76 @@
+#include <charconv>
+#include <cpp_result/pipeline.hpp>
+#include <iostream>
+#include <result.hpp>
+#include <sstream>
+#include <string>
+
+using Result = cpp_result::Result<int, std::string>;
+inline Result Ok(int val) { return Result::Ok(val); }
+inline Result Err(std::string err) { return Result::Err(std::move(err)); }
+
+// Parse an int from a string, with error reporting (allocation-free on the
+// success path, unlike std::stoi)
+Result parse_int(std::string_view s) {
+  int value = 0;
+  auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (ec != std::errc() || end != s.data() + s.size())
+    return Err("Invalid integer: " + std::string(s));
+  return Ok(value);
+}
+
+// Divide two integers, error if division by zero
+Result safe_div(int a, int b) {
+  if (b == 0)
+    return Err("Division by zero");
+  return Ok(a / b);
+}
+
+// Parse one "a b" record and divide a by b
+Result parse_record(std::string_view line) {
+  auto space = line.find(' ');
+  if (space == std::string_view::npos)
+    return Err("Missing divisor: " + std::string(line));
+  int x = TRY(parse_int(line.substr(0, space)));
+  int y = TRY(parse_int(line.substr(space + 1)));
+  return safe_div(x, y);
+}
+
+int main(int argc, char **argv) {
+  std::istringstream sample("40 2\n18 2\nabc 2\n10 0\n99\n7 7\n");
+  cpp_result::PipelineOptions opts;
+  opts.max_errors = 10;
+
+  long long sum = 0;
+  auto on_ok = [&](int v) { sum += v; };
+  auto on_err = [](std::string &&e, std::size_t line) {
+    std::cout << "Error on line " << line << ": " << e << "\n";
+  };
+
+  cpp_result::Result<cpp_result::PipelineStats, cpp_result::PipelineError>
+      run = argc > 1
+                ? cpp_result::posix::open(argv[1], O_RDONLY | O_CLOEXEC)
+                      .map_err([](cpp_result::Errno e) {
+                        return cpp_result::PipelineError{
+                            cpp_result::PipelineError::Kind::Read, e, {}};
+                      })
+                      .and_then([&](int fd) {
+                        auto stats = cpp_result::run_pipeline(
+                            cpp_result::fd_reader(fd), parse_record, on_ok,
+                            on_err, opts);
+                        (void)cpp_result::posix::close(fd);
+                        return stats;
+                      })
+                : cpp_result::run_pipeline(cpp_result::istream_reader(sample),
+                                           parse_record, on_ok, on_err, opts);
+
+  run.inspect([&](const cpp_result::PipelineStats &s) {
+       std::cout << s.records << " records, " << s.ok << " ok, " << s.errors
+                 << " errors, sum = " << sum << "\n";
+     })
+      .inspect_err([](const cpp_result::PipelineError &e) {
+        std::cout << "Pipeline aborted after " << e.stats.records
+                  << " records\n";
+      });
+  return run.is_ok() ? 0 : 1;
+}
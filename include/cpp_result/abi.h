@@ -0,0 +1,107 @@
+/* abi.h - C-compatible Result layouts for shared-library boundaries
+ * SPDX-License-Identifier: MIT
+ *
+ * Plain C (C99 and later, also valid C++). A result crosses an FFI or
+ * `.so` boundary as a small struct: a one-byte tag followed by a union of
+ * the Ok and Err payloads. Structs of at most 16 bytes are returned in
+ * registers by the x86-64 System V and AArch64 calling conventions, so
+ * functions can return them by value without out-params or allocation.
+ *
+ * Errors that carry more than a POD value travel as a pointer to a
+ * cpp_result_error box. The box is released through its own `release`
+ * function, so memory is freed by the module that allocated it.
+ *
+ * --- API OVERVIEW ---
+ *
+ *   CPP_RESULT_ABI_DECLARE(name, ok_type, err_type)
+ *   CPP_RESULT_ABI_DECLARE_VOID(name, err_type)
+ *   CPP_RESULT_ABI_OK(name, value), CPP_RESULT_ABI_ERR(name, error)   (C)
+ *   cpp_result_error, cpp_result_error_release(err)
+ *   Predeclared: cpp_result_abi_i32, cpp_result_abi_i64, cpp_result_abi_u64,
+ *                cpp_result_abi_f64, cpp_result_abi_ptr, cpp_result_abi_void,
+ *                cpp_result_abi_i64_boxed, cpp_result_abi_void_boxed
+ *   (Err payload int32_t, or cpp_result_error * for the _boxed variants)
+ */
+
+#ifndef CPP_RESULT_ABI_H
+#define CPP_RESULT_ABI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Value of the `is_ok` tag for an Ok result. */
+#define CPP_RESULT_ABI_TAG_OK 1
+/** Value of the `is_ok` tag for an Err result. */
+#define CPP_RESULT_ABI_TAG_ERR 0
+
+/**
+ * Declares `name` as a result struct with Ok payload `ok_type` and Err
+ * payload `err_type`. Both must be plain C types.
+ *
+ *   CPP_RESULT_ABI_DECLARE(parse_result, int64_t, int32_t)
+ *   parse_result parse(const char *s);
+ */
+#define CPP_RESULT_ABI_DECLARE(name, ok_type, err_type)                        \
+  typedef struct name {                                                        \
+    uint8_t is_ok;                                                             \
+    union {                                                                    \
+      ok_type ok;                                                              \
+      err_type err;                                                            \
+    } u;                                                                       \
+  } name
+
+/**
+ * Declares `name` as a result struct without an Ok payload.
+ */
+#define CPP_RESULT_ABI_DECLARE_VOID(name, err_type)                            \
+  typedef struct name {                                                        \
+    uint8_t is_ok;                                                             \
+    union {                                                                    \
+      err_type err;                                                            \
+    } u;                                                                       \
+  } name
+
+#ifndef __cplusplus
+/* C only; C++ code converts with cpp_result::to_abi (abi.hpp). */
+
+/** Builds an Ok `name` from a value (a C99 compound literal). */
+#define CPP_RESULT_ABI_OK(name, value)                                         \
+  ((name){.is_ok = CPP_RESULT_ABI_TAG_OK, .u = {.ok = (value)}})
+/** Builds an Err `name` from an error (a C99 compound literal). */
+#define CPP_RESULT_ABI_ERR(name, error)                                        \
+  ((name){.is_ok = CPP_RESULT_ABI_TAG_ERR, .u = {.err = (error)}})
+#endif
+
+/**
+ * Heap-allocated error with a message. `release` frees the box and is
+ * provided by whoever allocated it.
+ */
+typedef struct cpp_result_error {
+  int32_t code;
+  const char *message;
+  void (*release)(struct cpp_result_error *self);
+} cpp_result_error;
+
+/** Releases a boxed error; does nothing for NULL. */
+static inline void cpp_result_error_release(cpp_result_error *err) {
+  if (err && err->release)
+    err->release(err);
+}
+
+CPP_RESULT_ABI_DECLARE(cpp_result_abi_i32, int32_t, int32_t);
+CPP_RESULT_ABI_DECLARE(cpp_result_abi_i64, int64_t, int32_t);
+CPP_RESULT_ABI_DECLARE(cpp_result_abi_u64, uint64_t, int32_t);
+CPP_RESULT_ABI_DECLARE(cpp_result_abi_f64, double, int32_t);
+CPP_RESULT_ABI_DECLARE(cpp_result_abi_ptr, void *, int32_t);
+CPP_RESULT_ABI_DECLARE_VOID(cpp_result_abi_void, int32_t);
+CPP_RESULT_ABI_DECLARE(cpp_result_abi_i64_boxed, int64_t, cpp_result_error *);
+CPP_RESULT_ABI_DECLARE_VOID(cpp_result_abi_void_boxed, cpp_result_error *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPP_RESULT_ABI_H */
@@ -0,0 +1,182 @@
+// abi.hpp - Conversions between Result<T, E> and the C layouts of abi.h
+// SPDX-License-Identifier: MIT
+//
+// to_abi() and from_abi() convert between Result<T, E> and a struct
+// declared with CPP_RESULT_ABI_DECLARE. The payload types must match the
+// struct's exactly and be trivially copyable, so a round trip is lossless
+// and allocation-free. Errors that need a message go through
+// box_error()/ErrorBox, the C++ side of cpp_result_error.
+//
+// --- API OVERVIEW ---
+//
+//   to_abi<Abi>(result)        -> Abi
+//   from_abi(abi)              -> Result<ok_type, err_type>
+//   abi_result_t<Abi>          the Result type matching Abi
+//   abi_in_registers_v<Abi>    true when Abi fits in two registers
+//   box_error(code, message)   -> cpp_result_error * (released by the box)
+//   ErrorBox                   owning wrapper of a received cpp_result_error *
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/abi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+namespace detail {
+
+template <typename Abi, typename = void> struct AbiOk {
+  using type = void;
+};
+template <typename Abi>
+struct AbiOk<Abi, std::void_t<decltype(std::declval<Abi &>().u.ok)>> {
+  using type = std::remove_reference_t<decltype(std::declval<Abi &>().u.ok)>;
+};
+
+} // namespace detail
+
+/**
+ * @brief Payload types of a struct declared with CPP_RESULT_ABI_DECLARE.
+ */
+template <typename Abi> struct AbiTraits {
+  static_assert(std::is_standard_layout_v<Abi> &&
+                    std::is_trivially_copyable_v<Abi>,
+                "Abi must be a CPP_RESULT_ABI_DECLARE struct");
+
+  using ok_type = typename detail::AbiOk<Abi>::type;
+  using err_type =
+      std::remove_reference_t<decltype(std::declval<Abi &>().u.err)>;
+  using result_type = Result<ok_type, err_type>;
+};
+
+template <typename Abi>
+using abi_result_t = typename AbiTraits<Abi>::result_type;
+
+/**
+ * @brief True when Abi is returned in registers (at most 16 bytes) by the
+ * x86-64 System V and AArch64 calling conventions.
+ */
+template <typename Abi>
+constexpr bool abi_in_registers_v =
+    sizeof(Abi) <= 16 && std::is_trivially_copyable_v<Abi>;
+
+/**
+ * @brief Converts a Result to its C layout.
+ * @code
+ * extern "C" cpp_result_abi_i64 plugin_count(const char *path) {
+ *   return cpp_result::to_abi<cpp_result_abi_i64>(count_lines(path));
+ * }
+ * @endcode
+ */
+template <typename Abi, typename T, typename E>
+inline Abi to_abi(const Result<T, E> &result) noexcept {
+  using Traits = AbiTraits<Abi>;
+  static_assert(std::is_same_v<T, typename Traits::ok_type> &&
+                    std::is_same_v<E, typename Traits::err_type>,
+                "Result payload types must match the Abi struct");
+  Abi out;
+  std::memset(&out, 0, sizeof(out));
+  if (result.is_ok()) {
+    out.is_ok = CPP_RESULT_ABI_TAG_OK;
+    if constexpr (!std::is_void_v<T>)
+      out.u.ok = result.unwrap();
+  } else {
+    out.is_ok = CPP_RESULT_ABI_TAG_ERR;
+    out.u.err = result.unwrap_err();
+  }
+  return out;
+}
+
+/**
+ * @brief Converts a C layout back to a Result. Any non-zero tag is Ok.
+ */
+template <typename Abi>
+inline abi_result_t<Abi> from_abi(const Abi &abi) noexcept {
+  using R = abi_result_t<Abi>;
+  if (abi.is_ok == CPP_RESULT_ABI_TAG_ERR)
+    return R::Err(abi.u.err);
+  if constexpr (std::is_void_v<typename AbiTraits<Abi>::ok_type>)
+    return R::Ok();
+  else
+    return R::Ok(abi.u.ok);
+}
+
+namespace detail {
+
+inline void release_boxed_error(cpp_result_error *err) noexcept {
+  err->~cpp_result_error();
+  ::operator delete(static_cast<void *>(err));
+}
+
+} // namespace detail
+
+/**
+ * @brief Allocates a cpp_result_error holding a copy of message.
+ *
+ * The box and the message share one allocation, freed by its `release`
+ * function from this module, whichever side calls it.
+ */
+inline cpp_result_error *box_error(std::int32_t code,
+                                   std::string_view message) {
+  void *mem = ::operator new(sizeof(cpp_result_error) + message.size() + 1);
+  char *text = static_cast<char *>(mem) + sizeof(cpp_result_error);
+  std::memcpy(text, message.data(), message.size());
+  text[message.size()] = '\0';
+  return new (mem)
+      cpp_result_error{code, text, &detail::release_boxed_error};
+}
+
+/**
+ * @brief Owns a cpp_result_error received across the boundary and
+ * releases it on destruction.
+ * @code
+ * auto r = cpp_result::from_abi(plugin_parse("x"))
+ *              .map_err(cpp_result::ErrorBox::adopt);
+ * if (r.is_err())
+ *   log(r.unwrap_err().message());
+ * @endcode
+ */
+class ErrorBox {
+public:
+  explicit ErrorBox(cpp_result_error *err) noexcept : err_(err) {}
+  static ErrorBox adopt(cpp_result_error *err) noexcept {
+    return ErrorBox(err);
+  }
+
+  ErrorBox(ErrorBox &&other) noexcept
+      : err_(std::exchange(other.err_, nullptr)) {}
+  ErrorBox &operator=(ErrorBox &&other) noexcept {
+    if (this != &other) {
+      cpp_result_error_release(err_);
+      err_ = std::exchange(other.err_, nullptr);
+    }
+    return *this;
+  }
+  ErrorBox(const ErrorBox &) = delete;
+  ErrorBox &operator=(const ErrorBox &) = delete;
+  ~ErrorBox() { cpp_result_error_release(err_); }
+
+  std::int32_t code() const noexcept { return err_ ? err_->code : 0; }
+  std::string_view message() const noexcept {
+    return err_ && err_->message ? std::string_view(err_->message)
+                                 : std::string_view();
+  }
+
+  /// Gives up ownership, e.g. to pass the error on through another ABI.
+  cpp_result_error *release() noexcept { return std::exchange(err_, nullptr); }
+
+private:
+  cpp_result_error *err_;
+};
+
+} // namespace cpp_result
@@ -0,0 +1,395 @@
+// byte_reader.hpp - Bounds-checked zero-copy binary reader for cpp_result
+// SPDX-License-Identifier: MIT
+//
+// ByteReader decodes fixed-size values, LEB128 varints, raw byte runs and
+// length-prefixed strings from a borrowed buffer. Every read returns a
+// Result<..., DecodeError>; nothing is copied out of the buffer except the
+// decoded scalars themselves.
+//
+// --- API OVERVIEW ---
+//
+//   ByteReader r(data, size);
+//   r.read<T>()           -> Result<T, DecodeError>
+//   r.read_varint()       -> Result<std::uint64_t, DecodeError>
+//   r.read_bytes(n)       -> Result<ByteView, DecodeError>
+//   r.read_string_view()  -> Result<std::string_view, DecodeError>
+//   r.reserve(n)          -> Result<UncheckedReader, DecodeError>
+//
+// Multi-byte values are read in host byte order.
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+#include <span>
+#define CPP_RESULT_HAS_SPAN 1
+#else
+#define CPP_RESULT_HAS_SPAN 0
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace cpp_result {
+
+/**
+ * @brief Error returned by ByteReader when a read cannot be satisfied.
+ *
+ * `offset` is the reader position at which the failing read started.
+ */
+struct DecodeError {
+  enum class Kind : std::uint8_t {
+    UnexpectedEof,  ///< Fewer bytes remain than the read requires.
+    VarintOverflow, ///< Varint longer than 10 bytes or above 2^64 - 1.
+    InvalidTag,     ///< Unknown discriminant in an encoded value.
+  };
+
+  Kind kind;
+  std::size_t offset;
+
+  bool operator==(const DecodeError &other) const noexcept {
+    return kind == other.kind && offset == other.offset;
+  }
+  bool operator!=(const DecodeError &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief Non-owning view over a contiguous run of bytes.
+ *
+ * Stand-in for `std::span<const std::byte>` in C++17 builds; converts from
+ * and to `std::span` when the standard library provides it.
+ */
+class ByteView {
+public:
+  constexpr ByteView() noexcept = default;
+  constexpr ByteView(const std::byte *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+  ByteView(const void *data, std::size_t size) noexcept
+      : data_(static_cast<const std::byte *>(data)), size_(size) {}
+#if CPP_RESULT_HAS_SPAN
+  constexpr ByteView(std::span<const std::byte> s) noexcept
+      : data_(s.data()), size_(s.size()) {}
+  constexpr operator std::span<const std::byte>() const noexcept {
+    return {data_, size_};
+  }
+#endif
+
+  constexpr const std::byte *data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr const std::byte *begin() const noexcept { return data_; }
+  constexpr const std::byte *end() const noexcept { return data_ + size_; }
+  constexpr std::byte operator[](std::size_t i) const noexcept {
+    return data_[i];
+  }
+
+  /**
+   * @brief Returns the bytes reinterpreted as characters.
+   */
+  std::string_view as_string_view() const noexcept {
+    return {reinterpret_cast<const char *>(data_), size_};
+  }
+
+private:
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+namespace detail {
+
+constexpr std::size_t kMaxVarintBytes = 10;
+
+// Decodes a LEB128 varint one byte at a time. Used for the tail of the
+// buffer and for varints longer than 8 bytes.
+inline Result<std::uint64_t, DecodeError>
+decode_varint_slow(const std::byte *p, std::size_t avail, std::size_t offset,
+                   std::size_t &consumed) noexcept {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < kMaxVarintBytes; ++i) {
+    if (i == avail)
+      return Result<std::uint64_t, DecodeError>::Err(
+          {DecodeError::Kind::UnexpectedEof, offset});
+    const auto b = static_cast<std::uint64_t>(p[i]);
+    if (i == kMaxVarintBytes - 1 && b > 1)
+      break;
+    value |= (b & 0x7f) << (7 * i);
+    if (!(b & 0x80)) {
+      consumed = i + 1;
+      return Result<std::uint64_t, DecodeError>::Ok(value);
+    }
+  }
+  return Result<std::uint64_t, DecodeError>::Err(
+      {DecodeError::Kind::VarintOverflow, offset});
+}
+
+// Word-at-a-time varint decoder: loads 8 bytes, locates the terminating
+// byte with a single mask/ctz and gathers the 7-bit groups with PEXT (BMI2)
+// or three shift/mask steps. Returns false when the varint does not end
+// within the loaded word so the caller can fall back to the byte loop.
+inline bool decode_varint_word(const std::byte *p, std::uint64_t &value,
+                               std::size_t &consumed) noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ &&    \
+    (defined(__GNUC__) || defined(__clang__))
+  std::uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  const std::uint64_t stops = ~word & 0x8080808080808080ull;
+  if (stops == 0)
+    return false;
+  const unsigned bits = static_cast<unsigned>(__builtin_ctzll(stops)) + 1;
+  consumed = bits / 8;
+  if (bits < 64)
+    word &= (std::uint64_t{1} << bits) - 1;
+#if defined(__BMI2__)
+  value = _pext_u64(word, 0x7f7f7f7f7f7f7f7full);
+#else
+  word &= 0x7f7f7f7f7f7f7f7full;
+  word = ((word & 0x7f007f007f007f00ull) >> 1) | (word & 0x007f007f007f007full);
+  word = ((word & 0x3fff00003fff0000ull) >> 2) | (word & 0x00003fff00003fffull);
+  word = ((word & 0x0fffffff00000000ull) >> 4) | (word & 0x000000000fffffffull);
+  value = word;
+#endif
+  return true;
+#else
+  (void)p;
+  (void)value;
+  (void)consumed;
+  return false;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Reader over a pre-validated byte range; performs no bounds checks.
+ *
+ * Obtained from ByteReader::reserve(), which checks once that the whole
+ * range is available. Reading past the reserved size is undefined behavior.
+ *
+ * @code
+ * ByteReader r(buf, len);
+ * auto hdr = TRY(r.reserve(12));
+ * auto id = hdr.read<std::uint32_t>();
+ * auto ts = hdr.read<std::uint64_t>();
+ * @endcode
+ */
+class UncheckedReader {
+public:
+  constexpr UncheckedReader(const std::byte *data, std::size_t size) noexcept
+      : pos_(data), end_(data + size) {}
+
+  /**
+   * @brief Returns the number of reserved bytes not consumed yet.
+   */
+  constexpr std::size_t remaining() const noexcept {
+    return static_cast<std::size_t>(end_ - pos_);
+  }
+
+  /**
+   * @brief Reads a trivially copyable T without a bounds check.
+   */
+  template <typename T> T read() noexcept {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "UncheckedReader::read<T> requires a trivially copyable T");
+    T value;
+    std::memcpy(&value, pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  /**
+   * @brief Returns a view of the next n bytes without a bounds check.
+   */
+  ByteView read_bytes(std::size_t n) noexcept {
+    ByteView view(pos_, n);
+    pos_ += n;
+    return view;
+  }
+
+  /**
+   * @brief Skips n bytes without a bounds check.
+   */
+  void skip(std::size_t n) noexcept { pos_ += n; }
+
+private:
+  const std::byte *pos_;
+  const std::byte *end_;
+};
+
+/**
+ * @brief Bounds-checked, zero-copy reader over a borrowed byte buffer.
+ *
+ * The buffer must outlive the reader and every view returned by it. A failed
+ * read leaves the position unchanged.
+ *
+ * @code
+ * cpp_result::ByteReader r(buf.data(), buf.size());
+ * auto id = r.read<std::uint32_t>();
+ * auto name = r.read_string_view();
+ * if (id.is_err() || name.is_err())
+ *   return;
+ * @endcode
+ */
+class ByteReader {
+public:
+  template <typename T> using Result = cpp_result::Result<T, DecodeError>;
+
+  constexpr ByteReader(const std::byte *data, std::size_t size) noexcept
+      : begin_(data), pos_(data), end_(data + size) {}
+  ByteReader(const void *data, std::size_t size) noexcept
+      : ByteReader(static_cast<const std::byte *>(data), size) {}
+  constexpr explicit ByteReader(ByteView bytes) noexcept
+      : ByteReader(bytes.data(), bytes.size()) {}
+#if CPP_RESULT_HAS_SPAN
+  constexpr explicit ByteReader(std::span<const std::byte> bytes) noexcept
+      : ByteReader(bytes.data(), bytes.size()) {}
+#endif
+
+  /**
+   * @brief Returns the number of bytes consumed so far.
+   */
+  constexpr std::size_t position() const noexcept {
+    return static_cast<std::size_t>(pos_ - begin_);
+  }
+
+  /**
+   * @brief Returns the number of bytes left to read.
+   */
+  constexpr std::size_t remaining() const noexcept {
+    return static_cast<std::size_t>(end_ - pos_);
+  }
+
+  /**
+   * @brief Returns true when every byte has been consumed.
+   */
+  constexpr bool empty() const noexcept { return pos_ == end_; }
+
+  /**
+   * @brief Reads a trivially copyable T in host byte order.
+   * @code
+   * auto v = reader.read<std::uint32_t>();
+   * @endcode
+   */
+  template <typename T> Result<T> read() noexcept {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "ByteReader::read<T> requires a trivially copyable T");
+    if (remaining() < sizeof(T))
+      return Result<T>::Err(eof());
+    T value;
+    std::memcpy(&value, pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return Result<T>::Ok(value);
+  }
+
+  /**
+   * @brief Reads an unsigned LEB128 varint of at most 10 bytes.
+   * @code
+   * auto len = reader.read_varint();
+   * @endcode
+   */
+  Result<std::uint64_t> read_varint() noexcept {
+    std::size_t consumed = 0;
+    if (remaining() >= sizeof(std::uint64_t)) {
+      std::uint64_t value;
+      if (detail::decode_varint_word(pos_, value, consumed)) {
+        pos_ += consumed;
+        return Result<std::uint64_t>::Ok(value);
+      }
+    }
+    auto res =
+        detail::decode_varint_slow(pos_, remaining(), position(), consumed);
+    if (res.is_ok())
+      pos_ += consumed;
+    return res;
+  }
+
+  /**
+   * @brief Returns a view of the next n bytes.
+   * @code
+   * auto payload = reader.read_bytes(16);
+   * @endcode
+   */
+  Result<ByteView> read_bytes(std::size_t n) noexcept {
+    if (remaining() < n)
+      return Result<ByteView>::Err(eof());
+    ByteView view(pos_, n);
+    pos_ += n;
+    return Result<ByteView>::Ok(view);
+  }
+
+  /**
+   * @brief Reads a varint length followed by that many bytes of text.
+   * @code
+   * auto name = reader.read_string_view();
+   * @endcode
+   */
+  Result<std::string_view> read_string_view() noexcept {
+    const std::byte *start = pos_;
+    auto len = read_varint();
+    if (len.is_err())
+      return Result<std::string_view>::Err(len.unwrap_err());
+    if (remaining() < len.unwrap()) {
+      pos_ = start;
+      return Result<std::string_view>::Err(eof_at(start));
+    }
+    std::string_view view(reinterpret_cast<const char *>(pos_),
+                          static_cast<std::size_t>(len.unwrap()));
+    pos_ += view.size();
+    return Result<std::string_view>::Ok(view);
+  }
+
+  /**
+   * @brief Skips the next n bytes.
+   */
+  Result<void> skip(std::size_t n) noexcept {
+    if (remaining() < n)
+      return Result<void>::Err(eof());
+    pos_ += n;
+    return Result<void>::Ok();
+  }
+
+  /**
+   * @brief Checks once that n bytes are available and returns an unchecked
+   * reader over them, advancing past the range.
+   *
+   * Use this to amortize bounds checks over a fixed-layout header or a run
+   * of records whose total size is known up front.
+   * @code
+   * auto rec = TRY(reader.reserve(sizeof(std::uint32_t) * 2));
+   * auto a = rec.read<std::uint32_t>();
+   * auto b = rec.read<std::uint32_t>();
+   * @endcode
+   */
+  Result<UncheckedReader> reserve(std::size_t n) noexcept {
+    if (remaining() < n)
+      return Result<UncheckedReader>::Err(eof());
+    UncheckedReader sub(pos_, n);
+    pos_ += n;
+    return Result<UncheckedReader>::Ok(sub);
+  }
+
+private:
+  const std::byte *begin_;
+  const std::byte *pos_;
+  const std::byte *end_;
+
+  DecodeError eof() const noexcept {
+    return {DecodeError::Kind::UnexpectedEof, position()};
+  }
+  DecodeError eof_at(const std::byte *at) const noexcept {
+    return {DecodeError::Kind::UnexpectedEof,
+            static_cast<std::size_t>(at - begin_)};
+  }
+};
+
+} // namespace cpp_result
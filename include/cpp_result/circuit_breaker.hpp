@@ -0,0 +1,334 @@
+// circuit_breaker.hpp - Error-rate circuit breaker for Result-returning calls
+// SPDX-License-Identifier: MIT
+//
+// CircuitBreaker<E> guards calls returning Result<T, E>. While Closed, it
+// counts successes and failures in a sliding window of lock-free buckets;
+// once the failure rate crosses the threshold it Opens and answers every
+// call with a copy of a preconstructed error, without running it. After a
+// cooldown it goes HalfOpen and lets a few probe calls through: if they
+// succeed it Closes again, otherwise it re-Opens.
+//
+// Which errors count as failures is decided per call with a predicate
+// applied through Result::is_err_and, so e.g. "not found" can be an Err
+// for the caller but healthy for the breaker.
+//
+// --- API OVERVIEW ---
+//
+//   CircuitBreaker<E>(open_error, policy)
+//   breaker.call(f)                  -> Result<T, E>, every Err is a failure
+//   breaker.call(f, is_failure)      -> Result<T, E>
+//   breaker.state()                  -> BreakerState
+//   breaker.window()                 -> BreakerWindow {successes, failures}
+//   breaker.rejected(), breaker.reset()
+//   BreakerPolicy                    window, threshold, cooldown, probes
+
+#pragma once
+
+#include <result.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/**
+ * @brief Monotonic clock read with CLOCK_MONOTONIC_COARSE where available.
+ *
+ * A coarse read costs a few nanoseconds against ~20 for steady_clock, at a
+ * resolution of a few milliseconds, which is plenty for breaker windows.
+ */
+struct CoarseClock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<CoarseClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept {
+#ifdef CLOCK_MONOTONIC_COARSE
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return time_point(duration(static_cast<rep>(ts.tv_sec) * 1000000000 +
+                               ts.tv_nsec));
+#else
+    return time_point(std::chrono::duration_cast<duration>(
+        std::chrono::steady_clock::now().time_since_epoch()));
+#endif
+  }
+};
+
+/**
+ * @brief When a CircuitBreaker opens and how it recovers.
+ */
+struct BreakerPolicy {
+  /// Length of the sliding window of counted calls.
+  std::chrono::nanoseconds window = std::chrono::seconds(10);
+  /// Buckets the window is split into; it slides one bucket at a time.
+  /// Bucket widths are rounded down to a power of two nanoseconds, so up
+  /// to twice as many buckets may be used.
+  unsigned buckets = 10;
+  /// Open once failures / calls in the window reaches this ratio...
+  double failure_threshold = 0.5;
+  /// ...and the window holds at least this many calls.
+  std::uint32_t min_calls = 20;
+  /// Time spent Open before probing.
+  std::chrono::nanoseconds cooldown = std::chrono::seconds(5);
+  /// Concurrent probes allowed while HalfOpen; this many successes close
+  /// the breaker.
+  std::uint32_t probes = 3;
+};
+
+namespace detail {
+
+// One cache line of window buckets.
+struct alignas(64) BreakerLine {
+  std::atomic<std::uint64_t> words[8] = {};
+};
+
+// Small per-thread id used to pick a counter stripe.
+inline unsigned breaker_stripe() noexcept {
+  static std::atomic<unsigned> next{0};
+  thread_local const unsigned id = next.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+inline unsigned breaker_log2(std::uint64_t x) noexcept {
+  unsigned n = 0;
+  while (x >>= 1)
+    ++n;
+  return n;
+}
+
+inline std::size_t breaker_pow2(std::size_t x) noexcept {
+  std::size_t p = 1;
+  while (p < x)
+    p <<= 1;
+  return p;
+}
+
+} // namespace detail
+
+enum class BreakerState : std::uint8_t { Closed, Open, HalfOpen };
+
+/**
+ * @brief Calls counted in the current window.
+ */
+struct BreakerWindow {
+  std::uint64_t successes = 0;
+  std::uint64_t failures = 0;
+};
+
+/**
+ * @brief Circuit breaker for calls returning Result<T, E>.
+ *
+ * Thread-safe and lock-free. Window counters are striped per thread, so in
+ * the Closed state a call costs a coarse clock read and a relaxed atomic
+ * add (uncontended unless more than 16 threads have used the breaker),
+ * plus a window scan after a failure. No count is lost.
+ *
+ * @code
+ * cpp_result::CircuitBreaker<Error> breaker(Error{Code::Unavailable});
+ * auto user = breaker.call([&] { return client.fetch_user(id); },
+ *                          [](const Error &e) { return e.retryable(); });
+ * @endcode
+ */
+template <typename E, typename Clock = CoarseClock> class CircuitBreaker {
+public:
+  explicit CircuitBreaker(E open_error, const BreakerPolicy &policy = {})
+      : open_error_(std::move(open_error)), policy_(policy),
+        bucket_shift_(detail::breaker_log2(static_cast<std::uint64_t>(
+            policy.window.count() /
+            std::max<std::int64_t>(1, policy.buckets)))),
+        nbuckets_(static_cast<unsigned>(std::max<std::int64_t>(
+            1, (policy.window.count() + (std::int64_t{1} << bucket_shift_) -
+                1) >> bucket_shift_))),
+        ring_mask_(detail::breaker_pow2(nbuckets_) - 1),
+        stride_(std::max<std::size_t>(ring_mask_ + 1, kWordsPerLine)),
+        buckets_(new detail::BreakerLine[kStripes * stride_ / kWordsPerLine]) {
+  }
+
+  /**
+   * @brief Runs f unless the breaker is open; every Err counts as failure.
+   */
+  template <typename F> auto call(F &&f) {
+    return call(std::forward<F>(f), [](const E &) { return true; });
+  }
+
+  /**
+   * @brief Runs f unless the breaker is open. An Err for which
+   * is_failure(err) is false counts as a success.
+   */
+  template <typename F, typename Pred> auto call(F &&f, Pred &&is_failure) {
+    using R = std::invoke_result_t<F &>;
+    const std::int64_t now = ticks();
+    BreakerState s = state_.load(std::memory_order_acquire);
+    if (s == BreakerState::Closed) {
+      R result = f();
+      record(result.is_err_and(is_failure), now);
+      return result;
+    }
+    if (s == BreakerState::Open) {
+      if (now - opened_at_.load(std::memory_order_acquire) <
+          policy_.cooldown.count())
+        return reject<R>();
+      if (state_.compare_exchange_strong(s, BreakerState::HalfOpen,
+                                         std::memory_order_acq_rel))
+        probe_successes_.store(0, std::memory_order_release);
+    }
+    return probe<R>(std::forward<F>(f), is_failure, now);
+  }
+
+  BreakerState state() const noexcept {
+    return state_.load(std::memory_order_acquire);
+  }
+
+  /// Calls short-circuited while Open or HalfOpen.
+  std::uint64_t rejected() const noexcept {
+    return rejected_.load(std::memory_order_relaxed);
+  }
+
+  BreakerWindow window() const noexcept { return sum(ticks() >> bucket_shift_); }
+
+  /**
+   * @brief Closes the breaker and empties the window.
+   */
+  void reset() noexcept {
+    clear_window();
+    state_.store(BreakerState::Closed, std::memory_order_release);
+  }
+
+private:
+  // Bucket word: | slot tag : 16 | successes : 24 | failures : 24 |
+  static constexpr std::uint64_t kCountMask = (std::uint64_t{1} << 24) - 1;
+  // Counts stop below the field limit, leaving headroom for concurrent
+  // adds that passed the check so they cannot carry into the next field.
+  static constexpr std::uint64_t kCountSaturated = kCountMask - 0xffff;
+  static constexpr unsigned kSuccessShift = 24;
+  static constexpr unsigned kTagShift = 48;
+  static constexpr unsigned kStripes = 16;
+  static constexpr unsigned kWordsPerLine = 8;
+
+  static std::int64_t ticks() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now().time_since_epoch())
+        .count();
+  }
+
+  static std::uint64_t tag_of(std::int64_t slot) noexcept {
+    return static_cast<std::uint64_t>(slot) & 0xffff;
+  }
+
+  std::atomic<std::uint64_t> &word(unsigned stripe, std::int64_t slot) const {
+    const std::size_t i =
+        stripe * stride_ + (static_cast<std::size_t>(slot) & ring_mask_);
+    return buckets_[i / kWordsPerLine].words[i % kWordsPerLine];
+  }
+
+  // Threads share a stripe once more than kStripes have ever called (ids
+  // only grow), so counts are atomic adds; uncontended they cost about as
+  // much as a store. A bucket from an older slot is reset by CAS, and a
+  // thread losing that race adds to the winner's fresh bucket instead.
+  void record(bool failed, std::int64_t now) noexcept {
+    const std::int64_t slot = now >> bucket_shift_;
+    auto &bucket = word(detail::breaker_stripe() % kStripes, slot);
+    const unsigned shift = failed ? 0 : kSuccessShift;
+    const std::uint64_t one = std::uint64_t{1} << shift;
+    std::uint64_t w = bucket.load(std::memory_order_relaxed);
+    for (;;) {
+      if ((w >> kTagShift) == tag_of(slot)) {
+        if (((w >> shift) & kCountMask) < kCountSaturated)
+          bucket.fetch_add(one, std::memory_order_relaxed);
+        break;
+      }
+      if (bucket.compare_exchange_weak(w, (tag_of(slot) << kTagShift) | one,
+                                       std::memory_order_relaxed))
+        break;
+    }
+    if (failed && should_trip(slot))
+      trip(now);
+  }
+
+  BreakerWindow sum(std::int64_t slot) const noexcept {
+    BreakerWindow w;
+    for (unsigned stripe = 0; stripe < kStripes; ++stripe)
+      for (unsigned i = 0; i < nbuckets_; ++i) {
+        const std::int64_t s = slot - static_cast<std::int64_t>(i);
+        const std::uint64_t v =
+            word(stripe, s).load(std::memory_order_relaxed);
+        if ((v >> kTagShift) != tag_of(s))
+          continue;
+        w.successes += (v >> kSuccessShift) & kCountMask;
+        w.failures += v & kCountMask;
+      }
+    return w;
+  }
+
+  void clear_window() noexcept {
+    for (std::size_t i = 0; i < kStripes * stride_ / kWordsPerLine; ++i)
+      for (auto &w : buckets_[i].words)
+        w.store(0, std::memory_order_relaxed);
+  }
+
+  bool should_trip(std::int64_t slot) const noexcept {
+    const BreakerWindow w = sum(slot);
+    const std::uint64_t calls = w.successes + w.failures;
+    return calls >= policy_.min_calls &&
+           static_cast<double>(w.failures) >=
+               policy_.failure_threshold * static_cast<double>(calls);
+  }
+
+  void trip(std::int64_t now) noexcept {
+    opened_at_.store(now, std::memory_order_release);
+    state_.store(BreakerState::Open, std::memory_order_release);
+  }
+
+  template <typename R> R reject() {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    return R::Err(open_error_);
+  }
+
+  template <typename R, typename F, typename Pred>
+  R probe(F &&f, Pred &is_failure, std::int64_t now) {
+    if (probes_in_flight_.fetch_add(1, std::memory_order_acq_rel) >=
+        policy_.probes) {
+      probes_in_flight_.fetch_sub(1, std::memory_order_relaxed);
+      return reject<R>();
+    }
+    R result = f();
+    if (result.is_err_and(is_failure)) {
+      trip(now);
+    } else if (probe_successes_.fetch_add(1, std::memory_order_acq_rel) + 1 >=
+               policy_.probes) {
+      BreakerState expected = BreakerState::HalfOpen;
+      if (state_.compare_exchange_strong(expected, BreakerState::Closed,
+                                         std::memory_order_acq_rel))
+        clear_window();
+    }
+    probes_in_flight_.fetch_sub(1, std::memory_order_release);
+    return result;
+  }
+
+  const E open_error_;
+  const BreakerPolicy policy_;
+  // Buckets are 2^bucket_shift_ ns wide, so a call finds its slot with a
+  // shift and a mask instead of two divisions.
+  const unsigned bucket_shift_;
+  const unsigned nbuckets_;     // buckets covering the window
+  const std::size_t ring_mask_; // ring size (a power of two) - 1
+  const std::size_t stride_;    // words per stripe, a whole number of lines
+  std::unique_ptr<detail::BreakerLine[]> buckets_;
+  std::atomic<BreakerState> state_{BreakerState::Closed};
+  std::atomic<std::int64_t> opened_at_{0};
+  std::atomic<std::uint32_t> probes_in_flight_{0};
+  std::atomic<std::uint32_t> probe_successes_{0};
+  std::atomic<std::uint64_t> rejected_{0};
+};
+
+} // namespace cpp_result
@@ -0,0 +1,293 @@
+// codec.hpp - Versioned binary encoding of Result values
+// SPDX-License-Identifier: MIT
+//
+// Wire format (version 1), all integers in host byte order:
+//
+//   single : tag:u8 payload
+//            tag = (version << 4) | (0 = Ok, 1 = Err)
+//   batch  : (version << 4) | 0x8 : u8, count : varint,
+//            ok bitmap : ceil(count / 8) bytes (bit set = Ok, LSB first),
+//            payloads in order
+//
+// Payloads are written by Encoder<T>. Trivially copyable types are copied
+// with memcpy; std::string and std::string_view are a varint length
+// followed by the bytes. Decoding yields Encoder<T>::view_type, which for
+// strings is a std::string_view into the input buffer (no copy).
+//
+// --- API OVERVIEW ---
+//
+//   encode(writer, result), encode(result) -> std::vector<std::byte>
+//   decode<T, E>(reader)   -> Result<Result<view<T>, view<E>>, DecodeError>
+//   encode_batch(writer, results, n)
+//   decode_batch<T, E>(reader)
+//       -> Result<std::vector<Result<view<T>, view<E>>>, DecodeError>
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/byte_reader.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace cpp_result {
+
+/// Version written into every tag byte.
+constexpr std::uint8_t kCodecVersion = 1;
+
+/**
+ * @brief Appends encoded bytes to a growable buffer.
+ */
+class ByteWriter {
+public:
+  explicit ByteWriter(std::vector<std::byte> &out) noexcept : out_(out) {}
+
+  void write_bytes(const void *data, std::size_t n) {
+    const std::size_t at = out_.size();
+    out_.resize(at + n);
+    if (n)
+      std::memcpy(out_.data() + at, data, n);
+  }
+
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "ByteWriter::write<T> requires a trivially copyable T");
+    write_bytes(&value, sizeof(T));
+  }
+
+  void write_varint(std::uint64_t v) {
+    std::byte buf[detail::kMaxVarintBytes];
+    std::size_t n = 0;
+    while (v >= 0x80) {
+      buf[n++] = static_cast<std::byte>((v & 0x7f) | 0x80);
+      v >>= 7;
+    }
+    buf[n++] = static_cast<std::byte>(v);
+    write_bytes(buf, n);
+  }
+
+  void write_string(std::string_view s) {
+    write_varint(s.size());
+    write_bytes(s.data(), s.size());
+  }
+
+  std::size_t size() const noexcept { return out_.size(); }
+
+private:
+  std::vector<std::byte> &out_;
+};
+
+/**
+ * @brief Customization point describing how T is written and read back.
+ *
+ * The default for trivially copyable types copies the object
+ * representation, so it is only meaningful for types without pointers.
+ * Specialize for your own types:
+ * @code
+ * template <> struct cpp_result::Encoder<MyError> {
+ *   using view_type = MyErrorView;
+ *   static void encode(ByteWriter &w, const MyError &e);
+ *   static Result<MyErrorView, DecodeError> decode(ByteReader &r);
+ * };
+ * @endcode
+ */
+template <typename T, typename = void> struct Encoder;
+
+template <typename T>
+struct Encoder<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+  using view_type = T;
+  static void encode(ByteWriter &w, const T &value) { w.write(value); }
+  static Result<T, DecodeError> decode(ByteReader &r) noexcept {
+    return r.read<T>();
+  }
+};
+
+template <> struct Encoder<std::string> {
+  using view_type = std::string_view;
+  static void encode(ByteWriter &w, const std::string &value) {
+    w.write_string(value);
+  }
+  static Result<std::string_view, DecodeError> decode(ByteReader &r) noexcept {
+    return r.read_string_view();
+  }
+};
+
+template <> struct Encoder<std::string_view> : Encoder<std::string> {
+  static void encode(ByteWriter &w, std::string_view value) {
+    w.write_string(value);
+  }
+};
+
+namespace detail {
+
+constexpr std::uint8_t kTagErr = 0x1;
+constexpr std::uint8_t kTagBatch = 0x8;
+
+template <typename T> struct CodecView {
+  using type = typename Encoder<T>::view_type;
+};
+template <> struct CodecView<void> {
+  using type = void;
+};
+
+template <typename T, typename E> inline void encode_payload(ByteWriter &w,
+                                                             const Result<T, E> &r) {
+  if (r.is_err()) {
+    Encoder<E>::encode(w, r.unwrap_err());
+    return;
+  }
+  if constexpr (!std::is_void_v<T>)
+    Encoder<T>::encode(w, r.unwrap());
+}
+
+template <typename T, typename E, typename View>
+inline Result<View, DecodeError> decode_payload(ByteReader &r, bool ok) {
+  using Out = Result<View, DecodeError>;
+  if (!ok) {
+    auto err = Encoder<E>::decode(r);
+    if (err.is_err())
+      return Out::Err(err.unwrap_err());
+    return Out::Ok(View::Err(std::move(err.unwrap())));
+  }
+  if constexpr (std::is_void_v<T>) {
+    return Out::Ok(View::Ok());
+  } else {
+    auto value = Encoder<T>::decode(r);
+    if (value.is_err())
+      return Out::Err(value.unwrap_err());
+    return Out::Ok(View::Ok(std::move(value.unwrap())));
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Decoded form of Result<T, E>: payloads as Encoder view types.
+ */
+template <typename T, typename E>
+using ResultView = Result<typename detail::CodecView<T>::type,
+                          typename Encoder<E>::view_type>;
+
+/**
+ * @brief Appends one encoded Result to the writer.
+ * @code
+ * std::vector<std::byte> buf;
+ * cpp_result::ByteWriter w(buf);
+ * cpp_result::encode(w, Result<int, std::string>::Ok(42));
+ * @endcode
+ */
+template <typename T, typename E>
+inline void encode(ByteWriter &w, const Result<T, E> &r) {
+  w.write(static_cast<std::uint8_t>((kCodecVersion << 4) |
+                                    (r.is_err() ? detail::kTagErr : 0)));
+  detail::encode_payload(w, r);
+}
+
+/**
+ * @brief Encodes one Result into a new buffer.
+ */
+template <typename T, typename E>
+inline std::vector<std::byte> encode(const Result<T, E> &r) {
+  std::vector<std::byte> out;
+  ByteWriter w(out);
+  encode(w, r);
+  return out;
+}
+
+/**
+ * @brief Decodes one Result<T, E> written by encode().
+ *
+ * The outer Result reports malformed input; the inner one is the decoded
+ * value, whose string payloads point into the reader's buffer.
+ * @code
+ * cpp_result::ByteReader r(buf.data(), buf.size());
+ * auto decoded = cpp_result::decode<int, std::string>(r);
+ * // decoded.unwrap() is a Result<int, std::string_view>
+ * @endcode
+ */
+template <typename T, typename E>
+inline Result<ResultView<T, E>, DecodeError> decode(ByteReader &r) {
+  using Out = Result<ResultView<T, E>, DecodeError>;
+  const std::size_t at = r.position();
+  auto tag = r.read<std::uint8_t>();
+  if (tag.is_err())
+    return Out::Err(tag.unwrap_err());
+  const std::uint8_t t = tag.unwrap();
+  if ((t >> 4) != kCodecVersion || (t & 0x0e) != 0)
+    return Out::Err({DecodeError::Kind::InvalidTag, at});
+  return detail::decode_payload<T, E, ResultView<T, E>>(
+      r, (t & detail::kTagErr) == 0);
+}
+
+/**
+ * @brief Appends n Results as one batch: a shared header and a 1-bit tag
+ * per element instead of one byte each.
+ */
+template <typename T, typename E>
+inline void encode_batch(ByteWriter &w, const Result<T, E> *items,
+                         std::size_t n) {
+  w.write(static_cast<std::uint8_t>((kCodecVersion << 4) | detail::kTagBatch));
+  w.write_varint(n);
+  for (std::size_t base = 0; base < n; base += 8) {
+    std::uint8_t bits = 0;
+    for (std::size_t i = base; i < n && i < base + 8; ++i)
+      bits |= static_cast<std::uint8_t>(items[i].is_ok()) << (i - base);
+    w.write(bits);
+  }
+  for (std::size_t i = 0; i < n; ++i)
+    detail::encode_payload(w, items[i]);
+}
+
+template <typename T, typename E>
+inline void encode_batch(ByteWriter &w, const std::vector<Result<T, E>> &v) {
+  encode_batch(w, v.data(), v.size());
+}
+
+/**
+ * @brief Decodes a batch written by encode_batch().
+ */
+template <typename T, typename E>
+inline Result<std::vector<ResultView<T, E>>, DecodeError>
+decode_batch(ByteReader &r) {
+  using Out = Result<std::vector<ResultView<T, E>>, DecodeError>;
+  const std::size_t at = r.position();
+  auto tag = r.read<std::uint8_t>();
+  if (tag.is_err())
+    return Out::Err(tag.unwrap_err());
+  if (tag.unwrap() != ((kCodecVersion << 4) | detail::kTagBatch))
+    return Out::Err({DecodeError::Kind::InvalidTag, at});
+  auto count = r.read_varint();
+  if (count.is_err())
+    return Out::Err(count.unwrap_err());
+  const std::uint64_t n = count.unwrap();
+  // Checked before computing the bitmap size, which would wrap for counts
+  // near 2^64: n tags need n / 8 bytes that must already be in the input.
+  if (n / 8 + (n % 8 != 0) > r.remaining())
+    return Out::Err({DecodeError::Kind::UnexpectedEof, r.position()});
+  auto bitmap = r.read_bytes(static_cast<std::size_t>(n / 8 + (n % 8 != 0)));
+  if (bitmap.is_err())
+    return Out::Err(bitmap.unwrap_err());
+  // Cap the reservation by the input left so a corrupt count cannot force
+  // a huge allocation before the payload reads fail.
+  std::vector<ResultView<T, E>> out;
+  out.reserve(
+      static_cast<std::size_t>(std::min<std::uint64_t>(n, r.remaining())));
+  const ByteView bits = bitmap.unwrap();
+  for (std::uint64_t i = 0; i < n; ++i) {
+    const bool ok = (static_cast<unsigned>(bits[i / 8]) >> (i % 8)) & 1u;
+    auto item = detail::decode_payload<T, E, ResultView<T, E>>(r, ok);
+    if (item.is_err())
+      return Out::Err(item.unwrap_err());
+    out.push_back(std::move(item.unwrap()));
+  }
+  return Out::Ok(std::move(out));
+}
+
+} // namespace cpp_result
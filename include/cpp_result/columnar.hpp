@@ -0,0 +1,497 @@
+// columnar.hpp - Columnar file format for sequences of Result<T, E>
+// SPDX-License-Identifier: MIT
+//
+// A column file stores N results split by outcome, so scans touch only the
+// column they need:
+//
+//   header   magic, version, sizeof(T)                       (64 bytes)
+//   values   dense Ok values, T[ok_rows], in row order       (64-aligned)
+//   bitmap   u64[ceil(N / 64)], bit set = Ok
+//   ranks    u64 per 512-row block: Ok rows before the block
+//   err_rows u64[err_rows], row number of each error
+//   codes    u32[err_rows], dictionary code of each error
+//   dict     distinct errors, written with Encoder<E>
+//   footer   section offsets and counts, magic               (fixed size)
+//
+// Errors are expected to be sparse and repetitive: each one costs 12 bytes
+// plus one dictionary entry per distinct value. All integers are in host
+// byte order. The reader maps the file and serves every column in place.
+//
+// --- API OVERVIEW ---
+//
+//   ColumnarWriter<T, E>::create(path)  -> Result<ColumnarWriter, ColumnarError>
+//   writer.append(result), append_ok(value), append_err(error)
+//   writer.finish()                     -> Result<std::uint64_t, ColumnarError>
+//
+//   ColumnarReader<T, E>::open(path)    -> Result<ColumnarReader, ColumnarError>
+//   reader.at(row)                      -> Result<T, view<E>>
+//   reader.values(), ok_bitmap(), error_rows(), error_codes(), dictionary()
+//   reader.count_ok(first, last), count_errors_of(e), errors_of(e)
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/codec.hpp>
+#include <cpp_result/mapped_file.hpp>
+#include <cpp_result/posix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpp_result {
+
+/**
+ * @brief Error reported by the columnar writer and reader.
+ */
+struct ColumnarError {
+  enum class Kind : std::uint8_t {
+    Open,   ///< Creating or opening the file failed; see `error`.
+    Write,  ///< Writing the file failed; see `error`.
+    Map,    ///< Mapping the file failed; see `error`.
+    Format, ///< Not a column file of this T, or corrupt.
+  };
+
+  Kind kind;
+  Errno error{0};
+
+  bool operator==(const ColumnarError &other) const noexcept {
+    return kind == other.kind && error == other.error;
+  }
+  bool operator!=(const ColumnarError &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+namespace detail {
+
+constexpr std::uint64_t kColumnarMagic = 0x314c4f4352505043; // "CPPRCOL1"
+constexpr std::uint32_t kColumnarVersion = 1;
+constexpr std::size_t kColumnarHeaderSize = 64;
+constexpr std::size_t kRankBlockWords = 8; // 512 rows per rank entry.
+
+struct ColumnarFooter {
+  std::uint64_t rows;
+  std::uint64_t ok_rows;
+  std::uint64_t err_rows;
+  std::uint64_t values_offset;
+  std::uint64_t bitmap_offset;
+  std::uint64_t ranks_offset;
+  std::uint64_t err_rows_offset;
+  std::uint64_t codes_offset;
+  std::uint64_t dict_offset;
+  std::uint64_t dict_size;
+  std::uint32_t dict_entries;
+  std::uint32_t value_size;
+  std::uint32_t version;
+  std::uint32_t reserved;
+  std::uint64_t magic;
+};
+
+inline std::uint64_t popcount64(std::uint64_t w) noexcept {
+  return static_cast<std::uint64_t>(__builtin_popcountll(w));
+}
+
+} // namespace detail
+
+/**
+ * @brief Streams Results into a column file.
+ *
+ * Ok values go to disk through a write buffer as they are appended; the
+ * bitmap (1 bit per row) and the error columns stay in memory until
+ * finish(). A file that was never finished has no footer and is rejected
+ * by ColumnarReader. E is deduplicated through std::unordered_map, so it
+ * needs std::hash and operator==.
+ *
+ * @code
+ * auto w = cpp_result::ColumnarWriter<double, ErrorKind>::create("run.col");
+ * for (auto &item : batch)
+ *   TRY(w.unwrap().append(process(item)));
+ * auto rows = w.unwrap().finish();
+ * @endcode
+ */
+template <typename T, typename E> class ColumnarWriter {
+public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "column values must be trivially copyable");
+
+  static Result<ColumnarWriter, ColumnarError> create(const char *path) {
+    using R = Result<ColumnarWriter, ColumnarError>;
+    auto fd = posix::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                          0644);
+    if (fd.is_err())
+      return R::Err({ColumnarError::Kind::Open, fd.unwrap_err()});
+    ColumnarWriter writer(fd.unwrap());
+    std::byte header[detail::kColumnarHeaderSize] = {};
+    const std::uint32_t meta[2] = {detail::kColumnarVersion, sizeof(T)};
+    std::memcpy(header, &detail::kColumnarMagic, 8);
+    std::memcpy(header + 8, meta, sizeof(meta));
+    auto wrote = writer.write(header, sizeof(header));
+    if (wrote.is_err())
+      return R::Err(wrote.unwrap_err());
+    return R::Ok(std::move(writer));
+  }
+
+  ColumnarWriter(ColumnarWriter &&other) noexcept
+      : fd_(std::exchange(other.fd_, -1)), offset_(other.offset_),
+        rows_(other.rows_), buffer_(std::move(other.buffer_)),
+        bitmap_(std::move(other.bitmap_)),
+        err_rows_(std::move(other.err_rows_)),
+        codes_(std::move(other.codes_)), dict_(std::move(other.dict_)),
+        entries_(std::move(other.entries_)) {}
+  ColumnarWriter &operator=(ColumnarWriter &&) = delete;
+  ColumnarWriter(const ColumnarWriter &) = delete;
+  ColumnarWriter &operator=(const ColumnarWriter &) = delete;
+  ~ColumnarWriter() {
+    if (fd_ >= 0)
+      (void)posix::close(fd_);
+  }
+
+  Result<void, ColumnarError> append_ok(const T &value) {
+    mark(true);
+    const std::size_t at = buffer_.size();
+    buffer_.resize(at + sizeof(T));
+    std::memcpy(buffer_.data() + at, &value, sizeof(T));
+    if (buffer_.size() >= kBufferSize)
+      return flush();
+    return Result<void, ColumnarError>::Ok();
+  }
+
+  Result<void, ColumnarError> append_err(const E &error) {
+    mark(false);
+    err_rows_.push_back(rows_ - 1);
+    auto found = dict_.find(error);
+    if (found == dict_.end()) {
+      found = dict_.emplace(error, static_cast<std::uint32_t>(entries_.size()))
+                  .first;
+      entries_.push_back(&found->first);
+    }
+    codes_.push_back(found->second);
+    return Result<void, ColumnarError>::Ok();
+  }
+
+  Result<void, ColumnarError> append(const Result<T, E> &result) {
+    return result.is_ok() ? append_ok(result.unwrap())
+                          : append_err(result.unwrap_err());
+  }
+
+  std::uint64_t rows() const noexcept { return rows_; }
+
+  /**
+   * @brief Writes the remaining columns and the footer, and closes the
+   * file. Returns the number of rows written.
+   */
+  Result<std::uint64_t, ColumnarError> finish() {
+    using R = Result<std::uint64_t, ColumnarError>;
+    detail::ColumnarFooter footer{};
+    footer.rows = rows_;
+    footer.err_rows = err_rows_.size();
+    footer.ok_rows = rows_ - footer.err_rows;
+    footer.values_offset = detail::kColumnarHeaderSize;
+
+    std::vector<std::uint64_t> ranks;
+    std::uint64_t ok_before = 0;
+    for (std::size_t w = 0; w < bitmap_.size(); ++w) {
+      if (w % detail::kRankBlockWords == 0)
+        ranks.push_back(ok_before);
+      ok_before += detail::popcount64(bitmap_[w]);
+    }
+
+    std::vector<std::byte> dict;
+    ByteWriter dict_writer(dict);
+    for (const E *entry : entries_)
+      Encoder<E>::encode(dict_writer, *entry);
+
+    auto step = flush();
+    auto section = [&](std::uint64_t &offset, const void *data,
+                       std::size_t n) {
+      if (step.is_err())
+        return;
+      step = pad_to(8);
+      offset = offset_;
+      if (step.is_ok())
+        step = write(data, n);
+    };
+    section(footer.bitmap_offset, bitmap_.data(), bitmap_.size() * 8);
+    section(footer.ranks_offset, ranks.data(), ranks.size() * 8);
+    section(footer.err_rows_offset, err_rows_.data(), err_rows_.size() * 8);
+    section(footer.codes_offset, codes_.data(), codes_.size() * 4);
+    section(footer.dict_offset, dict.data(), dict.size());
+    footer.dict_size = dict.size();
+    footer.dict_entries = static_cast<std::uint32_t>(entries_.size());
+    footer.value_size = sizeof(T);
+    footer.version = detail::kColumnarVersion;
+    footer.magic = detail::kColumnarMagic;
+    std::uint64_t footer_offset = 0;
+    section(footer_offset, &footer, sizeof(footer));
+    if (step.is_err())
+      return R::Err(step.unwrap_err());
+
+    auto closed = posix::close(std::exchange(fd_, -1));
+    if (closed.is_err())
+      return R::Err({ColumnarError::Kind::Write, closed.unwrap_err()});
+    return R::Ok(rows_);
+  }
+
+private:
+  static constexpr std::size_t kBufferSize = std::size_t{1} << 20;
+
+  explicit ColumnarWriter(int fd) : fd_(fd) { buffer_.reserve(kBufferSize); }
+
+  void mark(bool ok) {
+    if (rows_ % 64 == 0)
+      bitmap_.push_back(0);
+    bitmap_.back() |= std::uint64_t{ok} << (rows_ % 64);
+    ++rows_;
+  }
+
+  Result<void, ColumnarError> write(const void *data, std::size_t n) {
+    auto wrote = posix::write_full(fd_, data, n);
+    if (wrote.is_err())
+      return Result<void, ColumnarError>::Err(
+          {ColumnarError::Kind::Write, wrote.unwrap_err()});
+    offset_ += n;
+    return Result<void, ColumnarError>::Ok();
+  }
+
+  Result<void, ColumnarError> flush() {
+    auto out = write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+    return out;
+  }
+
+  Result<void, ColumnarError> pad_to(std::size_t align) {
+    static const std::byte zeros[64] = {};
+    return write(zeros, (align - offset_ % align) % align);
+  }
+
+  int fd_ = -1;
+  std::uint64_t offset_ = 0;
+  std::uint64_t rows_ = 0;
+  std::vector<std::byte> buffer_;
+  std::vector<std::uint64_t> bitmap_;
+  std::vector<std::uint64_t> err_rows_;
+  std::vector<std::uint32_t> codes_;
+  std::unordered_map<E, std::uint32_t> dict_;
+  std::vector<const E *> entries_;
+};
+
+/**
+ * @brief Zero-copy reader of a column file.
+ *
+ * Columns are served straight from the mapping; only the dictionary is
+ * decoded at open (into Encoder<E>::view_type values that still point into
+ * the mapping). Scans over a column are plain loops over contiguous arrays
+ * that the compiler vectorizes.
+ *
+ * @code
+ * auto col = cpp_result::ColumnarReader<double, ErrorKind>::open("run.col");
+ * auto timeouts = col.unwrap().errors_of(ErrorKind::Timeout);
+ * @endcode
+ */
+template <typename T, typename E> class ColumnarReader {
+public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "column values must be trivially copyable");
+  using ErrorView = typename Encoder<E>::view_type;
+
+  static Result<ColumnarReader, ColumnarError> open(const char *path) {
+    using R = Result<ColumnarReader, ColumnarError>;
+    auto file = MappedFile::open(path, Advice::Normal);
+    if (file.is_err())
+      return R::Err({file.unwrap_err().op == IoError::Op::Open
+                         ? ColumnarError::Kind::Open
+                         : ColumnarError::Kind::Map,
+                     file.unwrap_err().error});
+    ColumnarReader reader(std::move(file.unwrap()));
+    if (!reader.load())
+      return R::Err({ColumnarError::Kind::Format});
+    return R::Ok(std::move(reader));
+  }
+
+  std::uint64_t rows() const noexcept { return footer_.rows; }
+  std::uint64_t ok_rows() const noexcept { return footer_.ok_rows; }
+  std::uint64_t err_rows() const noexcept { return footer_.err_rows; }
+
+  /// Dense Ok column: ok_rows() values in row order.
+  const T *values() const noexcept { return values_; }
+  /// ceil(rows() / 64) words; bit (row % 64) of word (row / 64) is set
+  /// when the row is Ok.
+  const std::uint64_t *ok_bitmap() const noexcept { return bitmap_; }
+  /// err_rows() row numbers, ascending.
+  const std::uint64_t *error_rows() const noexcept { return err_rows_; }
+  /// err_rows() dictionary codes, parallel to error_rows().
+  const std::uint32_t *error_codes() const noexcept { return codes_; }
+  const std::vector<ErrorView> &dictionary() const noexcept { return dict_; }
+
+  bool is_ok(std::uint64_t row) const noexcept {
+    return (bitmap_[row / 64] >> (row % 64)) & 1u;
+  }
+
+  /**
+   * @brief Returns the number of Ok rows before `row` (at most rows()), in
+   * O(1): one rank entry plus at most eight popcounts.
+   */
+  std::uint64_t rank(std::uint64_t row) const noexcept {
+    if (row >= footer_.rows)
+      return footer_.ok_rows;
+    const std::uint64_t word = row / 64;
+    std::uint64_t n = ranks_[word / detail::kRankBlockWords];
+    for (std::uint64_t w = word - word % detail::kRankBlockWords; w < word;
+         ++w)
+      n += detail::popcount64(bitmap_[w]);
+    if (row % 64)
+      n += detail::popcount64(bitmap_[word] << (64 - row % 64));
+    return n;
+  }
+
+  /**
+   * @brief Reassembles one row. `row` must be below rows().
+   */
+  Result<T, ErrorView> at(std::uint64_t row) const {
+    const std::uint64_t ok_before = rank(row);
+    if (is_ok(row)) {
+      T value;
+      std::memcpy(&value, values_ + ok_before, sizeof(T));
+      return Result<T, ErrorView>::Ok(value);
+    }
+    return Result<T, ErrorView>::Err(dict_[codes_[row - ok_before]]);
+  }
+
+  /**
+   * @brief Counts Ok rows in [first, last).
+   */
+  std::uint64_t count_ok(std::uint64_t first, std::uint64_t last) const
+      noexcept {
+    return first >= last ? 0 : rank(last) - rank(first);
+  }
+  std::uint64_t count_ok() const noexcept { return footer_.ok_rows; }
+
+  /**
+   * @brief Counts error rows equal to `error`.
+   */
+  template <typename U> std::uint64_t count_errors_of(const U &error) const {
+    const std::uint32_t code = find_code(error);
+    if (code == kNoCode)
+      return 0;
+    std::uint64_t n = 0;
+    for (std::uint64_t i = 0; i < footer_.err_rows; ++i)
+      n += codes_[i] == code;
+    return n;
+  }
+
+  /**
+   * @brief Returns the row numbers of error rows equal to `error`.
+   */
+  template <typename U>
+  std::vector<std::uint64_t> errors_of(const U &error) const {
+    std::vector<std::uint64_t> out;
+    const std::uint32_t code = find_code(error);
+    if (code == kNoCode)
+      return out;
+    for (std::uint64_t i = 0; i < footer_.err_rows; ++i)
+      if (codes_[i] == code)
+        out.push_back(err_rows_[i]);
+    return out;
+  }
+
+private:
+  static constexpr std::uint32_t kNoCode = 0xffffffffu;
+
+  explicit ColumnarReader(MappedFile file) : file_(std::move(file)) {}
+
+  template <typename U> std::uint32_t find_code(const U &error) const {
+    for (std::size_t i = 0; i < dict_.size(); ++i)
+      if (dict_[i] == error)
+        return static_cast<std::uint32_t>(i);
+    return kNoCode;
+  }
+
+  // Validates the footer, every section bound and the bitmap / rank table
+  // before exposing columns. O(rows / 64).
+  bool load() {
+    const std::byte *base = file_.data();
+    const std::uint64_t size = file_.size();
+    if (size < detail::kColumnarHeaderSize + sizeof(footer_))
+      return false;
+    std::uint64_t magic;
+    std::memcpy(&magic, base, 8);
+    std::memcpy(&footer_, base + size - sizeof(footer_), sizeof(footer_));
+    const auto &f = footer_;
+    if (magic != detail::kColumnarMagic || f.magic != detail::kColumnarMagic ||
+        f.version != detail::kColumnarVersion || f.value_size != sizeof(T) ||
+        f.ok_rows + f.err_rows != f.rows)
+      return false;
+
+    const std::uint64_t words = (f.rows + 63) / 64;
+    const std::uint64_t blocks =
+        (words + detail::kRankBlockWords - 1) / detail::kRankBlockWords;
+    const std::uint64_t end = size - sizeof(footer_);
+    auto fits = [&](std::uint64_t offset, std::uint64_t count,
+                    std::uint64_t width, std::uint64_t align) {
+      return offset % align == 0 && offset <= end &&
+             count <= (end - offset) / width;
+    };
+    if (!fits(f.values_offset, f.ok_rows, sizeof(T), alignof(T)) ||
+        !fits(f.bitmap_offset, words, 8, 8) ||
+        !fits(f.ranks_offset, blocks, 8, 8) ||
+        !fits(f.err_rows_offset, f.err_rows, 8, 8) ||
+        !fits(f.codes_offset, f.err_rows, 4, 4) ||
+        !fits(f.dict_offset, f.dict_size, 1, 1))
+      return false;
+
+    values_ = reinterpret_cast<const T *>(base + f.values_offset);
+    bitmap_ = reinterpret_cast<const std::uint64_t *>(base + f.bitmap_offset);
+    ranks_ = reinterpret_cast<const std::uint64_t *>(base + f.ranks_offset);
+    err_rows_ =
+        reinterpret_cast<const std::uint64_t *>(base + f.err_rows_offset);
+    codes_ = reinterpret_cast<const std::uint32_t *>(base + f.codes_offset);
+
+    // at() indexes the values and error columns by rank, so the bitmap
+    // and the rank table must agree with ok_rows: one pass over the
+    // bitmap, with no bits set past the last row.
+    std::uint64_t ok = 0;
+    for (std::uint64_t w = 0; w < words; ++w) {
+      if (w % detail::kRankBlockWords == 0 &&
+          ranks_[w / detail::kRankBlockWords] != ok)
+        return false;
+      ok += detail::popcount64(bitmap_[w]);
+    }
+    if (f.rows % 64 && (bitmap_[words - 1] >> (f.rows % 64)) != 0)
+      return false;
+    if (ok != f.ok_rows)
+      return false;
+
+    // Every entry takes at least one byte, which bounds a corrupt count.
+    ByteReader dict(base + f.dict_offset, f.dict_size);
+    dict_.reserve(static_cast<std::size_t>(
+        std::min<std::uint64_t>(f.dict_entries, f.dict_size)));
+    for (std::uint32_t i = 0; i < f.dict_entries; ++i) {
+      auto entry = Encoder<E>::decode(dict);
+      if (entry.is_err())
+        return false;
+      dict_.push_back(std::move(entry.unwrap()));
+    }
+    for (std::uint64_t i = 0; i < f.err_rows; ++i)
+      if (codes_[i] >= f.dict_entries || err_rows_[i] >= f.rows)
+        return false;
+    return true;
+  }
+
+  MappedFile file_;
+  detail::ColumnarFooter footer_{};
+  const T *values_ = nullptr;
+  const std::uint64_t *bitmap_ = nullptr;
+  const std::uint64_t *ranks_ = nullptr;
+  const std::uint64_t *err_rows_ = nullptr;
+  const std::uint32_t *codes_ = nullptr;
+  std::vector<ErrorView> dict_;
+};
+
+} // namespace cpp_result
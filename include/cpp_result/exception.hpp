@@ -0,0 +1,200 @@
+// exception.hpp - Adapters between exceptions and Result
+// SPDX-License-Identifier: MIT
+//
+// catch_as_result<E>(f, handlers...) calls a throwing function and turns
+// the exceptions its handlers name into Err(E). Each handler is a callable
+// taking the exception type it handles (by reference) and returning the
+// error; a handler taking no argument catches everything else. The
+// handlers become an ordinary chain of nested catch clauses, checked in
+// the order given, so:
+//   - nothing runs on the non-throwing path (table-based unwinding), and
+//     the result is built exactly as a hand-written try/catch would;
+//   - a caught exception is handled in place, with no std::exception_ptr
+//     and no rethrow;
+//   - exceptions no handler names propagate unchanged.
+//
+// result_or_throw(r) goes the other way at API boundaries that must
+// throw: it returns the value or throws the error (an E derived from
+// std::exception as itself, anything else wrapped in BadResultAccess<E>).
+// The throw lives in a separate cold function so the Ok path is a test
+// and a move.
+//
+// --- API OVERVIEW ---
+//
+//   catch_as_result<E>(f, [](const Ex &) -> E {...}, ..., [] -> E {...})
+//                                    -> Result<invoke_result_t<F>, E>
+//   result_or_throw(result)          -> T, or throws
+//   result_or_throw(result, to_exc)  -> T, or throws to_exc(error)
+//   BadResultAccess<E>               thrown for errors that are not
+//                                    exceptions; error()
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Keeps the throwing code out of line and out of the hot path.
+#if defined(__GNUC__) || defined(__clang__)
+#define CPP_RESULT_COLD_FN __attribute__((noinline, cold))
+#else
+#define CPP_RESULT_COLD_FN
+#endif
+
+namespace cpp_result {
+
+/**
+ * @brief Thrown by result_or_throw() for an error type that is not an
+ * exception.
+ */
+template <typename E> class BadResultAccess : public std::exception {
+public:
+  explicit BadResultAccess(E error) : error_(std::move(error)) {}
+
+  const char *what() const noexcept override { return "bad Result access"; }
+  const E &error() const noexcept { return error_; }
+
+private:
+  E error_;
+};
+
+namespace detail {
+
+// Parameter type of a handler: its single argument, or void for a
+// catch-all handler taking none.
+template <typename Sig> struct handler_sig;
+template <typename Ret> struct handler_sig<Ret()> { using arg = void; };
+template <typename Ret, typename Arg> struct handler_sig<Ret(Arg)> {
+  using arg = Arg;
+};
+
+template <typename M> struct member_sig;
+template <typename C, typename Ret, typename... A>
+struct member_sig<Ret (C::*)(A...) const> : handler_sig<Ret(A...)> {};
+template <typename C, typename Ret, typename... A>
+struct member_sig<Ret (C::*)(A...)> : handler_sig<Ret(A...)> {};
+
+template <typename H>
+struct handler_arg : member_sig<decltype(&H::operator())> {};
+template <typename Ret, typename... A>
+struct handler_arg<Ret (*)(A...)> : handler_sig<Ret(A...)> {};
+
+template <typename H>
+using handler_arg_t = typename handler_arg<std::decay_t<H>>::arg;
+
+template <typename R, typename F> R call_as_ok(F &f) {
+  if constexpr (std::is_void_v<std::invoke_result_t<F &>>) {
+    f();
+    return R::Ok();
+  } else {
+    return R::Ok(f());
+  }
+}
+
+// Nests one try block per handler: handler 0 is innermost, so it is
+// matched first, as in a written catch list.
+template <std::size_t I, typename R, typename F, typename Hs>
+R catch_chain(F &f, Hs &handlers) {
+  if constexpr (I == 0) {
+    return call_as_ok<R>(f);
+  } else {
+    auto &handler = std::get<I - 1>(handlers);
+    using Arg = handler_arg_t<decltype(handler)>;
+    if constexpr (std::is_void_v<Arg>) {
+      try {
+        return catch_chain<I - 1, R>(f, handlers);
+      } catch (...) {
+        return R::Err(handler());
+      }
+    } else {
+      static_assert(std::is_reference_v<Arg>,
+                    "catch_as_result handlers take the exception by reference");
+      try {
+        return catch_chain<I - 1, R>(f, handlers);
+      } catch (Arg e) {
+        return R::Err(handler(e));
+      }
+    }
+  }
+}
+
+template <typename E> [[noreturn]] void throw_error(E &&error) {
+  using D = std::decay_t<E>;
+  if constexpr (std::is_base_of_v<std::exception, D>)
+    throw D(std::forward<E>(error));
+  else
+    throw BadResultAccess<D>(std::forward<E>(error));
+}
+
+template <typename E> [[noreturn]] CPP_RESULT_COLD_FN void throw_cold(E &&e) {
+  throw_error(std::forward<E>(e));
+}
+
+template <typename E, typename ToExc>
+[[noreturn]] CPP_RESULT_COLD_FN void throw_cold(E &&e, ToExc &to_exc) {
+  throw to_exc(std::forward<E>(e));
+}
+
+} // namespace detail
+
+/**
+ * @brief Calls f and returns its value as Ok, or the error a handler
+ * makes from the exception f threw.
+ * @code
+ * auto n = cpp_result::catch_as_result<ParseError>(
+ *     [&] { return std::stoi(text); },
+ *     [](const std::out_of_range &) { return ParseError::Overflow; },
+ *     [](const std::invalid_argument &) { return ParseError::NotANumber; });
+ * @endcode
+ */
+template <typename E, typename F, typename... Handlers>
+auto catch_as_result(F &&f, Handlers &&...handlers)
+    -> Result<std::invoke_result_t<F &>, E> {
+  using R = Result<std::invoke_result_t<F &>, E>;
+  std::tuple<Handlers &...> hs(handlers...);
+  return detail::catch_chain<sizeof...(Handlers), R>(f, hs);
+}
+
+/**
+ * @brief The Ok value, or throws the error: as itself when E derives from
+ * std::exception, else as BadResultAccess<E>.
+ * @code
+ * Config load_or_throw(const std::string &path) {
+ *   return cpp_result::result_or_throw(load(path));
+ * }
+ * @endcode
+ */
+template <typename T, typename E> T result_or_throw(Result<T, E> &&r) {
+  if (r.is_err())
+    detail::throw_cold(std::move(r.unwrap_err()));
+  if constexpr (!std::is_void_v<T>)
+    return std::move(r.unwrap());
+}
+
+template <typename T, typename E> T result_or_throw(const Result<T, E> &r) {
+  if (r.is_err())
+    detail::throw_cold(r.unwrap_err());
+  if constexpr (!std::is_void_v<T>)
+    return r.unwrap();
+}
+
+/**
+ * @brief The Ok value, or throws to_exc(error).
+ * @code
+ * auto fd = cpp_result::result_or_throw(posix::open(path, O_RDONLY),
+ *     [](Errno e) { return std::system_error(e.code, std::generic_category()); });
+ * @endcode
+ */
+template <typename T, typename E, typename ToExc>
+T result_or_throw(Result<T, E> &&r, ToExc &&to_exc) {
+  if (r.is_err())
+    detail::throw_cold(std::move(r.unwrap_err()), to_exc);
+  if constexpr (!std::is_void_v<T>)
+    return std::move(r.unwrap());
+}
+
+} // namespace cpp_result
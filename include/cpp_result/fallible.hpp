@@ -0,0 +1,677 @@
+// fallible.hpp - Containers whose allocations return Result
+// SPDX-License-Identifier: MIT
+//
+// For code built without exceptions, where std::bad_alloc ends the
+// process. TryVector, TryString and TryHashMap allocate only through their
+// try_* members, which report failure as Result<..., AllocError> and leave
+// the container unchanged; nothing here throws. try_make_unique() and
+// try_make_shared() do the same for single objects.
+//
+// Element types are expected not to throw either; moving them must be
+// noexcept so that growing a container cannot fail halfway.
+//
+// --- API OVERVIEW ---
+//
+//   TryVector<T>        try_reserve(n), try_push_back(v), try_emplace_back(a...),
+//                       try_resize(n), try_clone(), pop_back(), clear(), [i]
+//   TryString           try_reserve(n), try_append(sv), try_push_back(c),
+//                       view(), c_str(), try_clone()
+//   TryHashMap<K, V>    try_reserve(n), try_emplace(k, a...), find(k),
+//                       erase(k), for_each(f)
+//   try_make_unique<T>(args...) -> Result<std::unique_ptr<T>, AllocError>
+//   try_make_shared<T>(args...) -> Result<std::shared_ptr<T>, AllocError>
+//   AllocError{kind, bytes}
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/**
+ * @brief Why a fallible allocation did not happen.
+ */
+struct AllocError {
+  enum class Kind : std::uint8_t {
+    OutOfMemory,      ///< The allocator returned null.
+    CapacityOverflow, ///< The requested size does not fit in size_t.
+  };
+
+  Kind kind;
+  std::size_t bytes = 0; ///< Size of the failed request, if representable.
+
+  bool operator==(const AllocError &other) const noexcept {
+    return kind == other.kind && bytes == other.bytes;
+  }
+  bool operator!=(const AllocError &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+namespace detail {
+
+template <typename T>
+Result<T *, AllocError> try_allocate(std::size_t n) noexcept {
+  using R = Result<T *, AllocError>;
+  if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+    return R::Err({AllocError::Kind::CapacityOverflow, 0});
+  const std::size_t bytes = n * sizeof(T);
+  void *p;
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    p = ::operator new(bytes, std::align_val_t(alignof(T)), std::nothrow);
+  else
+    p = ::operator new(bytes, std::nothrow);
+  if (!p)
+    return R::Err({AllocError::Kind::OutOfMemory, bytes});
+  return R::Ok(static_cast<T *>(p));
+}
+
+template <typename T> void deallocate(T *p) noexcept {
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    ::operator delete(static_cast<void *>(p), std::align_val_t(alignof(T)));
+  else
+    ::operator delete(static_cast<void *>(p));
+}
+
+// Next capacity for at least `need` elements: doubling, checked.
+inline Result<std::size_t, AllocError> grow_capacity(std::size_t cap,
+                                                     std::size_t need,
+                                                     std::size_t max) noexcept {
+  using R = Result<std::size_t, AllocError>;
+  if (need > max)
+    return R::Err({AllocError::Kind::CapacityOverflow, 0});
+  const std::size_t doubled = cap > max / 2 ? max : cap * 2;
+  return R::Ok(need > doubled ? need : doubled);
+}
+
+} // namespace detail
+
+/**
+ * @brief Contiguous growable array whose allocations return Result.
+ *
+ * Not copyable (a copy could fail): use try_clone().
+ * @code
+ * cpp_result::TryVector<Row> rows;
+ * TRY(rows.try_reserve(request.count()).map_err(to_status));
+ * for (const auto &r : request.rows())
+ *   TRY(rows.try_push_back(r).map_err(to_status));
+ * @endcode
+ */
+template <typename T> class TryVector {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "TryVector requires a noexcept move constructor");
+
+public:
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  TryVector() noexcept = default;
+  TryVector(TryVector &&other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+  TryVector &operator=(TryVector &&other) noexcept {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+  TryVector(const TryVector &) = delete;
+  TryVector &operator=(const TryVector &) = delete;
+  ~TryVector() { release(); }
+
+  static constexpr std::size_t max_size() noexcept {
+    return std::numeric_limits<std::size_t>::max() / sizeof(T);
+  }
+
+  /**
+   * @brief Ensures room for n elements in total.
+   */
+  Result<void, AllocError> try_reserve(std::size_t n) noexcept {
+    if (n <= capacity_)
+      return Result<void, AllocError>::Ok();
+    if (n > max_size())
+      return Result<void, AllocError>::Err(
+          {AllocError::Kind::CapacityOverflow, 0});
+    return reallocate(n);
+  }
+
+  Result<void, AllocError> try_push_back(const T &value) noexcept {
+    auto placed = try_emplace_back(value);
+    if (placed.is_err())
+      return Result<void, AllocError>::Err(placed.unwrap_err());
+    return Result<void, AllocError>::Ok();
+  }
+  Result<void, AllocError> try_push_back(T &&value) noexcept {
+    auto placed = try_emplace_back(std::move(value));
+    if (placed.is_err())
+      return Result<void, AllocError>::Err(placed.unwrap_err());
+    return Result<void, AllocError>::Ok();
+  }
+
+  /**
+   * @brief Constructs an element at the end; returns a pointer to it.
+   */
+  template <typename... Args>
+  Result<T *, AllocError> try_emplace_back(Args &&...args) noexcept {
+    if (size_ == capacity_)
+      return grow_emplace_back(std::forward<Args>(args)...);
+    T *slot = ::new (static_cast<void *>(data_ + size_))
+        T(std::forward<Args>(args)...);
+    ++size_;
+    return Result<T *, AllocError>::Ok(slot);
+  }
+
+  /**
+   * @brief Grows with value-initialized elements or shrinks to n.
+   */
+  Result<void, AllocError> try_resize(std::size_t n) noexcept {
+    if (n > capacity_) {
+      auto reserved = try_reserve(n);
+      if (reserved.is_err())
+        return reserved;
+    }
+    while (size_ > n)
+      data_[--size_].~T();
+    if constexpr (std::is_trivial_v<T>) {
+      if (n > size_)
+        std::memset(static_cast<void *>(data_ + size_), 0,
+                    (n - size_) * sizeof(T));
+      size_ = n;
+    } else {
+      for (; size_ < n; ++size_)
+        ::new (static_cast<void *>(data_ + size_)) T();
+    }
+    return Result<void, AllocError>::Ok();
+  }
+
+  Result<TryVector, AllocError> try_clone() const noexcept {
+    TryVector copy;
+    auto reserved = copy.try_reserve(size_);
+    if (reserved.is_err())
+      return Result<TryVector, AllocError>::Err(reserved.unwrap_err());
+    for (const T &v : *this)
+      ::new (static_cast<void *>(copy.data_ + copy.size_++)) T(v);
+    return Result<TryVector, AllocError>::Ok(std::move(copy));
+  }
+
+  void pop_back() noexcept { data_[--size_].~T(); }
+  void clear() noexcept {
+    while (size_)
+      data_[--size_].~T();
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+  T *data() noexcept { return data_; }
+  const T *data() const noexcept { return data_; }
+  T &operator[](std::size_t i) noexcept { return data_[i]; }
+  const T &operator[](std::size_t i) const noexcept { return data_[i]; }
+  T &back() noexcept { return data_[size_ - 1]; }
+  const T &back() const noexcept { return data_[size_ - 1]; }
+  iterator begin() noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+private:
+  // Builds the new element in the new buffer before the old elements move
+  // out, as std::vector does, so arguments referring into this vector are
+  // read while they are still alive.
+  template <typename... Args>
+  Result<T *, AllocError> grow_emplace_back(Args &&...args) noexcept {
+    auto cap = detail::grow_capacity(capacity_ ? capacity_ : 4, size_ + 1,
+                                     max_size());
+    if (cap.is_err())
+      return Result<T *, AllocError>::Err(cap.unwrap_err());
+    auto fresh = detail::try_allocate<T>(cap.unwrap());
+    if (fresh.is_err())
+      return Result<T *, AllocError>::Err(fresh.unwrap_err());
+    T *slot = ::new (static_cast<void *>(fresh.unwrap() + size_))
+        T(std::forward<Args>(args)...);
+    adopt(fresh.unwrap(), cap.unwrap());
+    ++size_;
+    return Result<T *, AllocError>::Ok(slot);
+  }
+
+  Result<void, AllocError> reallocate(std::size_t n) noexcept {
+    auto fresh = detail::try_allocate<T>(n);
+    if (fresh.is_err())
+      return Result<void, AllocError>::Err(fresh.unwrap_err());
+    adopt(fresh.unwrap(), n);
+    return Result<void, AllocError>::Ok();
+  }
+
+  // Moves the elements into p, of capacity n, and frees the old buffer.
+  void adopt(T *p, std::size_t n) noexcept {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (size_)
+        std::memcpy(static_cast<void *>(p), data_, size_ * sizeof(T));
+    } else {
+      for (std::size_t i = 0; i < size_; ++i) {
+        ::new (static_cast<void *>(p + i)) T(std::move(data_[i]));
+        data_[i].~T();
+      }
+    }
+    if (data_)
+      detail::deallocate(data_);
+    data_ = p;
+    capacity_ = n;
+  }
+
+  void release() noexcept {
+    clear();
+    if (data_)
+      detail::deallocate(std::exchange(data_, nullptr));
+    capacity_ = 0;
+  }
+
+  T *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+};
+
+/**
+ * @brief NUL-terminated byte string whose allocations return Result.
+ */
+class TryString {
+public:
+  TryString() noexcept = default;
+
+  Result<void, AllocError> try_reserve(std::size_t n) noexcept {
+    if (n == std::numeric_limits<std::size_t>::max())
+      return Result<void, AllocError>::Err(
+          {AllocError::Kind::CapacityOverflow, 0});
+    return bytes_.try_reserve(n + 1);
+  }
+
+  Result<void, AllocError> try_append(std::string_view s) noexcept {
+    const std::size_t n = size();
+    if (s.size() > TryVector<char>::max_size() - n - 1)
+      return Result<void, AllocError>::Err(
+          {AllocError::Kind::CapacityOverflow, 0});
+    const std::size_t len = n + s.size() + 1;
+    if (len > bytes_.capacity()) {
+      // s may point into this string: copy it into the new buffer before
+      // the old one is freed.
+      auto grown = grow(len);
+      if (grown.is_err())
+        return Result<void, AllocError>::Err(grown.unwrap_err());
+      TryVector<char> &fresh = grown.unwrap();
+      if (!s.empty())
+        std::memcpy(fresh.data() + n, s.data(), s.size());
+      fresh[len - 1] = '\0';
+      bytes_ = std::move(fresh);
+      return Result<void, AllocError>::Ok();
+    }
+    // Capacity is in place: this cannot fail.
+    (void)bytes_.try_resize(len);
+    if (!s.empty())
+      std::memcpy(bytes_.data() + n, s.data(), s.size());
+    bytes_[len - 1] = '\0';
+    return Result<void, AllocError>::Ok();
+  }
+
+  Result<void, AllocError> try_push_back(char c) noexcept {
+    return try_append(std::string_view(&c, 1));
+  }
+
+  Result<TryString, AllocError> try_clone() const noexcept {
+    TryString copy;
+    auto appended = copy.try_append(view());
+    if (appended.is_err())
+      return Result<TryString, AllocError>::Err(appended.unwrap_err());
+    return Result<TryString, AllocError>::Ok(std::move(copy));
+  }
+
+  void clear() noexcept { bytes_.clear(); }
+
+  std::size_t size() const noexcept {
+    return bytes_.empty() ? 0 : bytes_.size() - 1;
+  }
+  std::size_t capacity() const noexcept {
+    return bytes_.capacity() ? bytes_.capacity() - 1 : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+  std::string_view view() const noexcept {
+    return std::string_view(bytes_.data(), size());
+  }
+  const char *c_str() const noexcept { return bytes_.empty() ? "" : bytes_.data(); }
+  char &operator[](std::size_t i) noexcept { return bytes_[i]; }
+  char operator[](std::size_t i) const noexcept { return bytes_[i]; }
+
+private:
+  // A buffer of at least `need` bytes holding the current contents (without
+  // the terminator), sized to `need`.
+  Result<TryVector<char>, AllocError> grow(std::size_t need) const noexcept {
+    using R = Result<TryVector<char>, AllocError>;
+    auto cap = detail::grow_capacity(bytes_.capacity() ? bytes_.capacity() : 16,
+                                     need, TryVector<char>::max_size());
+    if (cap.is_err())
+      return R::Err(cap.unwrap_err());
+    TryVector<char> fresh;
+    auto reserved = fresh.try_reserve(cap.unwrap());
+    if (reserved.is_err())
+      return R::Err(reserved.unwrap_err());
+    (void)fresh.try_resize(need);
+    if (size())
+      std::memcpy(fresh.data(), bytes_.data(), size());
+    return R::Ok(std::move(fresh));
+  }
+
+  TryVector<char> bytes_; // includes the terminator once non-empty
+};
+
+/**
+ * @brief Open-addressing hash map whose allocations return Result.
+ *
+ * Linear probing over a power-of-two table, at most 7/8 full counting
+ * erased slots. Pointers to values stay valid until the next growing
+ * try_emplace or try_reserve.
+ * @code
+ * cpp_result::TryHashMap<std::uint64_t, Session> sessions;
+ * auto slot = sessions.try_emplace(id, peer);
+ * if (slot.is_err())
+ *   return reject(Status::Overloaded);
+ * auto [session, inserted] = slot.unwrap();
+ * @endcode
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename Eq = std::equal_to<K>>
+class TryHashMap {
+  static_assert(std::is_nothrow_move_constructible_v<K> &&
+                    std::is_nothrow_move_constructible_v<V>,
+                "TryHashMap requires noexcept move constructors");
+
+public:
+  TryHashMap() noexcept = default;
+  TryHashMap(TryHashMap &&other) noexcept
+      : ctrl_(std::exchange(other.ctrl_, nullptr)),
+        slots_(std::exchange(other.slots_, nullptr)),
+        mask_(std::exchange(other.mask_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        used_(std::exchange(other.used_, 0)) {}
+  TryHashMap &operator=(TryHashMap &&other) noexcept {
+    if (this != &other) {
+      release();
+      ctrl_ = std::exchange(other.ctrl_, nullptr);
+      slots_ = std::exchange(other.slots_, nullptr);
+      mask_ = std::exchange(other.mask_, 0);
+      size_ = std::exchange(other.size_, 0);
+      used_ = std::exchange(other.used_, 0);
+    }
+    return *this;
+  }
+  TryHashMap(const TryHashMap &) = delete;
+  TryHashMap &operator=(const TryHashMap &) = delete;
+  ~TryHashMap() { release(); }
+
+  /**
+   * @brief Ensures n entries fit without growing.
+   */
+  Result<void, AllocError> try_reserve(std::size_t n) noexcept {
+    if (n > std::numeric_limits<std::size_t>::max() / 8)
+      return Result<void, AllocError>::Err(
+          {AllocError::Kind::CapacityOverflow, 0});
+    std::size_t cap = 8;
+    while (cap - cap / 8 < n)
+      cap *= 2;
+    if (slots_ && cap <= mask_ + 1)
+      return Result<void, AllocError>::Ok();
+    return rehash(cap);
+  }
+
+  /**
+   * @brief Inserts V(args...) under key unless present. Returns the value
+   * and whether it was inserted.
+   */
+  template <typename... Args>
+  Result<std::pair<V *, bool>, AllocError> try_emplace(const K &key,
+                                                       Args &&...args) noexcept {
+    using R = Result<std::pair<V *, bool>, AllocError>;
+    if (V *found = find(key))
+      return R::Ok({found, false});
+    if (!slots_ || used_ + 1 > (mask_ + 1) - (mask_ + 1) / 8) {
+      // key and args may point into this map: build the entry before the
+      // rehash moves and frees the old slots.
+      Slot entry{key, V(std::forward<Args>(args)...)};
+      // Full of erased slots: rehash at the same size; otherwise double.
+      std::size_t cap = 8;
+      if (slots_)
+        cap = size_ < (mask_ + 1) / 2 ? mask_ + 1 : (mask_ + 1) * 2;
+      auto grown = rehash(cap);
+      if (grown.is_err())
+        return R::Err(grown.unwrap_err());
+      return R::Ok({insert_absent(entry.key, std::move(entry)), true});
+    }
+    return R::Ok(
+        {insert_absent(key, key, V(std::forward<Args>(args)...)), true});
+  }
+
+  V *find(const K &key) noexcept {
+    const std::size_t i = slot_of(key);
+    return i == kNone ? nullptr : &slots_[i].value;
+  }
+  const V *find(const K &key) const noexcept {
+    const std::size_t i = slot_of(key);
+    return i == kNone ? nullptr : &slots_[i].value;
+  }
+
+  bool erase(const K &key) noexcept {
+    const std::size_t i = slot_of(key);
+    if (i == kNone)
+      return false;
+    slots_[i].~Slot();
+    ctrl_[i] = kErased;
+    --size_;
+    return true;
+  }
+
+  /// Calls f(key, value) for every entry, in table order.
+  template <typename F> void for_each(F &&f) const {
+    for (std::size_t i = 0; slots_ && i <= mask_; ++i)
+      if (ctrl_[i] == kFull)
+        f(slots_[i].key, slots_[i].value);
+  }
+
+  void clear() noexcept {
+    for (std::size_t i = 0; slots_ && i <= mask_; ++i) {
+      if (ctrl_[i] == kFull)
+        slots_[i].~Slot();
+      ctrl_[i] = kEmpty;
+    }
+    size_ = used_ = 0;
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+private:
+  static constexpr std::uint8_t kEmpty = 0;
+  static constexpr std::uint8_t kFull = 1;
+  static constexpr std::uint8_t kErased = 2;
+  static constexpr std::size_t kNone = ~std::size_t{0};
+
+  struct Slot {
+    K key;
+    V value;
+  };
+
+  std::size_t index_of(const K &key) const noexcept {
+    // Multiply-shift, so identity hashes of small integers still spread.
+    return static_cast<std::size_t>(
+               (static_cast<std::uint64_t>(Hash{}(key)) *
+                0x9e3779b97f4a7c15ull) >>
+               32) &
+           mask_;
+  }
+
+  // Builds Slot{slot_args...} in a free slot for a key known to be absent.
+  template <typename... A>
+  V *insert_absent(const K &key, A &&...slot_args) noexcept {
+    std::size_t i = index_of(key);
+    while (ctrl_[i] == kFull)
+      i = (i + 1) & mask_;
+    if (ctrl_[i] == kEmpty)
+      ++used_;
+    ctrl_[i] = kFull;
+    ::new (static_cast<void *>(&slots_[i])) Slot{std::forward<A>(slot_args)...};
+    ++size_;
+    return &slots_[i].value;
+  }
+
+  std::size_t slot_of(const K &key) const noexcept {
+    if (!slots_)
+      return kNone;
+    for (std::size_t i = index_of(key);; i = (i + 1) & mask_) {
+      if (ctrl_[i] == kEmpty)
+        return kNone;
+      if (ctrl_[i] == kFull && Eq{}(slots_[i].key, key))
+        return i;
+    }
+  }
+
+  Result<void, AllocError> rehash(std::size_t cap) noexcept {
+    auto ctrl = detail::try_allocate<std::uint8_t>(cap);
+    if (ctrl.is_err())
+      return Result<void, AllocError>::Err(ctrl.unwrap_err());
+    auto slots = detail::try_allocate<Slot>(cap);
+    if (slots.is_err()) {
+      detail::deallocate(ctrl.unwrap());
+      return Result<void, AllocError>::Err(slots.unwrap_err());
+    }
+    std::uint8_t *old_ctrl = std::exchange(ctrl_, ctrl.unwrap());
+    Slot *old_slots = std::exchange(slots_, slots.unwrap());
+    const std::size_t old_cap = old_slots ? mask_ + 1 : 0;
+    std::memset(ctrl_, kEmpty, cap);
+    mask_ = cap - 1;
+    used_ = size_;
+    for (std::size_t j = 0; j < old_cap; ++j) {
+      if (old_ctrl[j] != kFull)
+        continue;
+      std::size_t i = index_of(old_slots[j].key);
+      while (ctrl_[i] != kEmpty)
+        i = (i + 1) & mask_;
+      ctrl_[i] = kFull;
+      ::new (static_cast<void *>(&slots_[i])) Slot{std::move(old_slots[j])};
+      old_slots[j].~Slot();
+    }
+    if (old_slots) {
+      detail::deallocate(old_ctrl);
+      detail::deallocate(old_slots);
+    }
+    return Result<void, AllocError>::Ok();
+  }
+
+  void release() noexcept {
+    if (!slots_)
+      return;
+    clear();
+    detail::deallocate(std::exchange(ctrl_, nullptr));
+    detail::deallocate(std::exchange(slots_, nullptr));
+    mask_ = 0;
+  }
+
+  std::uint8_t *ctrl_ = nullptr;
+  Slot *slots_ = nullptr;
+  std::size_t mask_ = 0;
+  std::size_t size_ = 0; // live entries
+  std::size_t used_ = 0; // live + erased slots
+};
+
+/**
+ * @brief new T(args...) without throwing on allocation failure.
+ */
+template <typename T, typename... Args>
+Result<std::unique_ptr<T>, AllocError> try_make_unique(Args &&...args) noexcept {
+  using R = Result<std::unique_ptr<T>, AllocError>;
+  T *p = new (std::nothrow) T(std::forward<Args>(args)...);
+  if (!p)
+    return R::Err({AllocError::Kind::OutOfMemory, sizeof(T)});
+  return R::Ok(std::unique_ptr<T>(p));
+}
+
+namespace detail {
+
+// Hands allocate_shared a block reserved beforehand, so its single
+// allocation cannot fail. The static_assert proves at compile time that
+// the control block with T inside fits.
+template <typename T> struct SharedBlock {
+  static constexpr std::size_t kSize = sizeof(T) + 64;
+  struct alignas(alignof(std::max_align_t) > alignof(T)
+                     ? alignof(std::max_align_t)
+                     : alignof(T)) Storage {
+    unsigned char bytes[kSize];
+  };
+};
+
+template <typename U, typename T> struct SharedBlockAllocator {
+  using value_type = U;
+
+  explicit SharedBlockAllocator(void *block) noexcept : block(block) {}
+  template <typename V>
+  SharedBlockAllocator(const SharedBlockAllocator<V, T> &other) noexcept
+      : block(other.block) {}
+
+  U *allocate(std::size_t n) noexcept {
+    static_assert(sizeof(U) <= SharedBlock<T>::kSize &&
+                      alignof(U) <= alignof(typename SharedBlock<T>::Storage),
+                  "shared_ptr control block larger than expected");
+    (void)n; // allocate_shared asks for exactly one control block
+    return static_cast<U *>(block);
+  }
+  void deallocate(U *p, std::size_t) noexcept {
+    detail::deallocate(
+        reinterpret_cast<typename SharedBlock<T>::Storage *>(p));
+  }
+
+  template <typename V> struct rebind {
+    using other = SharedBlockAllocator<V, T>;
+  };
+  template <typename V>
+  bool operator==(const SharedBlockAllocator<V, T> &other) const noexcept {
+    return block == other.block;
+  }
+  template <typename V>
+  bool operator!=(const SharedBlockAllocator<V, T> &other) const noexcept {
+    return block != other.block;
+  }
+
+  void *block;
+};
+
+} // namespace detail
+
+/**
+ * @brief std::make_shared<T>(args...) without throwing on allocation
+ * failure; T and its reference counts share one allocation.
+ */
+template <typename T, typename... Args>
+Result<std::shared_ptr<T>, AllocError>
+try_make_shared(Args &&...args) noexcept {
+  using R = Result<std::shared_ptr<T>, AllocError>;
+  auto block = detail::try_allocate<typename detail::SharedBlock<T>::Storage>(1);
+  if (block.is_err())
+    return R::Err(block.unwrap_err());
+  return R::Ok(std::allocate_shared<T>(
+      detail::SharedBlockAllocator<T, T>(block.unwrap()),
+      std::forward<Args>(args)...));
+}
+
+} // namespace cpp_result
@@ -0,0 +1,213 @@
+// format.hpp - Allocation-free formatting of Results into caller buffers
+// SPDX-License-Identifier: MIT
+//
+// format_to(first, last, result) writes "Ok(value)" or "Err(error)" into
+// [first, last) and reports the end of the output the way std::to_chars
+// does: no allocation, no locale, no stream state, no locking. Arithmetic
+// payloads go through std::to_chars, strings are copied, enums print their
+// underlying value and nested Results recurse.
+//
+// Other types plug in by specializing value_formatter<T> with a static
+// format(first, last, value) returning std::to_chars_result.
+//
+// When fmt is included before this header (FMT_VERSION is defined), or
+// when <format> is available (__cpp_lib_format), Result also gets a
+// formatter for fmt::format / std::format built on format_to; they accept
+// the empty spec "{}" only.
+//
+// --- API OVERVIEW ---
+//
+//   format_to(first, last, result)   -> std::to_chars_result
+//                                       ec == value_too_large if it does
+//                                       not fit
+//   value_formatter<T>               customization point:
+//                                    static std::to_chars_result
+//                                    format(char *, char *, const T &)
+//   fmt::formatter<Result<T, E>>     (fmt included first)
+//   std::formatter<Result<T, E>>     (C++20 <format>)
+
+#pragma once
+
+#include <result.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace cpp_result {
+
+/**
+ * @brief Writes a T into a character range; specialize for your own types.
+ * @code
+ * template <> struct cpp_result::value_formatter<Point> {
+ *   static std::to_chars_result format(char *first, char *last,
+ *                                      const Point &p) {
+ *     auto r = std::to_chars(first, last, p.x);
+ *     if (r.ec != std::errc{} || r.ptr == last)
+ *       return {last, std::errc::value_too_large};
+ *     *r.ptr++ = ',';
+ *     return std::to_chars(r.ptr, last, p.y);
+ *   }
+ * };
+ * @endcode
+ */
+template <typename T, typename = void> struct value_formatter;
+
+namespace detail {
+
+inline std::to_chars_result write_chars(char *first, char *last,
+                                        std::string_view s) noexcept {
+  if (static_cast<std::size_t>(last - first) < s.size())
+    return {last, std::errc::value_too_large};
+  if (!s.empty())
+    std::memcpy(first, s.data(), s.size());
+  return {first + s.size(), std::errc{}};
+}
+
+template <typename T>
+std::to_chars_result format_value(char *first, char *last, const T &value) {
+  return value_formatter<std::remove_cv_t<T>>::format(first, last, value);
+}
+
+} // namespace detail
+
+template <typename T>
+struct value_formatter<T, std::enable_if_t<std::is_arithmetic_v<T> &&
+                                           !std::is_same_v<T, bool>>> {
+  static std::to_chars_result format(char *first, char *last,
+                                     T value) noexcept {
+    return std::to_chars(first, last, value);
+  }
+};
+
+template <> struct value_formatter<bool> {
+  static std::to_chars_result format(char *first, char *last,
+                                     bool value) noexcept {
+    return detail::write_chars(first, last, value ? "true" : "false");
+  }
+};
+
+template <typename T>
+struct value_formatter<T, std::enable_if_t<std::is_enum_v<T>>> {
+  static std::to_chars_result format(char *first, char *last,
+                                     T value) noexcept {
+    return std::to_chars(first, last,
+                         static_cast<std::underlying_type_t<T>>(value));
+  }
+};
+
+template <typename T>
+struct value_formatter<
+    T, std::enable_if_t<std::is_convertible_v<const T &, std::string_view>>> {
+  static std::to_chars_result format(char *first, char *last,
+                                     const T &value) noexcept {
+    return detail::write_chars(first, last, std::string_view(value));
+  }
+};
+
+/**
+ * @brief Formats a Result as "Ok(value)" or "Err(error)"; a void Ok
+ * prints "Ok(())".
+ *
+ * On overflow returns {last, std::errc::value_too_large} and leaves the
+ * contents of [first, last) unspecified, like std::to_chars.
+ * @code
+ * char line[64];
+ * auto [end, ec] = cpp_result::format_to(line, line + sizeof line, r);
+ * if (ec == std::errc{})
+ *   ::write(2, line, end - line);
+ * @endcode
+ */
+template <typename T, typename E>
+std::to_chars_result format_to(char *first, char *last,
+                               const Result<T, E> &r) {
+  std::to_chars_result out;
+  if (r.is_ok()) {
+    out = detail::write_chars(first, last, "Ok(");
+    if constexpr (std::is_void_v<T>) {
+      if (out.ec == std::errc{})
+        out = detail::write_chars(out.ptr, last, "()");
+    } else if constexpr (!std::is_same_v<T, Never>) {
+      if (out.ec == std::errc{})
+        out = detail::format_value(out.ptr, last, r.unwrap());
+    }
+  } else {
+    out = detail::write_chars(first, last, "Err(");
+    if constexpr (!std::is_same_v<E, Never>) {
+      if (out.ec == std::errc{})
+        out = detail::format_value(out.ptr, last, r.unwrap_err());
+    }
+  }
+  if (out.ec != std::errc{})
+    return out;
+  return detail::write_chars(out.ptr, last, ")");
+}
+
+template <typename T, typename E> struct value_formatter<Result<T, E>> {
+  static std::to_chars_result format(char *first, char *last,
+                                     const Result<T, E> &r) {
+    return format_to(first, last, r);
+  }
+};
+
+namespace detail {
+
+// Formats into a stack buffer, growing on the heap only for output that
+// does not fit, then copies to an output iterator (fmt / std::format).
+template <typename T, typename E, typename Out>
+Out copy_formatted(const Result<T, E> &r, Out out) {
+  char buf[128];
+  auto res = format_to(buf, buf + sizeof buf, r);
+  if (res.ec == std::errc{})
+    return std::copy(buf, res.ptr, out);
+  std::string big(2 * sizeof buf, '\0');
+  while (res.ec == std::errc::value_too_large) {
+    res = format_to(&big[0], &big[0] + big.size(), r);
+    if (res.ec == std::errc{})
+      return std::copy(&big[0], res.ptr, out);
+    big.resize(big.size() * 2);
+  }
+  return out;
+}
+
+} // namespace detail
+
+} // namespace cpp_result
+
+#if defined(FMT_VERSION)
+namespace fmt {
+template <typename T, typename E> struct formatter<cpp_result::Result<T, E>> {
+  template <typename ParseContext> constexpr auto parse(ParseContext &ctx) {
+    return ctx.begin();
+  }
+  template <typename FormatContext>
+  auto format(const cpp_result::Result<T, E> &r, FormatContext &ctx) const {
+    return cpp_result::detail::copy_formatted(r, ctx.out());
+  }
+};
+} // namespace fmt
+#endif
+
+#if defined(__cpp_lib_format)
+namespace std {
+template <typename T, typename E> struct formatter<cpp_result::Result<T, E>> {
+  constexpr auto parse(format_parse_context &ctx) { return ctx.begin(); }
+  template <typename FormatContext>
+  auto format(const cpp_result::Result<T, E> &r, FormatContext &ctx) const {
+    return cpp_result::detail::copy_formatted(r, ctx.out());
+  }
+};
+} // namespace std
+#endif
@@ -0,0 +1,193 @@
+// interop.hpp - Conversions between Result and std::expected/variant/optional
+// SPDX-License-Identifier: MIT
+//
+// Free functions converting a Result<T, E> to and from the standard
+// vocabulary types. Every conversion has an rvalue overload that moves the
+// payload instead of copying it: converting a Result<std::vector<char>, E>
+// moves three pointers, whatever the vector holds. For trivially copyable
+// payloads the move is a copy of the bytes, which the optimizer folds into
+// the surrounding code once the conversion is inlined.
+//
+// The std::expected overloads exist when <expected> does
+// (__cpp_lib_expected, C++23).
+//
+// --- API OVERVIEW ---
+//
+//   to_expected(result)          -> std::expected<T, E>       (C++23)
+//   from_expected(expected)      -> Result<T, E>              (C++23)
+//   to_variant(result)           -> std::variant<T, E>
+//   from_variant(variant)        -> Result<T, E>  (index 0 Ok, index 1 Err)
+//   to_optional(result)          -> std::optional<T>
+//   ok_or(optional, err)         -> Result<T, E>
+//   ok_or_else(optional, f)      -> Result<T, E>, f() builds the error
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cstdlib>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+namespace cpp_result {
+
+#if defined(__cpp_lib_expected)
+
+/**
+ * @brief Converts a Result to std::expected, moving the payload.
+ * @code
+ * std::expected<Config, Error> load() {
+ *   return cpp_result::to_expected(parse_config(path));
+ * }
+ * @endcode
+ */
+template <typename T, typename E>
+std::expected<T, E> to_expected(Result<T, E> &&r) {
+  if (r.is_err())
+    return std::unexpected<E>(std::move(r.unwrap_err()));
+  if constexpr (std::is_void_v<T>)
+    return {};
+  else
+    return std::expected<T, E>(std::in_place, std::move(r.unwrap()));
+}
+
+template <typename T, typename E>
+std::expected<T, E> to_expected(const Result<T, E> &r) {
+  if (r.is_err())
+    return std::unexpected<E>(r.unwrap_err());
+  if constexpr (std::is_void_v<T>)
+    return {};
+  else
+    return std::expected<T, E>(std::in_place, r.unwrap());
+}
+
+/**
+ * @brief Converts a std::expected to a Result, moving the payload.
+ */
+template <typename T, typename E>
+Result<T, E> from_expected(std::expected<T, E> &&x) {
+  if (!x.has_value())
+    return Result<T, E>::Err(std::move(x.error()));
+  if constexpr (std::is_void_v<T>)
+    return Result<T, E>::Ok();
+  else
+    return Result<T, E>::Ok(std::move(*x));
+}
+
+template <typename T, typename E>
+Result<T, E> from_expected(const std::expected<T, E> &x) {
+  if (!x.has_value())
+    return Result<T, E>::Err(x.error());
+  if constexpr (std::is_void_v<T>)
+    return Result<T, E>::Ok();
+  else
+    return Result<T, E>::Ok(*x);
+}
+
+#endif // __cpp_lib_expected
+
+/**
+ * @brief Converts a Result to std::variant<T, E>: Ok at index 0, Err at
+ * index 1 (also when T and E are the same type).
+ */
+template <typename T, typename E>
+std::variant<T, E> to_variant(Result<T, E> &&r) {
+  if (r.is_ok())
+    return std::variant<T, E>(std::in_place_index<0>, std::move(r.unwrap()));
+  return std::variant<T, E>(std::in_place_index<1>, std::move(r.unwrap_err()));
+}
+
+template <typename T, typename E>
+std::variant<T, E> to_variant(const Result<T, E> &r) {
+  if (r.is_ok())
+    return std::variant<T, E>(std::in_place_index<0>, r.unwrap());
+  return std::variant<T, E>(std::in_place_index<1>, r.unwrap_err());
+}
+
+/**
+ * @brief Converts std::variant<T, E> to a Result: index 0 is Ok, index 1
+ * is Err. A valueless variant aborts, like unwrapping the wrong side.
+ */
+template <typename T, typename E>
+Result<T, E> from_variant(std::variant<T, E> &&v) {
+  if (v.valueless_by_exception())
+    std::abort();
+  if (v.index() == 0)
+    return Result<T, E>::Ok(std::move(*std::get_if<0>(&v)));
+  return Result<T, E>::Err(std::move(*std::get_if<1>(&v)));
+}
+
+template <typename T, typename E>
+Result<T, E> from_variant(const std::variant<T, E> &v) {
+  if (v.valueless_by_exception())
+    std::abort();
+  if (v.index() == 0)
+    return Result<T, E>::Ok(*std::get_if<0>(&v));
+  return Result<T, E>::Err(*std::get_if<1>(&v));
+}
+
+/**
+ * @brief The Ok value as std::optional, moved out of the Result. The
+ * member ok() does the same by copy.
+ */
+template <typename T, typename E>
+std::optional<T> to_optional(Result<T, E> &&r) {
+  if (r.is_err())
+    return std::nullopt;
+  return std::optional<T>(std::in_place, std::move(r.unwrap()));
+}
+
+/**
+ * @brief Ok with the optional's value, or Err(err) when it is empty.
+ * @code
+ * auto port = cpp_result::ok_or(env_int("PORT"), ConfigError::MissingPort);
+ * @endcode
+ */
+template <typename T, typename E>
+Result<T, std::decay_t<E>> ok_or(std::optional<T> &&o, E &&err) {
+  using R = Result<T, std::decay_t<E>>;
+  if (!o)
+    return R::Err(std::forward<E>(err));
+  return R::Ok(std::move(*o));
+}
+
+template <typename T, typename E>
+Result<T, std::decay_t<E>> ok_or(const std::optional<T> &o, E &&err) {
+  using R = Result<T, std::decay_t<E>>;
+  if (!o)
+    return R::Err(std::forward<E>(err));
+  return R::Ok(*o);
+}
+
+/**
+ * @brief Like ok_or(), building the error only when the optional is
+ * empty.
+ */
+template <typename T, typename F>
+auto ok_or_else(std::optional<T> &&o, F &&make_err)
+    -> Result<T, std::decay_t<std::invoke_result_t<F &>>> {
+  using R = Result<T, std::decay_t<std::invoke_result_t<F &>>>;
+  if (!o)
+    return R::Err(make_err());
+  return R::Ok(std::move(*o));
+}
+
+template <typename T, typename F>
+auto ok_or_else(const std::optional<T> &o, F &&make_err)
+    -> Result<T, std::decay_t<std::invoke_result_t<F &>>> {
+  using R = Result<T, std::decay_t<std::invoke_result_t<F &>>>;
+  if (!o)
+    return R::Err(make_err());
+  return R::Ok(*o);
+}
+
+} // namespace cpp_result
@@ -0,0 +1,306 @@
+// mapped_file.hpp - Read-only memory-mapped files with Result-based errors
+// SPDX-License-Identifier: MIT
+//
+// MappedFile maps a whole file read-only and exposes it as zero-copy views.
+// Records (lines by default) are produced by an input range whose elements
+// are Result<std::string_view, IoError>, pointing straight into the mapping.
+//
+// --- API OVERVIEW ---
+//
+//   MappedFile::open(path, advice)  -> Result<MappedFile, IoError>
+//   file.bytes(), file.view()       -> ByteView, std::string_view
+//   file.advise(advice)             -> Result<void, IoError>
+//   file.lines(), file.records(d)   -> range of Result<std::string_view, IoError>
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/byte_reader.hpp>
+#include <cpp_result/posix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
+
+namespace cpp_result {
+
+/**
+ * @brief Error reported by MappedFile: the failing step and its errno.
+ */
+struct IoError {
+  enum class Op : std::uint8_t {
+    Open,   ///< open(2) failed.
+    Stat,   ///< fstat(2) failed.
+    Map,    ///< mmap(2) failed.
+    Advise, ///< madvise(2) failed.
+    Record, ///< A record exceeded the configured maximum length.
+  };
+
+  Op op;
+  Errno error;
+
+  bool operator==(const IoError &other) const noexcept {
+    return op == other.op && error == other.error;
+  }
+  bool operator!=(const IoError &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief Access pattern hints passed to madvise(2). Flags can be combined.
+ */
+enum class Advice : unsigned {
+  Normal = 0,
+  Sequential = 1 << 0, ///< MADV_SEQUENTIAL: aggressive read-ahead.
+  Random = 1 << 1,     ///< MADV_RANDOM: no read-ahead.
+  WillNeed = 1 << 2,   ///< MADV_WILLNEED: start reading the whole range.
+  HugePage = 1 << 3,   ///< MADV_HUGEPAGE: back with transparent huge pages.
+};
+
+constexpr Advice operator|(Advice a, Advice b) noexcept {
+  return static_cast<Advice>(static_cast<unsigned>(a) |
+                             static_cast<unsigned>(b));
+}
+constexpr bool operator&(Advice a, Advice b) noexcept {
+  return (static_cast<unsigned>(a) & static_cast<unsigned>(b)) != 0;
+}
+
+/**
+ * @brief Input range over delimiter-separated records of a buffer.
+ *
+ * Each element is Ok(record) without the delimiter, or Err(IoError) with
+ * `Op::Record`/`EMSGSIZE` for a record longer than the configured maximum;
+ * iteration then resumes after that record. A trailing delimiter does not
+ * produce an empty final record.
+ */
+class RecordRange {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Result<std::string_view, IoError>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = value_type;
+
+    iterator() noexcept = default;
+
+    value_type operator*() const noexcept {
+      const std::size_t len = static_cast<std::size_t>(next_ - pos_);
+      if (len > max_record_)
+        return value_type::Err({IoError::Op::Record, Errno{EMSGSIZE}});
+      return value_type::Ok(std::string_view(pos_, len));
+    }
+
+    iterator &operator++() noexcept {
+      pos_ = next_ == end_ ? next_ : next_ + 1;
+      find_next();
+      return *this;
+    }
+    void operator++(int) noexcept { ++*this; }
+
+    bool operator==(const iterator &other) const noexcept {
+      return pos_ == other.pos_;
+    }
+    bool operator!=(const iterator &other) const noexcept {
+      return pos_ != other.pos_;
+    }
+
+  private:
+    friend class RecordRange;
+
+    // Copies what it needs from the range, so it stays valid after a
+    // temporary range (`f.lines().begin()`) is gone.
+    iterator(const RecordRange &range, const char *pos) noexcept
+        : pos_(pos), end_(range.end_), max_record_(range.max_record_),
+          delim_(range.delim_) {
+      find_next();
+    }
+
+    void find_next() noexcept {
+      if (pos_ == end_) {
+        next_ = pos_;
+        return;
+      }
+      const void *hit =
+          std::memchr(pos_, delim_, static_cast<std::size_t>(end_ - pos_));
+      next_ = hit ? static_cast<const char *>(hit) : end_;
+    }
+
+    const char *pos_ = nullptr;
+    const char *next_ = nullptr;
+    const char *end_ = nullptr;
+    std::size_t max_record_ = 0;
+    char delim_ = '\n';
+  };
+
+  RecordRange(std::string_view text, char delim,
+              std::size_t max_record) noexcept
+      : begin_(text.data()), end_(text.data() + text.size()), delim_(delim),
+        max_record_(max_record) {}
+
+  iterator begin() const noexcept { return iterator(*this, begin_); }
+  iterator end() const noexcept { return iterator(*this, end_); }
+
+private:
+  const char *begin_;
+  const char *end_;
+  char delim_;
+  std::size_t max_record_;
+};
+
+/**
+ * @brief A whole file mapped read-only into memory.
+ *
+ * Move-only; the mapping is released on destruction. The descriptor is
+ * closed as soon as the mapping exists. Views handed out by the file stay
+ * valid until it is destroyed.
+ *
+ * @code
+ * auto file = cpp_result::MappedFile::open("events.log");
+ * if (file.is_err())
+ *   return;
+ * for (auto line : file.unwrap().lines())
+ *   line.inspect([](std::string_view l) { consume(l); });
+ * @endcode
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Maps path read-only and applies the advice hints.
+   *
+   * Hints are best effort: a kernel that rejects one (e.g. HugePage on a
+   * filesystem without THP support) does not fail the open. Use advise()
+   * to observe hint errors.
+   */
+  static Result<MappedFile, IoError>
+  open(const char *path, Advice advice = Advice::Sequential) noexcept {
+    using R = Result<MappedFile, IoError>;
+    auto fd = posix::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd.is_err())
+      return R::Err({IoError::Op::Open, fd.unwrap_err()});
+    auto st = posix::fstat(fd.unwrap());
+    if (st.is_err()) {
+      (void)posix::close(fd.unwrap());
+      return R::Err({IoError::Op::Stat, st.unwrap_err()});
+    }
+    const auto size = static_cast<std::size_t>(st.unwrap().st_size);
+    if (size == 0) {
+      (void)posix::close(fd.unwrap());
+      return R::Ok(MappedFile());
+    }
+    auto addr = posix::mmap(nullptr, size, PROT_READ, MAP_PRIVATE,
+                            fd.unwrap(), 0);
+    (void)posix::close(fd.unwrap());
+    if (addr.is_err())
+      return R::Err({IoError::Op::Map, addr.unwrap_err()});
+    MappedFile file(static_cast<const std::byte *>(addr.unwrap()), size);
+    (void)file.advise(advice);
+    return R::Ok(std::move(file));
+  }
+
+  MappedFile() noexcept = default;
+  ~MappedFile() { reset(); }
+
+  MappedFile(MappedFile &&other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      reset();
+      data_ = other.data_;
+      size_ = other.size_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const std::byte *data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Returns the file contents as bytes, e.g. for a ByteReader.
+   */
+  ByteView bytes() const noexcept { return {data_, size_}; }
+
+  /**
+   * @brief Returns the file contents as text.
+   */
+  std::string_view view() const noexcept {
+    return {reinterpret_cast<const char *>(data_), size_};
+  }
+
+  /**
+   * @brief Applies access pattern hints to the whole mapping.
+   *
+   * Every requested hint is attempted; the first failure is returned.
+   */
+  Result<void, IoError> advise(Advice advice) const noexcept {
+    if (size_ == 0)
+      return Result<void, IoError>::Ok();
+    void *addr = const_cast<std::byte *>(data_);
+    Result<void, Errno> first = Result<void, Errno>::Ok();
+    auto apply = [&](Advice flag, int madv) {
+      if (!(advice & flag))
+        return;
+      auto res = posix::madvise(addr, size_, madv);
+      if (first.is_ok() && res.is_err())
+        first = res;
+    };
+    apply(Advice::Sequential, MADV_SEQUENTIAL);
+    apply(Advice::Random, MADV_RANDOM);
+    apply(Advice::WillNeed, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    apply(Advice::HugePage, MADV_HUGEPAGE);
+#endif
+    if (first.is_err())
+      return Result<void, IoError>::Err({IoError::Op::Advise,
+                                         first.unwrap_err()});
+    return Result<void, IoError>::Ok();
+  }
+
+  /**
+   * @brief Returns the records separated by delim.
+   * @param max_record Records longer than this are reported as errors.
+   */
+  RecordRange records(char delim, std::size_t max_record =
+                                      std::numeric_limits<std::size_t>::max())
+      const noexcept {
+    return RecordRange(view(), delim, max_record);
+  }
+
+  /**
+   * @brief Returns the newline-separated lines of the file.
+   */
+  RecordRange lines(std::size_t max_record =
+                        std::numeric_limits<std::size_t>::max()) const noexcept {
+    return records('\n', max_record);
+  }
+
+private:
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+
+  MappedFile(const std::byte *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  void reset() noexcept {
+    if (data_)
+      (void)posix::munmap(const_cast<std::byte *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+};
+
+} // namespace cpp_result
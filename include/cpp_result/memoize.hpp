@@ -0,0 +1,352 @@
+// memoize.hpp - Memoizing cache for Result-returning functions
+// SPDX-License-Identifier: MIT
+//
+// memoize(f, policy) wraps a function Key -> Result<T, E> with a sharded
+// cache. Ok values live in an LRU with their own capacity and optional
+// TTL; errors are cached separately (negative caching) with a smaller
+// capacity and a TTL, so a failing key is retried periodically rather
+// than hammered or remembered forever. Concurrent misses for the same key
+// are coalesced: one caller runs f, the others wait for its result.
+//
+// --- API OVERVIEW ---
+//
+//   memoize(f, policy)          -> Memoized<Key, F>  (Key deduced from f)
+//   memoize<Key>(f, policy)     -> Memoized<Key, F>
+//   memo(key)                   -> Result<T, E>
+//   memo.invalidate(key), memo.clear(), memo.stats() -> MemoStats
+//   MemoizePolicy               capacities, TTLs, shard count
+
+#pragma once
+
+#include <result.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpp_result {
+
+/**
+ * @brief Capacities and lifetimes of a memoizing cache.
+ *
+ * Capacities are totals, split evenly across shards. A zero error capacity
+ * disables negative caching.
+ */
+struct MemoizePolicy {
+  /// Ok values kept; least recently used are evicted first.
+  std::size_t ok_capacity = 4096;
+  /// Errors kept; least recently used are evicted first.
+  std::size_t err_capacity = 1024;
+  /// Lifetime of a cached Ok value.
+  std::chrono::nanoseconds ok_ttl = std::chrono::nanoseconds::max();
+  /// Lifetime of a cached error.
+  std::chrono::nanoseconds err_ttl = std::chrono::seconds(1);
+  /// Independently locked partitions of the key space.
+  unsigned shards = 16;
+};
+
+/**
+ * @brief Counters of a memoizing cache, summed over shards.
+ */
+struct MemoStats {
+  std::uint64_t ok_hits = 0;   ///< Served from the Ok cache.
+  std::uint64_t err_hits = 0;  ///< Served from the error cache.
+  std::uint64_t misses = 0;    ///< Calls to the wrapped function.
+  std::uint64_t coalesced = 0; ///< Waited on another caller's miss.
+  std::uint64_t evictions = 0; ///< Entries dropped for capacity or TTL.
+
+  double hit_rate() const noexcept {
+    const std::uint64_t total = ok_hits + err_hits + misses + coalesced;
+    return total ? static_cast<double>(ok_hits + err_hits + coalesced) /
+                       static_cast<double>(total)
+                 : 0.0;
+  }
+};
+
+namespace detail {
+
+template <typename R> struct MemoResult;
+template <typename T, typename E> struct MemoResult<Result<T, E>> {
+  using value_type = T;
+  using error_type = E;
+};
+
+template <typename F, typename = void> struct MemoKey {};
+template <typename R, typename A> struct MemoKey<R (*)(A)> {
+  using type = std::decay_t<A>;
+};
+template <typename C, typename R, typename A> struct MemoKey<R (C::*)(A)> {
+  using type = std::decay_t<A>;
+};
+template <typename C, typename R, typename A>
+struct MemoKey<R (C::*)(A) const> {
+  using type = std::decay_t<A>;
+};
+template <typename F>
+struct MemoKey<F, std::void_t<decltype(&F::operator())>>
+    : MemoKey<decltype(&F::operator())> {};
+
+template <typename Key, typename F> struct MemoKeyOr {
+  using type = Key;
+};
+template <typename F> struct MemoKeyOr<void, F> : MemoKey<F> {};
+
+// LRU of key -> (value, expiry) with a fixed capacity.
+template <typename Key, typename V, typename Time> class MemoLru {
+public:
+  explicit MemoLru(std::size_t capacity) : capacity_(capacity) {}
+
+  // Returns the live entry and marks it most recently used. An expired
+  // entry is dropped and counted in `evictions`.
+  const V *find(const Key &key, Time now, std::uint64_t &evictions) {
+    auto found = index_.find(key);
+    if (found == index_.end())
+      return nullptr;
+    auto it = found->second;
+    if (it->expires <= now) {
+      index_.erase(found);
+      order_.erase(it);
+      ++evictions;
+      return nullptr;
+    }
+    order_.splice(order_.begin(), order_, it);
+    return &it->value;
+  }
+
+  void put(const Key &key, V value, Time expires, std::uint64_t &evictions) {
+    if (capacity_ == 0)
+      return;
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      found->second->value = std::move(value);
+      found->second->expires = expires;
+      order_.splice(order_.begin(), order_, found->second);
+      return;
+    }
+    if (index_.size() == capacity_) {
+      index_.erase(order_.back().key);
+      order_.pop_back();
+      ++evictions;
+    }
+    order_.push_front(Entry{key, std::move(value), expires});
+    index_.emplace(key, order_.begin());
+  }
+
+  void erase(const Key &key) {
+    auto found = index_.find(key);
+    if (found == index_.end())
+      return;
+    order_.erase(found->second);
+    index_.erase(found);
+  }
+
+  void clear() {
+    index_.clear();
+    order_.clear();
+  }
+
+private:
+  struct Entry {
+    Key key;
+    V value;
+    Time expires;
+  };
+
+  std::size_t capacity_;
+  std::list<Entry> order_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator> index_;
+};
+
+} // namespace detail
+
+/**
+ * @brief A function Key -> Result<T, E> with a sharded Ok/error cache.
+ *
+ * Thread-safe; f is called concurrently for different keys, without any
+ * lock held. T and E are copied out of the cache on every hit. If f
+ * throws, the exception reaches its caller and the callers waiting on the
+ * same key retry on their own.
+ *
+ * `Clock` provides `now()` and `time_point`, and can be replaced in tests.
+ */
+template <typename Key, typename F, typename Clock = std::chrono::steady_clock>
+class Memoized {
+public:
+  using result_type = std::invoke_result_t<F &, const Key &>;
+  using value_type = typename detail::MemoResult<result_type>::value_type;
+  using error_type = typename detail::MemoResult<result_type>::error_type;
+  static_assert(!std::is_void_v<value_type>,
+                "memoize requires a non-void Ok type");
+
+  Memoized(F f, const MemoizePolicy &policy)
+      : f_(std::move(f)), policy_(policy) {
+    const unsigned n = policy.shards ? policy.shards : 1;
+    shards_.reserve(n);
+    for (unsigned i = 0; i < n; ++i)
+      shards_.push_back(std::make_unique<Shard>(
+          (policy.ok_capacity + n - 1) / n, (policy.err_capacity + n - 1) / n));
+  }
+
+  /**
+   * @brief Returns the cached result for key, or calls f once for it.
+   */
+  result_type operator()(const Key &key) {
+    Shard &shard = shard_for(key);
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    for (;;) {
+      const auto now = Clock::now();
+      if (const auto *v = shard.ok.find(key, now, shard.stats.evictions)) {
+        ++shard.stats.ok_hits;
+        return result_type::Ok(*v);
+      }
+      if (const auto *e = shard.err.find(key, now, shard.stats.evictions)) {
+        ++shard.stats.err_hits;
+        return result_type::Err(*e);
+      }
+      auto flight = shard.flights.find(key);
+      if (flight == shard.flights.end())
+        break;
+      // Another caller is computing this key: wait for it.
+      ++shard.stats.coalesced;
+      std::shared_ptr<Flight> f = flight->second;
+      f->done.wait(lock, [&] { return f->finished; });
+      if (f->result)
+        return *f->result;
+      // The leader threw; look again, and lead if nobody else does.
+      --shard.stats.coalesced;
+    }
+
+    ++shard.stats.misses;
+    auto flight = std::make_shared<Flight>();
+    shard.flights.emplace(key, flight);
+    lock.unlock();
+
+    // Wakes the waiters even if f throws.
+    struct Land {
+      Shard &shard;
+      const Key &key;
+      Flight &flight;
+      ~Land() {
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        shard.flights.erase(key);
+        flight.finished = true;
+        flight.done.notify_all();
+      }
+    };
+    Land land{shard, key, *flight};
+
+    result_type result = f_(key);
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    const auto now = Clock::now();
+    if (result.is_ok())
+      shard.ok.put(key, result.unwrap(), expiry(now, policy_.ok_ttl),
+                   shard.stats.evictions);
+    else
+      shard.err.put(key, result.unwrap_err(), expiry(now, policy_.err_ttl),
+                    shard.stats.evictions);
+    flight->result.emplace(result);
+    return result;
+  }
+
+  /**
+   * @brief Drops any cached Ok value or error for key.
+   */
+  void invalidate(const Key &key) {
+    Shard &shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.ok.erase(key);
+    shard.err.erase(key);
+  }
+
+  void clear() {
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->ok.clear();
+      shard->err.clear();
+    }
+  }
+
+  MemoStats stats() const {
+    MemoStats total;
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total.ok_hits += shard->stats.ok_hits;
+      total.err_hits += shard->stats.err_hits;
+      total.misses += shard->stats.misses;
+      total.coalesced += shard->stats.coalesced;
+      total.evictions += shard->stats.evictions;
+    }
+    return total;
+  }
+
+private:
+  using Time = typename Clock::time_point;
+
+  struct Flight {
+    std::condition_variable done;
+    bool finished = false;
+    std::optional<result_type> result;
+  };
+
+  struct Shard {
+    Shard(std::size_t ok_capacity, std::size_t err_capacity)
+        : ok(ok_capacity), err(err_capacity) {}
+
+    std::mutex mutex;
+    detail::MemoLru<Key, value_type, Time> ok;
+    detail::MemoLru<Key, error_type, Time> err;
+    std::unordered_map<Key, std::shared_ptr<Flight>> flights;
+    MemoStats stats;
+  };
+
+  static Time expiry(Time now, std::chrono::nanoseconds ttl) {
+    if (ttl >= std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   Time::max() - now))
+      return Time::max();
+    return now + std::chrono::duration_cast<typename Clock::duration>(ttl);
+  }
+
+  Shard &shard_for(const Key &key) {
+    // Multiply-shift so that hashes differing only in high bits (and
+    // identity hashes of small integers) still spread over the shards.
+    const std::uint64_t h =
+        static_cast<std::uint64_t>(std::hash<Key>{}(key)) *
+        0x9e3779b97f4a7c15ull;
+    return *shards_[(h >> 32) % shards_.size()];
+  }
+
+  F f_;
+  MemoizePolicy policy_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+/**
+ * @brief Wraps f in a memoizing cache.
+ *
+ * Key is deduced from f's parameter when f is a function pointer or a
+ * non-generic lambda; pass it explicitly otherwise.
+ * @code
+ * cpp_result::MemoizePolicy policy;
+ * policy.err_ttl = std::chrono::seconds(30);
+ * auto lookup = cpp_result::memoize(
+ *     [&](const std::string &user) { return db.find_user(user); }, policy);
+ * auto user = lookup("alice"); // later calls hit the cache
+ * @endcode
+ */
+template <typename Key = void, typename F>
+auto memoize(F f, const MemoizePolicy &policy = {}) {
+  return Memoized<typename detail::MemoKeyOr<Key, F>::type, F>(std::move(f),
+                                                               policy);
+}
+
+} // namespace cpp_result
@@ -0,0 +1,426 @@
+// net.hpp - Non-blocking sockets and an epoll reactor driven by Results
+// SPDX-License-Identifier: MIT
+//
+// Socket wrappers in the style of posix.hpp. The data-path calls (accept4,
+// recv, send, recvmmsg, sendmmsg) are meant for non-blocking descriptors:
+// they retry EINTR themselves and return Poll<std::size_t, Errno> (or
+// Poll<int, Errno> for accept4), Pending when the kernel answers
+// EAGAIN/EWOULDBLOCK. No caller tests errno by hand, and TRY_READY
+// propagates both "not yet" and failures.
+//
+// Reactor<E> is a minimal single-threaded epoll loop. Each registered
+// descriptor has a handler returning Result<void, E>: Ok keeps the
+// descriptor registered, Err closes it (after an optional on_close
+// callback sees the error). The reactor owns the descriptors registered
+// with it.
+//
+// --- API OVERVIEW ---
+//
+// Setup (namespace cpp_result::net), Result<_, Errno>:
+//   socket, bind, listen, set_option, local_port
+//   connect(fd, addr, len)         EINTR not retried: like EINPROGRESS,
+//                                  wait for EPOLLOUT, then connect_result
+//   listen_tcp(ipv4, port)         non-blocking listener, SO_REUSEADDR
+//
+// Data path, Poll<_, Errno> (Pending on EAGAIN, EINTR retried):
+//   accept4(fd), recv(fd, buf, len), send(fd, buf, len)
+//   recvmmsg(fd, msgs, n), sendmmsg(fd, msgs, n)
+//   would_block(result)            Result<T, Errno> -> Poll<T, Errno>
+//
+// Reactor<E>:
+//   Reactor<E>::create()           -> Result<Reactor<E>, Errno>
+//   add(fd, events, handler)       handler(fd, events) -> Result<void, E>
+//   modify(fd, events), close(fd), on_close(fn), size()
+//   run_once(timeout_ms)           -> Result<std::size_t, Errno> (events)
+//   run(), stop()
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/poll.hpp>
+#include <cpp_result/posix.hpp>
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace cpp_result {
+namespace net {
+
+/**
+ * @brief Ready with the Result, or Pending when it failed with
+ * EAGAIN/EWOULDBLOCK.
+ */
+template <typename T> Poll<T, Errno> would_block(Result<T, Errno> &&r) {
+  if (r.is_err() &&
+      (r.unwrap_err() == EAGAIN || r.unwrap_err() == EWOULDBLOCK))
+    return pending;
+  return Poll<T, Errno>(std::move(r));
+}
+
+/**
+ * @brief socket(2). Pass SOCK_NONBLOCK | SOCK_CLOEXEC in type for the
+ * data-path wrappers.
+ */
+inline Result<int, Errno> socket(int domain, int type,
+                                 int protocol = 0) noexcept {
+  return posix::detail::check<int>(::socket(domain, type, protocol));
+}
+
+/// bind(2).
+inline Result<void, Errno> bind(int fd, const sockaddr *addr,
+                                socklen_t len) noexcept {
+  return posix::detail::check_void(::bind(fd, addr, len));
+}
+
+/// listen(2).
+inline Result<void, Errno> listen(int fd, int backlog = SOMAXCONN) noexcept {
+  return posix::detail::check_void(::listen(fd, backlog));
+}
+
+/**
+ * @brief connect(2), not retried on EINTR.
+ *
+ * EINPROGRESS (non-blocking socket) and EINTR (any socket) are both
+ * returned as Err, and both mean the connection is still being set up in
+ * the background: calling connect again would only report EALREADY or
+ * EISCONN. Wait until the socket is writable (EPOLLOUT) and read the
+ * outcome with connect_result().
+ * @code
+ * auto started = net::connect(fd, addr, len);
+ * if (started.is_err() && started.unwrap_err() != EINPROGRESS &&
+ *     started.unwrap_err() != EINTR)
+ *   return started;
+ * // ... once fd is writable:
+ * TRY(net::connect_result(fd));
+ * @endcode
+ */
+inline Result<void, Errno> connect(int fd, const sockaddr *addr,
+                                   socklen_t len) noexcept {
+  return posix::detail::check_void(::connect(fd, addr, len));
+}
+
+/// The outcome of a connect that returned EINPROGRESS or EINTR (SO_ERROR).
+inline Result<void, Errno> connect_result(int fd) noexcept {
+  int err = 0;
+  socklen_t len = sizeof(err);
+  if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == -1)
+    return Result<void, Errno>::Err(Errno::last());
+  if (err != 0)
+    return Result<void, Errno>::Err(Errno{err});
+  return Result<void, Errno>::Ok();
+}
+
+/// setsockopt(2) for an int option.
+inline Result<void, Errno> set_option(int fd, int level, int name,
+                                      int value) noexcept {
+  return posix::detail::check_void(
+      ::setsockopt(fd, level, name, &value, sizeof(value)));
+}
+
+/// The local port of a bound IPv4 or IPv6 socket, e.g. after binding 0.
+inline Result<std::uint16_t, Errno> local_port(int fd) noexcept {
+  sockaddr_storage addr{};
+  socklen_t len = sizeof(addr);
+  if (::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == -1)
+    return Result<std::uint16_t, Errno>::Err(Errno::last());
+  if (addr.ss_family == AF_INET6)
+    return Result<std::uint16_t, Errno>::Ok(
+        ntohs(reinterpret_cast<sockaddr_in6 *>(&addr)->sin6_port));
+  return Result<std::uint16_t, Errno>::Ok(
+      ntohs(reinterpret_cast<sockaddr_in *>(&addr)->sin_port));
+}
+
+/**
+ * @brief A non-blocking, close-on-exec TCP listener on an IPv4 address,
+ * with SO_REUSEADDR set. Port 0 picks a free port (see local_port()).
+ * @code
+ * int fd = TRY(cpp_result::net::listen_tcp("127.0.0.1", 8080));
+ * @endcode
+ */
+inline Result<int, Errno> listen_tcp(const char *ipv4, std::uint16_t port,
+                                     int backlog = SOMAXCONN) noexcept {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (::inet_pton(AF_INET, ipv4, &addr.sin_addr) != 1)
+    return Result<int, Errno>::Err(Errno{EINVAL});
+  auto fd = net::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC);
+  if (fd.is_err())
+    return fd;
+  auto setup = set_option(fd.unwrap(), SOL_SOCKET, SO_REUSEADDR, 1)
+                   .and_then([&] {
+                     return net::bind(fd.unwrap(),
+                                      reinterpret_cast<const sockaddr *>(&addr),
+                                      sizeof(addr));
+                   })
+                   .and_then([&] { return net::listen(fd.unwrap(), backlog); });
+  if (setup.is_err()) {
+    ::close(fd.unwrap());
+    return Result<int, Errno>::Err(setup.unwrap_err());
+  }
+  return fd;
+}
+
+/**
+ * @brief accept4(2): a new connection, non-blocking and close-on-exec by
+ * default. Pending when no connection is waiting. EINTR and ECONNABORTED
+ * (a connection reset while queued) are retried.
+ */
+inline Poll<int, Errno>
+accept4(int fd, int flags = SOCK_NONBLOCK | SOCK_CLOEXEC) noexcept {
+  for (;;) {
+    int conn = ::accept4(fd, nullptr, nullptr, flags);
+    if (conn >= 0)
+      return Poll<int, Errno>::Ok(conn);
+    if (errno != EINTR && errno != ECONNABORTED)
+      return would_block(Result<int, Errno>::Err(Errno::last()));
+  }
+}
+
+/**
+ * @brief recv(2). Ok(0) means the peer closed the connection; Pending
+ * means nothing to read yet.
+ * @code
+ * std::size_t n = TRY_READY(cpp_result::net::recv(fd, buf, sizeof(buf)));
+ * @endcode
+ */
+inline Poll<std::size_t, Errno> recv(int fd, void *buf, std::size_t len,
+                                     int flags = 0) noexcept {
+  return would_block(posix::retry_eintr([&] {
+    return posix::detail::check<std::size_t>(::recv(fd, buf, len, flags));
+  }));
+}
+
+/**
+ * @brief send(2), with MSG_NOSIGNAL so a closed peer is EPIPE rather than
+ * SIGPIPE. Pending when the send buffer is full; may send fewer bytes.
+ */
+inline Poll<std::size_t, Errno> send(int fd, const void *buf, std::size_t len,
+                                     int flags = MSG_NOSIGNAL) noexcept {
+  return would_block(posix::retry_eintr([&] {
+    return posix::detail::check<std::size_t>(::send(fd, buf, len, flags));
+  }));
+}
+
+/**
+ * @brief recvmmsg(2): receives up to n datagrams in one call. Returns the
+ * number of messages received; msgs[i].msg_len holds their sizes.
+ */
+inline Poll<std::size_t, Errno> recvmmsg(int fd, mmsghdr *msgs, unsigned n,
+                                         int flags = 0) noexcept {
+  return would_block(posix::retry_eintr([&] {
+    return posix::detail::check<std::size_t>(
+        ::recvmmsg(fd, msgs, n, flags, nullptr));
+  }));
+}
+
+/**
+ * @brief sendmmsg(2): sends up to n datagrams in one call. Returns the
+ * number of messages sent.
+ */
+inline Poll<std::size_t, Errno> sendmmsg(int fd, mmsghdr *msgs, unsigned n,
+                                         int flags = MSG_NOSIGNAL) noexcept {
+  return would_block(posix::retry_eintr([&] {
+    return posix::detail::check<std::size_t>(::sendmmsg(fd, msgs, n, flags));
+  }));
+}
+
+/**
+ * @brief Single-threaded epoll loop whose handlers decide, through their
+ * Result, whether a descriptor stays open.
+ *
+ * Handlers are called as handler(fd, epoll_events) and may add or close
+ * descriptors, including their own. An Err closes the descriptor after
+ * the on_close callback, if any, has seen the error.
+ * @code
+ * auto created = Reactor<Errno>::create();
+ * auto &reactor = created.unwrap();
+ * int lfd = net::listen_tcp("127.0.0.1", 8080).unwrap();
+ * reactor.add(lfd, EPOLLIN, [&](int fd, std::uint32_t) -> Result<void, Errno> {
+ *   for (;;) {
+ *     auto conn = net::accept4(fd);
+ *     if (conn.is_pending())
+ *       return Result<void, Errno>::Ok();
+ *     int c = TRY_INTO(std::move(conn).into_result());
+ *     auto added = reactor.add(c, EPOLLIN, echo_handler);
+ *     if (added.is_err())
+ *       ::close(c);
+ *   }
+ * });
+ * reactor.run();
+ * @endcode
+ */
+template <typename E> class Reactor {
+public:
+  using Handler = std::function<Result<void, E>(int fd, std::uint32_t events)>;
+  using CloseHandler = std::function<void(int fd, const E &error)>;
+
+  static Result<Reactor, Errno> create() noexcept {
+    int fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (fd == -1)
+      return Result<Reactor, Errno>::Err(Errno::last());
+    return Result<Reactor, Errno>::Ok(Reactor(fd));
+  }
+
+  Reactor(Reactor &&other) noexcept { steal(other); }
+  Reactor &operator=(Reactor &&other) noexcept {
+    if (this != &other) {
+      reset();
+      steal(other);
+    }
+    return *this;
+  }
+  Reactor(const Reactor &) = delete;
+  Reactor &operator=(const Reactor &) = delete;
+  /// Closes the epoll instance and every registered descriptor.
+  ~Reactor() { reset(); }
+
+  /**
+   * @brief Registers fd for events (EPOLLIN, EPOLLOUT, EPOLLET...) and
+   * takes ownership of it. On Err the caller keeps the descriptor.
+   */
+  Result<void, Errno> add(int fd, std::uint32_t events, Handler handler) {
+    if (fd < 0)
+      return Result<void, Errno>::Err(Errno{EBADF});
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (::epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) == -1)
+      return Result<void, Errno>::Err(Errno::last());
+    if (static_cast<std::size_t>(fd) >= handlers_.size())
+      handlers_.resize(static_cast<std::size_t>(fd) + 1);
+    handlers_[fd] = std::make_unique<Handler>(std::move(handler));
+    ++live_;
+    return Result<void, Errno>::Ok();
+  }
+
+  /// Changes the events a registered fd waits for.
+  Result<void, Errno> modify(int fd, std::uint32_t events) noexcept {
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    return posix::detail::check_void(
+        ::epoll_ctl(epfd_, EPOLL_CTL_MOD, fd, &ev));
+  }
+
+  /**
+   * @brief Deregisters and closes fd. Safe from within any handler; the
+   * handler object is destroyed once the current dispatch round ends.
+   */
+  void close(int fd) noexcept {
+    if (!registered(fd))
+      return;
+    ::epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    retired_.push_back(std::move(handlers_[fd]));
+    --live_;
+  }
+
+  /// Called with the descriptor and error before a failing fd is closed.
+  void on_close(CloseHandler fn) { on_close_ = std::move(fn); }
+
+  /// Number of registered descriptors.
+  std::size_t size() const noexcept { return live_; }
+
+  /**
+   * @brief Waits up to timeout_ms (-1: forever) and dispatches the ready
+   * descriptors. Returns the number of events; 0 on timeout or EINTR.
+   *
+   * A descriptor closed earlier in the same round may be reused by a new
+   * connection that then sees the stale event; with non-blocking I/O its
+   * handler just observes Pending.
+   */
+  Result<std::size_t, Errno> run_once(int timeout_ms = -1) {
+    int n = ::epoll_wait(epfd_, events_, kMaxEvents, timeout_ms);
+    if (n == -1) {
+      if (errno == EINTR)
+        return Result<std::size_t, Errno>::Ok(0);
+      return Result<std::size_t, Errno>::Err(Errno::last());
+    }
+    for (int i = 0; i < n; ++i) {
+      const int fd = events_[i].data.fd;
+      if (!registered(fd))
+        continue;
+      Handler &handler = *handlers_[fd];
+      auto r = handler(fd, events_[i].events);
+      if (r.is_err() && registered(fd)) {
+        if (on_close_)
+          on_close_(fd, r.unwrap_err());
+        close(fd);
+      }
+    }
+    retired_.clear();
+    return Result<std::size_t, Errno>::Ok(static_cast<std::size_t>(n));
+  }
+
+  /// Dispatches until stop() is called from a handler or no descriptor
+  /// is left.
+  Result<void, Errno> run() {
+    stopped_ = false;
+    while (!stopped_ && live_ > 0) {
+      auto r = run_once(-1);
+      if (r.is_err())
+        return Result<void, Errno>::Err(r.unwrap_err());
+    }
+    return Result<void, Errno>::Ok();
+  }
+
+  /// Makes run() return after the current round.
+  void stop() noexcept { stopped_ = true; }
+
+private:
+  static constexpr int kMaxEvents = 64;
+
+  explicit Reactor(int epfd) noexcept : epfd_(epfd) {}
+
+  bool registered(int fd) const noexcept {
+    return fd >= 0 && static_cast<std::size_t>(fd) < handlers_.size() &&
+           handlers_[fd] != nullptr;
+  }
+
+  void reset() noexcept {
+    for (std::size_t fd = 0; fd < handlers_.size(); ++fd)
+      if (handlers_[fd])
+        ::close(static_cast<int>(fd));
+    handlers_.clear();
+    retired_.clear();
+    live_ = 0;
+    if (epfd_ >= 0)
+      ::close(epfd_);
+    epfd_ = -1;
+  }
+
+  void steal(Reactor &other) noexcept {
+    epfd_ = std::exchange(other.epfd_, -1);
+    handlers_ = std::move(other.handlers_);
+    retired_ = std::move(other.retired_);
+    live_ = std::exchange(other.live_, 0);
+    on_close_ = std::move(other.on_close_);
+    stopped_ = other.stopped_;
+    other.handlers_.clear();
+  }
+
+  int epfd_ = -1;
+  // Indexed by descriptor; heap-allocated so a handler stays put while it
+  // runs even if it registers new descriptors.
+  std::vector<std::unique_ptr<Handler>> handlers_;
+  std::vector<std::unique_ptr<Handler>> retired_;
+  std::size_t live_ = 0;
+  CloseHandler on_close_;
+  bool stopped_ = false;
+  epoll_event events_[kMaxEvents];
+};
+
+} // namespace net
+} // namespace cpp_result
@@ -0,0 +1,284 @@
+// object_pool.hpp - Fixed-capacity lock-free object pool
+// SPDX-License-Identifier: MIT
+//
+// ObjectPool<T> constructs `capacity` objects up front and lends them out
+// through move-only handles that give the object back when destroyed.
+// try_acquire() never blocks or allocates: when every object is lent it
+// fails fast with PoolError::Kind::Exhausted. acquire_for(timeout) waits
+// for a handle to come back instead.
+//
+// Free objects sit on lock-free stacks (Treiber stacks with a tagged head
+// against ABA), striped so that each thread pushes to and pops from its
+// own home stripe and only steals from the others when that is empty.
+// Under load each thread thus mostly reuses objects it released itself,
+// which stay warm in its cache.
+//
+// --- API OVERVIEW ---
+//
+//   ObjectPool<T>(capacity, args...)   constructs capacity T(args...)
+//   pool.try_acquire()                 -> Result<Handle, PoolError>
+//   pool.acquire_for(timeout)          -> Result<Handle, PoolError>
+//   pool.capacity()
+//   Handle: *h, h->..., h.get(); returns the object on destruction
+
+#pragma once
+
+#include <result.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/**
+ * @brief Error reported by ObjectPool.
+ */
+struct PoolError {
+  enum class Kind : std::uint8_t {
+    Exhausted, ///< try_acquire(): every object is lent out.
+    Timeout,   ///< acquire_for(): none came back before the timeout.
+  };
+
+  Kind kind;
+
+  bool operator==(const PoolError &other) const noexcept {
+    return kind == other.kind;
+  }
+  bool operator!=(const PoolError &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+namespace detail {
+
+constexpr std::uint32_t kPoolNil = 0xffffffffu;
+
+// Head of a free stack: | ABA tag : 32 | top index : 32 |
+struct alignas(64) PoolStripe {
+  std::atomic<std::uint64_t> head{kPoolNil};
+};
+
+// Storage for the pooled objects; destroys those constructed so far.
+template <typename T> class PoolStorage {
+public:
+  explicit PoolStorage(std::size_t n) : slots_(new Slot[n]) {}
+  PoolStorage(const PoolStorage &) = delete;
+  PoolStorage &operator=(const PoolStorage &) = delete;
+  ~PoolStorage() {
+    while (size_)
+      get(--size_)->~T();
+  }
+
+  template <typename... Args> void emplace(const Args &...args) {
+    ::new (static_cast<void *>(&slots_[size_])) T(args...);
+    ++size_;
+  }
+
+  T *get(std::size_t i) noexcept {
+    return std::launder(reinterpret_cast<T *>(&slots_[i]));
+  }
+
+private:
+  struct Slot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  std::size_t size_ = 0;
+};
+
+inline unsigned pool_thread_id() noexcept {
+  static std::atomic<unsigned> next{0};
+  thread_local const unsigned id = next.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+} // namespace detail
+
+/**
+ * @brief Fixed set of reusable T objects lent out through RAII handles.
+ *
+ * Thread-safe and lock-free, except that acquire_for() sleeps on a
+ * condition variable, which releases only touch while someone waits.
+ * Handles must not outlive the pool. Objects are handed out as they were
+ * returned: reset them before use if that matters.
+ * @code
+ * cpp_result::ObjectPool<Buffer> buffers(256, 64 * 1024);
+ * auto buf = buffers.try_acquire();
+ * if (buf.is_err())
+ *   return Response::Err(Status::Overloaded); // shed load, don't queue
+ * fill(*buf.unwrap());
+ * @endcode
+ */
+template <typename T> class ObjectPool {
+public:
+  /**
+   * @brief Borrowed object; returned to the pool on destruction.
+   */
+  class Handle {
+  public:
+    Handle() noexcept = default;
+    Handle(Handle &&other) noexcept
+        : pool_(std::exchange(other.pool_, nullptr)), index_(other.index_) {}
+    Handle &operator=(Handle &&other) noexcept {
+      if (this != &other) {
+        reset();
+        pool_ = std::exchange(other.pool_, nullptr);
+        index_ = other.index_;
+      }
+      return *this;
+    }
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+    ~Handle() { reset(); }
+
+    T &operator*() const noexcept { return *get(); }
+    T *operator->() const noexcept { return get(); }
+    T *get() const noexcept { return pool_->storage_.get(index_); }
+    explicit operator bool() const noexcept { return pool_ != nullptr; }
+
+    /// Returns the object to the pool early.
+    void reset() noexcept {
+      if (pool_)
+        std::exchange(pool_, nullptr)->release(index_);
+    }
+
+  private:
+    friend class ObjectPool;
+    Handle(ObjectPool *pool, std::uint32_t index) noexcept
+        : pool_(pool), index_(index) {}
+
+    ObjectPool *pool_ = nullptr;
+    std::uint32_t index_ = 0;
+  };
+
+  static constexpr unsigned kStripes = 16;
+
+  /**
+   * @brief Constructs capacity objects, each as T(args...).
+   */
+  template <typename... Args>
+  explicit ObjectPool(std::uint32_t capacity, const Args &...args)
+      : capacity_(std::min(capacity, detail::kPoolNil - 1)),
+        storage_(capacity_), next_(new std::atomic<std::uint32_t>[capacity_]) {
+    for (std::uint32_t i = 0; i < capacity_; ++i) {
+      storage_.emplace(args...);
+      push(i % kStripes, i);
+    }
+  }
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  std::uint32_t capacity() const noexcept { return capacity_; }
+
+  /**
+   * @brief Borrows an object, or fails with Exhausted without waiting.
+   */
+  Result<Handle, PoolError> try_acquire() noexcept {
+    const std::uint32_t i = pop();
+    if (i == detail::kPoolNil)
+      return Result<Handle, PoolError>::Err({PoolError::Kind::Exhausted});
+    return Result<Handle, PoolError>::Ok(Handle(this, i));
+  }
+
+  /**
+   * @brief Borrows an object, waiting up to timeout for one to be returned.
+   */
+  Result<Handle, PoolError>
+  acquire_for(std::chrono::nanoseconds timeout) {
+    std::uint32_t i = pop();
+    if (i != detail::kPoolNil)
+      return Result<Handle, PoolError>::Ok(Handle(this, i));
+    const auto now = std::chrono::steady_clock::now();
+    const auto deadline =
+        timeout >= std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::time_point::max() - now)
+            ? std::chrono::steady_clock::time_point::max()
+            : now + std::chrono::duration_cast<
+                        std::chrono::steady_clock::duration>(timeout);
+
+    // Announce the wait before popping again: release() pushes and then
+    // reads waiters_, all seq_cst (free on x86), so either we see its
+    // object or it sees us and notifies under the mutex.
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    const bool got = returned_.wait_until(lock, deadline, [&] {
+      i = pop();
+      return i != detail::kPoolNil;
+    });
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    if (!got)
+      return Result<Handle, PoolError>::Err({PoolError::Kind::Timeout});
+    return Result<Handle, PoolError>::Ok(Handle(this, i));
+  }
+
+private:
+  static std::uint64_t pack(std::uint64_t tag, std::uint32_t index) noexcept {
+    return (tag << 32) | index;
+  }
+
+  void push(unsigned stripe, std::uint32_t i) noexcept {
+    auto &head = stripes_[stripe].head;
+    std::uint64_t h = head.load(std::memory_order_relaxed);
+    do
+      next_[i].store(static_cast<std::uint32_t>(h), std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(h, pack((h >> 32) + 1, i),
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed));
+  }
+
+  std::uint32_t pop_from(unsigned stripe) noexcept {
+    auto &head = stripes_[stripe].head;
+    std::uint64_t h = head.load(std::memory_order_seq_cst);
+    for (;;) {
+      const auto top = static_cast<std::uint32_t>(h);
+      if (top == detail::kPoolNil)
+        return detail::kPoolNil;
+      // next_[top] may be rewritten by a concurrent pop/push of the same
+      // node; the tag then makes the CAS below fail.
+      const std::uint32_t next = next_[top].load(std::memory_order_relaxed);
+      if (head.compare_exchange_weak(h, pack((h >> 32) + 1, next),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire))
+        return top;
+    }
+  }
+
+  std::uint32_t pop() noexcept {
+    const unsigned home = detail::pool_thread_id() % kStripes;
+    for (unsigned k = 0; k < kStripes; ++k) {
+      const std::uint32_t i = pop_from((home + k) % kStripes);
+      if (i != detail::kPoolNil)
+        return i;
+    }
+    return detail::kPoolNil;
+  }
+
+  void release(std::uint32_t i) noexcept {
+    push(detail::pool_thread_id() % kStripes, i);
+    if (waiters_.load(std::memory_order_seq_cst) != 0) {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      returned_.notify_one();
+    }
+  }
+
+  std::uint32_t capacity_;
+  detail::PoolStorage<T> storage_;
+  std::unique_ptr<std::atomic<std::uint32_t>[]> next_;
+  detail::PoolStripe stripes_[kStripes];
+  std::atomic<std::uint32_t> waiters_{0};
+  std::mutex wait_mutex_;
+  std::condition_variable returned_;
+};
+
+} // namespace cpp_result
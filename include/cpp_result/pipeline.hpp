@@ -0,0 +1,315 @@
+// pipeline.hpp - Streaming record parsing with bounded memory
+// SPDX-License-Identifier: MIT
+//
+// run_pipeline() drives reader -> splitter -> parse -> sinks over an input
+// of delimiter-separated records. Input is processed one fixed-size chunk
+// at a time, so memory stays bounded by the chunk size regardless of the
+// input size. Parsing can be spread over worker threads; sinks always see
+// records in input order. An error budget aborts the run after too many
+// parse errors.
+//
+// --- API OVERVIEW ---
+//
+//   run_pipeline(reader, parse, on_ok, on_err, options)
+//       -> Result<PipelineStats, PipelineError>
+//   reader : (char *buf, std::size_t cap) -> Result<std::size_t, Errno>
+//   parse  : (std::string_view record)    -> Result<R, E>
+//   on_ok  : (R &&value)
+//   on_err : (E &&error, std::size_t record_number)
+//   fd_reader(fd), istream_reader(in), string_reader(text)
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/posix.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cpp_result {
+
+/**
+ * @brief Tuning knobs and error budget for run_pipeline().
+ */
+struct PipelineOptions {
+  /// Bytes read per chunk; also the maximum record length.
+  std::size_t chunk_size = std::size_t{1} << 20;
+  /// Parse threads. 1 parses on the calling thread.
+  unsigned threads = 1;
+  /// Record delimiter.
+  char delimiter = '\n';
+  /// Abort once more than this many records failed to parse.
+  std::size_t max_errors = std::numeric_limits<std::size_t>::max();
+  /// Abort once errors / records exceeds this ratio...
+  double max_error_rate = 1.0;
+  /// ...but only after this many records have been seen.
+  std::size_t min_records_for_rate = 1000;
+};
+
+/**
+ * @brief Counters of a pipeline run.
+ */
+struct PipelineStats {
+  std::size_t records = 0;
+  std::size_t ok = 0;
+  std::size_t errors = 0;
+  std::size_t bytes = 0;
+};
+
+/**
+ * @brief Why a pipeline run stopped early.
+ *
+ * `stats` holds the counters at the point of the abort; every record
+ * counted there has been delivered to a sink.
+ */
+struct PipelineError {
+  enum class Kind : std::uint8_t {
+    Read,          ///< The reader failed; see `error`.
+    ErrorBudget,   ///< max_errors or max_error_rate was exceeded.
+    RecordTooLong, ///< A record did not fit in one chunk.
+  };
+
+  Kind kind;
+  Errno error;
+  PipelineStats stats;
+};
+
+/**
+ * @brief Reader over a file descriptor, retrying on EINTR.
+ */
+inline auto fd_reader(int fd) {
+  return [fd](char *buf, std::size_t cap) {
+    return posix::retry_eintr([&] { return posix::read(fd, buf, cap); });
+  };
+}
+
+/**
+ * @brief Reader over a std::istream. A stream in a bad state reports EIO.
+ */
+inline auto istream_reader(std::istream &in) {
+  return [&in](char *buf, std::size_t cap) {
+    in.read(buf, static_cast<std::streamsize>(cap));
+    if (in.bad())
+      return Result<std::size_t, Errno>::Err(Errno{EIO});
+    return Result<std::size_t, Errno>::Ok(
+        static_cast<std::size_t>(in.gcount()));
+  };
+}
+
+/**
+ * @brief Reader over an in-memory buffer; the text must outlive the run.
+ */
+inline auto string_reader(std::string_view text) {
+  return [text](char *buf, std::size_t cap) mutable {
+    const std::size_t n = std::min(cap, text.size());
+    std::memcpy(buf, text.data(), n);
+    text.remove_prefix(n);
+    return Result<std::size_t, Errno>::Ok(n);
+  };
+}
+
+namespace detail {
+
+// Persistent workers running one indexed task each per generation; the
+// calling thread takes task 0.
+class ParseWorkers {
+public:
+  explicit ParseWorkers(unsigned n) {
+    for (unsigned i = 1; i < n; ++i)
+      threads_.emplace_back([this, i] { loop(i); });
+  }
+  ~ParseWorkers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      ++generation_;
+    }
+    start_.notify_all();
+    for (auto &t : threads_)
+      t.join();
+  }
+  ParseWorkers(const ParseWorkers &) = delete;
+  ParseWorkers &operator=(const ParseWorkers &) = delete;
+
+  void run(const std::function<void(unsigned)> &task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      pending_ = static_cast<unsigned>(threads_.size());
+      ++generation_;
+    }
+    start_.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+private:
+  void loop(unsigned index) {
+    std::uint64_t seen = 0;
+    for (;;) {
+      const std::function<void(unsigned)> *task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_.wait(lock, [&] { return generation_ != seen; });
+        seen = generation_;
+        if (stop_)
+          return;
+        task = task_;
+      }
+      (*task)(index);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0)
+        done_.notify_one();
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  const std::function<void(unsigned)> *task_ = nullptr;
+  std::uint64_t generation_ = 0;
+  unsigned pending_ = 0;
+  bool stop_ = false;
+};
+
+} // namespace detail
+
+/**
+ * @brief Streams records from reader through parse into the sinks.
+ *
+ * Memory use is bounded by `chunk_size` plus the parsed results of one
+ * chunk. A final record without a trailing delimiter is processed; empty
+ * records are passed to parse like any other. With `threads > 1`, parse is
+ * called concurrently and must be thread-safe; the sinks are only called
+ * from the calling thread.
+ *
+ * @code
+ * cpp_result::PipelineOptions opts;
+ * opts.threads = 4;
+ * opts.max_errors = 100;
+ * auto stats = cpp_result::run_pipeline(
+ *     cpp_result::fd_reader(fd),
+ *     [](std::string_view line) { return parse_record(line); },
+ *     [&](Record &&r) { out.push_back(std::move(r)); },
+ *     [&](ParseError &&e, std::size_t line) { log(line, e); }, opts);
+ * @endcode
+ */
+template <typename Reader, typename Parse, typename OkSink, typename ErrSink>
+Result<PipelineStats, PipelineError>
+run_pipeline(Reader &&reader, Parse &&parse, OkSink &&on_ok, ErrSink &&on_err,
+             const PipelineOptions &options = {}) {
+  using Parsed = std::invoke_result_t<Parse &, std::string_view>;
+  using Out = Result<PipelineStats, PipelineError>;
+
+  PipelineStats stats;
+  const std::size_t cap = options.chunk_size > 0 ? options.chunk_size : 1;
+  const unsigned nthreads = options.threads > 0 ? options.threads : 1;
+  std::vector<char> buf(cap);
+  std::vector<std::string_view> records;
+  std::vector<std::vector<Parsed>> parsed(nthreads);
+  std::unique_ptr<detail::ParseWorkers> workers;
+  if (nthreads > 1)
+    workers = std::make_unique<detail::ParseWorkers>(nthreads);
+
+  auto over_budget = [&] {
+    if (stats.errors > options.max_errors)
+      return true;
+    return stats.records >= options.min_records_for_rate &&
+           static_cast<double>(stats.errors) >
+               options.max_error_rate * static_cast<double>(stats.records);
+  };
+
+  auto parse_slice = [&](unsigned slice) {
+    const std::size_t n = records.size();
+    const std::size_t lo = n * slice / nthreads;
+    const std::size_t hi = n * (slice + 1) / nthreads;
+    auto &out = parsed[slice];
+    out.clear();
+    out.reserve(hi - lo);
+    for (std::size_t i = lo; i < hi; ++i)
+      out.push_back(parse(records[i]));
+  };
+  const std::function<void(unsigned)> task = parse_slice;
+
+  // Parses the collected records and delivers them in order. Returns false
+  // when the error budget is exhausted.
+  auto flush = [&]() -> bool {
+    if (workers && records.size() >= nthreads)
+      workers->run(task);
+    else
+      for (unsigned s = 0; s < nthreads; ++s)
+        parse_slice(s);
+    for (auto &slice : parsed) {
+      for (auto &res : slice) {
+        ++stats.records;
+        if (res.is_ok()) {
+          ++stats.ok;
+          on_ok(std::move(res.unwrap()));
+        } else {
+          ++stats.errors;
+          on_err(std::move(res.unwrap_err()), stats.records);
+          if (over_budget())
+            return false;
+        }
+      }
+      slice.clear();
+    }
+    records.clear();
+    return true;
+  };
+
+  std::size_t carry = 0;
+  for (;;) {
+    auto got = reader(buf.data() + carry, cap - carry);
+    if (got.is_err())
+      return Out::Err({PipelineError::Kind::Read, got.unwrap_err(), stats});
+    const std::size_t n = got.unwrap();
+    stats.bytes += n;
+    const std::size_t filled = carry + n;
+    const bool eof = n == 0;
+
+    const char *begin = buf.data();
+    const char *end = begin + filled;
+    const char *pos = begin;
+    while (pos < end) {
+      const void *hit = std::memchr(pos, options.delimiter,
+                                    static_cast<std::size_t>(end - pos));
+      if (!hit)
+        break;
+      const char *stop = static_cast<const char *>(hit);
+      records.emplace_back(pos, static_cast<std::size_t>(stop - pos));
+      pos = stop + 1;
+    }
+    if (eof && pos < end) {
+      records.emplace_back(pos, static_cast<std::size_t>(end - pos));
+      pos = end;
+    }
+    if (!flush())
+      return Out::Err({PipelineError::Kind::ErrorBudget, Errno{0}, stats});
+    if (eof)
+      break;
+
+    carry = static_cast<std::size_t>(end - pos);
+    if (carry == cap)
+      return Out::Err({PipelineError::Kind::RecordTooLong, Errno{0}, stats});
+    std::memmove(buf.data(), pos, carry);
+  }
+  return Out::Ok(stats);
+}
+
+} // namespace cpp_result
@@ -0,0 +1,349 @@
+// poll.hpp - Poll<T, E>: Ready(Ok) / Ready(Err) / Pending
+// SPDX-License-Identifier: MIT
+//
+// Non-blocking operations have a third outcome besides success and
+// failure: not yet (EAGAIN, an empty queue, a partial frame). Poll<T, E>
+// represents it directly instead of as a sentinel error that every caller
+// must copy and test. It is built on Result's storage: the same value /
+// error union and a single discriminant byte, here with three states, so
+// Poll<T, E> is no larger than Result<T, E> and is trivially copyable when
+// T and E are.
+//
+// Combinators act on Ready(Ok) and pass Pending and Err through unchanged.
+// TRY_READY(expr) returns Pending or the error from the enclosing function
+// and otherwise yields the value; TRY_INTO works on Results inside a
+// function returning a Poll.
+//
+// --- API OVERVIEW ---
+//
+//   Poll<T, E>::Ok(v), ::Err(e), ::Pending()
+//   cpp_result::pending              converts to any Poll, like std::nullopt
+//   Poll(result)                     Ready with the Result's contents
+//   is_pending(), is_ready(), is_ok(), is_err()
+//   unwrap(), unwrap_err()           abort on the wrong state
+//   into_result()                    -> Result<T, E>, aborts if Pending
+//   map(fn), map_err(fn), and_then(fn)  Pending passes through; and_then
+//                                    takes fn returning Poll or Result
+//   TRY_READY(expr)                  propagate Pending / Err, yield value
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/// Type of cpp_result::pending.
+struct PendingT {
+  explicit constexpr PendingT(int) noexcept {}
+};
+
+/// Converts to a Pending Poll of any type: `return cpp_result::pending;`
+inline constexpr PendingT pending{0};
+
+template <typename T, typename E> class Poll;
+
+namespace detail {
+
+enum class PollState : std::uint8_t { Pending, Ok, Err };
+
+// Three-state discriminant for ResultStorage: nothing is live while
+// Pending, which is also what a default-constructed Poll holds.
+struct PollTag {
+  PollState state_ = PollState::Pending;
+  void set_ok(bool ok) noexcept {
+    state_ = ok ? PollState::Ok : PollState::Err;
+  }
+  constexpr bool holds_value() const noexcept {
+    return state_ == PollState::Ok;
+  }
+  constexpr bool holds_error() const noexcept {
+    return state_ == PollState::Err;
+  }
+};
+
+template <typename T>
+using poll_value_t = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+template <typename R> struct as_poll;
+template <typename T, typename E> struct as_poll<Poll<T, E>> {
+  using type = Poll<T, E>;
+};
+template <typename T, typename E> struct as_poll<Result<T, E>> {
+  using type = Poll<T, E>;
+};
+
+// Calls f with the value (none for void), forwarding const& or &&.
+template <typename T, typename F, typename V>
+decltype(auto) invoke_value(F &f, V &&value) {
+  if constexpr (std::is_void_v<T>)
+    return f();
+  else
+    return f(std::forward<V>(value));
+}
+
+// The value TRY_READY yields: moved out, or nothing for Poll<void, E>.
+template <typename P> decltype(auto) ready_value(P &p) noexcept {
+  if constexpr (std::is_void_v<typename std::decay_t<P>::value_type>)
+    return p.unwrap();
+  else
+    return std::move(p.unwrap());
+}
+
+} // namespace detail
+
+/**
+ * @brief The state of a non-blocking operation: Ready(Ok(T)),
+ * Ready(Err(E)) or Pending.
+ *
+ * @code
+ * Poll<Frame, Errno> poll_frame(Conn &c) {
+ *   std::size_t n = TRY_READY(c.poll_read());    // Pending / Err return here
+ *   if (!c.buffer.has_frame())
+ *     return cpp_result::pending;
+ *   return Poll<Frame, Errno>::Ok(c.buffer.take_frame());
+ * }
+ * @endcode
+ */
+template <typename T, typename E>
+class [[nodiscard]] Poll
+    : private detail::ResultStorage<detail::poll_value_t<T>, E,
+                                    detail::PollTag> {
+  static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>,
+                "Poll<T,E> does not support reference types");
+
+  using V = detail::poll_value_t<T>;
+  using Storage = detail::ResultStorage<V, E, detail::PollTag>;
+  using Storage::data_;
+  using Storage::state_;
+  using State = detail::PollState;
+
+  template <typename, typename> friend class Poll;
+
+  explicit Poll(detail::OkTag tag, V &&v) noexcept(
+      std::is_nothrow_move_constructible_v<V>)
+      : Storage(tag, std::move(v)) {}
+  explicit Poll(detail::OkTag tag, const V &v) noexcept(
+      std::is_nothrow_copy_constructible_v<V>)
+      : Storage(tag, v) {}
+  template <typename U>
+  explicit Poll(detail::ErrTag tag, U &&e) noexcept(
+      std::is_nothrow_constructible_v<E, U &&>)
+      : Storage(tag, std::forward<U>(e)) {}
+
+  // map/map_err/and_then for both const& and &&.
+  template <typename Self, typename F>
+  static auto map_impl(Self &&self, F &f) {
+    using U = std::decay_t<decltype(detail::invoke_value<T>(
+        f, std::forward<Self>(self).data_.value))>;
+    using P = Poll<U, E>;
+    if (self.state_ == State::Ok) {
+      if constexpr (std::is_void_v<U>) {
+        detail::invoke_value<T>(f, std::forward<Self>(self).data_.value);
+        return P::Ok();
+      } else {
+        return P::Ok(
+            detail::invoke_value<T>(f, std::forward<Self>(self).data_.value));
+      }
+    }
+    if (self.state_ == State::Err)
+      return P(detail::ErrTag{}, std::forward<Self>(self).data_.error);
+    return P();
+  }
+
+  template <typename Self, typename F>
+  static auto map_err_impl(Self &&self, F &f) {
+    using E2 = std::decay_t<decltype(f(std::forward<Self>(self).data_.error))>;
+    using P = Poll<T, E2>;
+    if (self.state_ == State::Ok)
+      return P(detail::OkTag{}, std::forward<Self>(self).data_.value);
+    if (self.state_ == State::Err)
+      return P(detail::ErrTag{}, f(std::forward<Self>(self).data_.error));
+    return P();
+  }
+
+  template <typename Self, typename F>
+  static auto and_then_impl(Self &&self, F &f) {
+    using R = std::decay_t<decltype(detail::invoke_value<T>(
+        f, std::forward<Self>(self).data_.value))>;
+    using P = typename detail::as_poll<R>::type;
+    if (self.state_ == State::Ok)
+      return P(
+          detail::invoke_value<T>(f, std::forward<Self>(self).data_.value));
+    if (self.state_ == State::Err)
+      return P(detail::ErrTag{}, std::forward<Self>(self).data_.error);
+    return P();
+  }
+
+public:
+  using value_type = T;
+  using error_type = E;
+
+  /// Pending.
+  Poll() noexcept = default;
+  Poll(PendingT) noexcept {}
+
+  /// Ready with the contents of a Result.
+  Poll(Result<T, E> &&r) noexcept(std::is_nothrow_move_constructible_v<V> &&
+                                  std::is_nothrow_move_constructible_v<E>) {
+    if (r.is_err()) {
+      new (&data_.error) E(std::move(r.unwrap_err()));
+      state_ = State::Err;
+      return;
+    }
+    if constexpr (std::is_void_v<T>)
+      new (&data_.value) V{};
+    else
+      new (&data_.value) V(std::move(r.unwrap()));
+    state_ = State::Ok;
+  }
+  Poll(const Result<T, E> &r) : Poll(Result<T, E>(r)) {}
+
+  /**
+   * @brief Converts the error returned by TRY_INTO/TRY_READY into a
+   * Ready(Err).
+   */
+  template <typename Ref,
+            std::enable_if_t<std::is_constructible_v<E, Ref>, int> = 0>
+  Poll(detail::Propagated<Ref> &&p) noexcept(
+      std::is_nothrow_constructible_v<E, Ref>)
+      : Storage(detail::ErrTag{}, std::forward<Ref>(p.error)) {}
+
+  static Poll Pending() noexcept { return Poll(); }
+
+  static Poll Ok(const V &val) { return Poll(detail::OkTag{}, val); }
+  static Poll Ok(V &&val) { return Poll(detail::OkTag{}, std::move(val)); }
+  template <typename U = T, std::enable_if_t<std::is_void_v<U>, int> = 0>
+  static Poll Ok() noexcept {
+    return Poll(detail::OkTag{}, V{});
+  }
+
+  static Poll Err(const E &err) { return Poll(detail::ErrTag{}, err); }
+  static Poll Err(E &&err) { return Poll(detail::ErrTag{}, std::move(err)); }
+
+  constexpr bool is_pending() const noexcept {
+    return state_ == State::Pending;
+  }
+  constexpr bool is_ready() const noexcept { return !is_pending(); }
+  constexpr bool is_ok() const noexcept { return state_ == State::Ok; }
+  constexpr bool is_err() const noexcept { return state_ == State::Err; }
+
+  /**
+   * @brief The Ok value. Aborts if Pending or Err.
+   */
+  template <typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+  U &unwrap() & noexcept {
+    EXPECT_OR_ABORT(is_ok(), "Called unwrap on a Poll that is not Ok");
+    return data_.value;
+  }
+  template <typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+  const U &unwrap() const & noexcept {
+    EXPECT_OR_ABORT(is_ok(), "Called unwrap on a Poll that is not Ok");
+    return data_.value;
+  }
+  template <typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+  U &&unwrap() && noexcept {
+    EXPECT_OR_ABORT(is_ok(), "Called unwrap on a Poll that is not Ok");
+    return std::move(data_.value);
+  }
+  template <typename U = T, std::enable_if_t<std::is_void_v<U>, int> = 0>
+  void unwrap() const & noexcept {
+    EXPECT_OR_ABORT(is_ok(), "Called unwrap on a Poll that is not Ok");
+  }
+
+  /**
+   * @brief The error. Aborts if Pending or Ok.
+   */
+  E &unwrap_err() & noexcept {
+    EXPECT_OR_ABORT(is_err(), "Called unwrap_err on a Poll that is not Err");
+    return data_.error;
+  }
+  const E &unwrap_err() const & noexcept {
+    EXPECT_OR_ABORT(is_err(), "Called unwrap_err on a Poll that is not Err");
+    return data_.error;
+  }
+  E &&unwrap_err() && noexcept {
+    EXPECT_OR_ABORT(is_err(), "Called unwrap_err on a Poll that is not Err");
+    return std::move(data_.error);
+  }
+
+  /**
+   * @brief The ready Result. Aborts if Pending.
+   * @code
+   * if (p.is_ready())
+   *   handle(std::move(p).into_result());
+   * @endcode
+   */
+  Result<T, E> into_result() && {
+    EXPECT_OR_ABORT(is_ready(), "Called into_result on a pending Poll");
+    if (is_err())
+      return Result<T, E>::Err(std::move(data_.error));
+    if constexpr (std::is_void_v<T>)
+      return Result<T, E>::Ok();
+    else
+      return Result<T, E>::Ok(std::move(data_.value));
+  }
+  Result<T, E> into_result() const & { return Poll(*this).into_result(); }
+
+  /**
+   * @brief Maps the value if Ready(Ok); Pending and Err pass through.
+   * @code
+   * auto len = poll_frame(c).map([](const Frame &f) { return f.size(); });
+   * @endcode
+   */
+  template <typename F> auto map(F &&func) const & {
+    return map_impl(*this, func);
+  }
+  template <typename F> auto map(F &&func) && {
+    return map_impl(std::move(*this), func);
+  }
+
+  /// Maps the error if Ready(Err); Pending and Ok pass through.
+  template <typename F> auto map_err(F &&func) const & {
+    return map_err_impl(*this, func);
+  }
+  template <typename F> auto map_err(F &&func) && {
+    return map_err_impl(std::move(*this), func);
+  }
+
+  /**
+   * @brief Chains func(value), which returns a Poll or a Result with the
+   * same error type, if Ready(Ok); Pending and Err pass through.
+   */
+  template <typename F> auto and_then(F &&func) const & {
+    return and_then_impl(*this, func);
+  }
+  template <typename F> auto and_then(F &&func) && {
+    return and_then_impl(std::move(*this), func);
+  }
+};
+
+// clang-format off
+/**
+ * @def TRY_READY(expr)
+ * @brief Propagates Pending and errors from a Poll and yields its value.
+ *
+ * Evaluates `expr` (a Poll). If it is Pending, returns cpp_result::pending
+ * from the current function, which must return a Poll; if it is Err,
+ * returns the error as TRY_INTO does. Otherwise yields the value.
+ *
+ * @note This implementation needs your compiler support statement expressions.
+ */
+// clang-format on
+#if CPP_RESULT_HAS_STATEMENT_EXPR
+#define TRY_READY(expr)                                                        \
+  ({                                                                           \
+    auto &&__poll = (expr);                                                    \
+    if (__poll.is_pending())                                                   \
+      return ::cpp_result::pending;                                            \
+    if (__poll.is_err())                                                       \
+      return ::cpp_result::detail::propagate_into<decltype(__poll)>(__poll);   \
+    ::cpp_result::detail::ready_value(__poll);                                 \
+  })
+#endif
+
+} // namespace cpp_result
@@ -0,0 +1,405 @@
+// posix.hpp - POSIX system call wrappers returning Result<T, Errno>
+// SPDX-License-Identifier: MIT
+//
+// Thin inline wrappers over the POSIX file APIs. Each call maps the
+// `-1`/`errno` convention to Result<T, Errno>; Errno is a trivially copyable
+// int wrapper, so Result<std::size_t, Errno> fits in two registers.
+//
+// --- API OVERVIEW ---
+//
+// Wrappers (namespace cpp_result::posix):
+//   open, close, read, write, pread, pwrite, readv, writev, preadv, pwritev,
+//   lseek, fstat, ftruncate, fsync, fdatasync, mmap, munmap, madvise, pipe
+//
+// Helpers:
+//   retry_eintr(fn)                 re-invokes fn while it fails with EINTR
+//   read_full, write_full,
+//   pread_full, pwrite_full         complete short reads/writes and
+//                                   report progress on error
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace cpp_result {
+
+/**
+ * @brief An `errno` value captured from a failed system call.
+ *
+ * @code
+ * auto r = cpp_result::posix::open("/missing", O_RDONLY);
+ * if (r.is_err() && r.unwrap_err() == ENOENT) {  ...  }
+ * @endcode
+ */
+struct Errno {
+  int code;
+
+  /**
+   * @brief Captures the calling thread's current `errno`.
+   */
+  static Errno last() noexcept { return Errno{errno}; }
+
+  /**
+   * @brief Returns the system description of the error.
+   * @note Uses std::strerror; the returned string may be overwritten by a
+   * later call from another thread.
+   */
+  const char *message() const noexcept { return std::strerror(code); }
+
+  bool operator==(const Errno &other) const noexcept {
+    return code == other.code;
+  }
+  bool operator!=(const Errno &other) const noexcept {
+    return code != other.code;
+  }
+  bool operator==(int other) const noexcept { return code == other; }
+  bool operator!=(int other) const noexcept { return code != other; }
+};
+
+static_assert(std::is_trivially_copyable_v<Errno>,
+              "Errno must stay trivially copyable");
+
+namespace posix {
+
+namespace detail {
+// Maps a `-1`/errno return value to Result<R, Errno>.
+template <typename R, typename Ret> inline Result<R, Errno> check(Ret ret) {
+  if (ret == static_cast<Ret>(-1))
+    return Result<R, Errno>::Err(Errno::last());
+  return Result<R, Errno>::Ok(static_cast<R>(ret));
+}
+
+inline Result<void, Errno> check_void(int ret) {
+  if (ret == -1)
+    return Result<void, Errno>::Err(Errno::last());
+  return Result<void, Errno>::Ok();
+}
+} // namespace detail
+
+/**
+ * @brief open(2). Returns the new file descriptor.
+ * @code
+ * auto fd = cpp_result::posix::open("data.bin", O_RDONLY | O_CLOEXEC);
+ * @endcode
+ */
+inline Result<int, Errno> open(const char *path, int flags,
+                               mode_t mode = 0) noexcept {
+  return detail::check<int>(::open(path, flags, mode));
+}
+
+/**
+ * @brief close(2).
+ * @note Never retry close() on EINTR on Linux: the descriptor is released.
+ */
+inline Result<void, Errno> close(int fd) noexcept {
+  return detail::check_void(::close(fd));
+}
+
+/**
+ * @brief read(2). Returns the number of bytes read (0 at end of file).
+ */
+inline Result<std::size_t, Errno> read(int fd, void *buf,
+                                       std::size_t count) noexcept {
+  return detail::check<std::size_t>(::read(fd, buf, count));
+}
+
+/**
+ * @brief write(2). Returns the number of bytes written.
+ */
+inline Result<std::size_t, Errno> write(int fd, const void *buf,
+                                        std::size_t count) noexcept {
+  return detail::check<std::size_t>(::write(fd, buf, count));
+}
+
+/**
+ * @brief pread(2). Returns the number of bytes read (0 at end of file).
+ */
+inline Result<std::size_t, Errno> pread(int fd, void *buf, std::size_t count,
+                                        off_t offset) noexcept {
+  return detail::check<std::size_t>(::pread(fd, buf, count, offset));
+}
+
+/**
+ * @brief pwrite(2). Returns the number of bytes written.
+ */
+inline Result<std::size_t, Errno> pwrite(int fd, const void *buf,
+                                         std::size_t count,
+                                         off_t offset) noexcept {
+  return detail::check<std::size_t>(::pwrite(fd, buf, count, offset));
+}
+
+/**
+ * @brief readv(2). Returns the total number of bytes read.
+ */
+inline Result<std::size_t, Errno> readv(int fd, const iovec *iov,
+                                        int iovcnt) noexcept {
+  return detail::check<std::size_t>(::readv(fd, iov, iovcnt));
+}
+
+/**
+ * @brief writev(2). Returns the total number of bytes written.
+ */
+inline Result<std::size_t, Errno> writev(int fd, const iovec *iov,
+                                         int iovcnt) noexcept {
+  return detail::check<std::size_t>(::writev(fd, iov, iovcnt));
+}
+
+/**
+ * @brief preadv(2). Returns the total number of bytes read.
+ */
+inline Result<std::size_t, Errno> preadv(int fd, const iovec *iov, int iovcnt,
+                                         off_t offset) noexcept {
+  return detail::check<std::size_t>(::preadv(fd, iov, iovcnt, offset));
+}
+
+/**
+ * @brief pwritev(2). Returns the total number of bytes written.
+ */
+inline Result<std::size_t, Errno> pwritev(int fd, const iovec *iov,
+                                          int iovcnt, off_t offset) noexcept {
+  return detail::check<std::size_t>(::pwritev(fd, iov, iovcnt, offset));
+}
+
+/**
+ * @brief lseek(2). Returns the resulting offset.
+ */
+inline Result<off_t, Errno> lseek(int fd, off_t offset, int whence) noexcept {
+  return detail::check<off_t>(::lseek(fd, offset, whence));
+}
+
+/**
+ * @brief fstat(2).
+ * @code
+ * auto size = cpp_result::posix::fstat(fd).map(
+ *     [](const struct stat &st) { return st.st_size; });
+ * @endcode
+ */
+inline Result<struct stat, Errno> fstat(int fd) noexcept {
+  struct stat st;
+  if (::fstat(fd, &st) == -1)
+    return Result<struct stat, Errno>::Err(Errno::last());
+  return Result<struct stat, Errno>::Ok(st);
+}
+
+/**
+ * @brief ftruncate(2).
+ */
+inline Result<void, Errno> ftruncate(int fd, off_t length) noexcept {
+  return detail::check_void(::ftruncate(fd, length));
+}
+
+/**
+ * @brief fsync(2).
+ */
+inline Result<void, Errno> fsync(int fd) noexcept {
+  return detail::check_void(::fsync(fd));
+}
+
+/**
+ * @brief fdatasync(2).
+ */
+inline Result<void, Errno> fdatasync(int fd) noexcept {
+  return detail::check_void(::fdatasync(fd));
+}
+
+/**
+ * @brief mmap(2). Returns the mapped address.
+ */
+inline Result<void *, Errno> mmap(void *addr, std::size_t length, int prot,
+                                  int flags, int fd, off_t offset) noexcept {
+  void *p = ::mmap(addr, length, prot, flags, fd, offset);
+  if (p == MAP_FAILED)
+    return Result<void *, Errno>::Err(Errno::last());
+  return Result<void *, Errno>::Ok(p);
+}
+
+/**
+ * @brief munmap(2).
+ */
+inline Result<void, Errno> munmap(void *addr, std::size_t length) noexcept {
+  return detail::check_void(::munmap(addr, length));
+}
+
+/**
+ * @brief madvise(2).
+ */
+inline Result<void, Errno> madvise(void *addr, std::size_t length,
+                                   int advice) noexcept {
+  return detail::check_void(::madvise(addr, length, advice));
+}
+
+/**
+ * @brief A pair of file descriptors returned by pipe().
+ */
+struct PipeFds {
+  int read_end;
+  int write_end;
+};
+
+/**
+ * @brief pipe2(2) where available, pipe(2) otherwise.
+ */
+inline Result<PipeFds, Errno> pipe(int flags = 0) noexcept {
+  int fds[2];
+#if defined(__linux__)
+  int ret = ::pipe2(fds, flags);
+#else
+  (void)flags;
+  int ret = ::pipe(fds);
+#endif
+  if (ret == -1)
+    return Result<PipeFds, Errno>::Err(Errno::last());
+  return Result<PipeFds, Errno>::Ok(PipeFds{fds[0], fds[1]});
+}
+
+/**
+ * @brief Invokes func() again for as long as it fails with EINTR.
+ * @code
+ * auto n = cpp_result::posix::retry_eintr(
+ *     [&] { return cpp_result::posix::read(fd, buf, sizeof(buf)); });
+ * @endcode
+ */
+template <typename F> inline auto retry_eintr(F &&func) {
+  for (;;) {
+    auto res = func();
+    if (res.is_ok() || res.unwrap_err() != EINTR)
+      return res;
+  }
+}
+
+/**
+ * @brief Reads until count bytes are read or end of file is reached,
+ * retrying on EINTR. Returns the number of bytes read.
+ *
+ * On error the bytes already read into buf are lost from the Result; pass
+ * `read` to receive their count (e.g. to resume after EAGAIN).
+ * @code
+ * std::size_t got = 0;
+ * auto r = cpp_result::posix::read_full(fd, buf, len, &got);
+ * if (r.is_err() && r.unwrap_err() == EAGAIN)
+ *   wait_readable_then_resume(buf + got, len - got);
+ * @endcode
+ */
+inline Result<std::size_t, Errno>
+read_full(int fd, void *buf, std::size_t count,
+          std::size_t *read = nullptr) noexcept {
+  auto *p = static_cast<char *>(buf);
+  std::size_t done = 0;
+  Result<std::size_t, Errno> res = Result<std::size_t, Errno>::Ok(0);
+  while (done < count) {
+    res = retry_eintr(
+        [&] { return posix::read(fd, p + done, count - done); });
+    if (res.is_err() || res.unwrap() == 0)
+      break;
+    done += res.unwrap();
+  }
+  if (read)
+    *read = done;
+  if (res.is_err())
+    return res;
+  return Result<std::size_t, Errno>::Ok(done);
+}
+
+/**
+ * @brief Writes all count bytes, retrying on EINTR and short writes.
+ *
+ * A write(2) that makes no progress is reported as EIO. On error the
+ * bytes written before it are lost from the Result; pass `written` to
+ * receive them (e.g. to resume after EAGAIN on a non-blocking fd).
+ * @code
+ * std::size_t sent = 0;
+ * auto r = cpp_result::posix::write_full(fd, buf, len, &sent);
+ * if (r.is_err() && r.unwrap_err() == EAGAIN)
+ *   queue_rest(buf + sent, len - sent);
+ * @endcode
+ */
+inline Result<std::size_t, Errno>
+write_full(int fd, const void *buf, std::size_t count,
+           std::size_t *written = nullptr) noexcept {
+  const auto *p = static_cast<const char *>(buf);
+  std::size_t done = 0;
+  Result<std::size_t, Errno> res = Result<std::size_t, Errno>::Ok(0);
+  while (done < count) {
+    res = retry_eintr([&] { return write(fd, p + done, count - done); });
+    if (res.is_ok() && res.unwrap() == 0)
+      res = Result<std::size_t, Errno>::Err(Errno{EIO});
+    if (res.is_err())
+      break;
+    done += res.unwrap();
+  }
+  if (written)
+    *written = done;
+  if (res.is_err())
+    return res;
+  return Result<std::size_t, Errno>::Ok(done);
+}
+
+/**
+ * @brief Positional read_full(): reads count bytes starting at offset, or
+ * up to end of file; `read`, if given, receives the bytes read also on
+ * error.
+ */
+inline Result<std::size_t, Errno>
+pread_full(int fd, void *buf, std::size_t count, off_t offset,
+           std::size_t *read = nullptr) noexcept {
+  auto *p = static_cast<char *>(buf);
+  std::size_t done = 0;
+  Result<std::size_t, Errno> res = Result<std::size_t, Errno>::Ok(0);
+  while (done < count) {
+    res = retry_eintr([&] {
+      return pread(fd, p + done, count - done,
+                   offset + static_cast<off_t>(done));
+    });
+    if (res.is_err() || res.unwrap() == 0)
+      break;
+    done += res.unwrap();
+  }
+  if (read)
+    *read = done;
+  if (res.is_err())
+    return res;
+  return Result<std::size_t, Errno>::Ok(done);
+}
+
+/**
+ * @brief Positional write_full(): writes all count bytes starting at
+ * offset. A call that makes no progress is EIO; `written`, if given,
+ * receives the bytes written also on error.
+ */
+inline Result<std::size_t, Errno>
+pwrite_full(int fd, const void *buf, std::size_t count, off_t offset,
+            std::size_t *written = nullptr) noexcept {
+  const auto *p = static_cast<const char *>(buf);
+  std::size_t done = 0;
+  Result<std::size_t, Errno> res = Result<std::size_t, Errno>::Ok(0);
+  while (done < count) {
+    res = retry_eintr([&] {
+      return pwrite(fd, p + done, count - done,
+                    offset + static_cast<off_t>(done));
+    });
+    if (res.is_ok() && res.unwrap() == 0)
+      res = Result<std::size_t, Errno>::Err(Errno{EIO});
+    if (res.is_err())
+      break;
+    done += res.unwrap();
+  }
+  if (written)
+    *written = done;
+  if (res.is_err())
+    return res;
+  return Result<std::size_t, Errno>::Ok(done);
+}
+
+} // namespace posix
+} // namespace cpp_result
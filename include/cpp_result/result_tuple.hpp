@@ -0,0 +1,383 @@
+// result_tuple.hpp - Several Results sharing one discriminant word
+// SPDX-License-Identifier: MIT
+//
+// A struct holding N Results pays for N discriminant bools, each padded to
+// the payload's alignment: sixteen Result<std::uint32_t, ErrCode> fields
+// take 128 bytes. ResultTuple<R1, ..., RN> keeps the N discriminants as
+// bits of one header word (8 to 64 bits, chosen from N) and the payloads
+// back to back, each slot as large as the bigger of its T and E: the same
+// sixteen fields take 68 bytes. all_ok() is one compare of the header.
+//
+// Elements are read through ResultRef, a non-owning Result-like handle,
+// or copied out with to_result<I>(). The tuple is trivially copyable when
+// every payload is.
+//
+// --- API OVERVIEW ---
+//
+//   ResultTuple<Rs...>(rs...)        N <= 64 Results, none Result<void, E>
+//   get<I>()                         -> ResultRef<T, E>
+//   to_result<I>()                   -> Result<T, E>
+//   is_ok<I>(), set<I>(r), set_ok<I>(v), set_err<I>(e)
+//   all_ok(), ok_bits(), first_err() (index, or size() if none)
+//   ResultRef<T, E>                  is_ok(), is_err(), unwrap(),
+//                                    unwrap_err(), unwrap_or(v),
+//                                    to_result()
+
+#pragma once
+
+#include <result.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/**
+ * @brief Read-only view of one element of a ResultTuple.
+ *
+ * Valid while the tuple is alive and the element is not reassigned.
+ */
+template <typename T, typename E> class ResultRef {
+public:
+  bool is_ok() const noexcept { return ok_; }
+  bool is_err() const noexcept { return !ok_; }
+
+  const T &unwrap() const noexcept {
+    EXPECT_OR_ABORT(ok_, "unwrap called on Result::Err()");
+    return *value();
+  }
+  const E &unwrap_err() const noexcept {
+    EXPECT_OR_ABORT(!ok_, "unwrap_err called on Result::Ok()");
+    return *error();
+  }
+  T unwrap_or(T default_value) const {
+    return ok_ ? *value() : std::move(default_value);
+  }
+
+  /// Copies the element into a standalone Result.
+  Result<T, E> to_result() const {
+    if (ok_)
+      return Result<T, E>::Ok(*value());
+    return Result<T, E>::Err(*error());
+  }
+
+private:
+  template <typename...> friend class ResultTuple;
+  ResultRef(const void *slot, bool ok) noexcept : slot_(slot), ok_(ok) {}
+
+  const T *value() const noexcept {
+    return std::launder(static_cast<const T *>(slot_));
+  }
+  const E *error() const noexcept {
+    return std::launder(static_cast<const E *>(slot_));
+  }
+
+  const void *slot_;
+  bool ok_;
+};
+
+namespace detail {
+
+template <typename R> struct tuple_result;
+template <typename T, typename E> struct tuple_result<Result<T, E>> {
+  using value_type = T;
+  using error_type = E;
+};
+template <typename E> struct tuple_result<Result<void, E>>; // unsupported
+
+template <std::size_t N>
+using tuple_mask_t = std::conditional_t<
+    (N <= 8), std::uint8_t,
+    std::conditional_t<(N <= 16), std::uint16_t,
+                       std::conditional_t<(N <= 32), std::uint32_t,
+                                          std::uint64_t>>>;
+
+// Byte offsets of the payload slots, in declaration order, each aligned
+// for both of its types.
+template <typename... Rs> struct TupleLayout {
+  static constexpr std::size_t count = sizeof...(Rs);
+  static constexpr std::size_t sizes[count] = {
+      (sizeof(typename tuple_result<Rs>::value_type) >
+               sizeof(typename tuple_result<Rs>::error_type)
+           ? sizeof(typename tuple_result<Rs>::value_type)
+           : sizeof(typename tuple_result<Rs>::error_type))...};
+  static constexpr std::size_t aligns[count] = {
+      (alignof(typename tuple_result<Rs>::value_type) >
+               alignof(typename tuple_result<Rs>::error_type)
+           ? alignof(typename tuple_result<Rs>::value_type)
+           : alignof(typename tuple_result<Rs>::error_type))...};
+
+  static constexpr std::array<std::size_t, count> offsets() {
+    std::array<std::size_t, count> out{};
+    std::size_t at = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      at = (at + aligns[i] - 1) / aligns[i] * aligns[i];
+      out[i] = at;
+      at += sizes[i];
+    }
+    return out;
+  }
+  static constexpr std::size_t size() {
+    return offsets()[count - 1] + sizes[count - 1];
+  }
+  static constexpr std::size_t align() {
+    std::size_t a = 1;
+    for (std::size_t i = 0; i < count; ++i)
+      a = aligns[i] > a ? aligns[i] : a;
+    return a;
+  }
+};
+
+template <typename... Rs>
+constexpr bool tuple_trivial_v =
+    (... && (std::is_trivially_copyable_v<
+                 typename tuple_result<Rs>::value_type> &&
+             std::is_trivially_copyable_v<
+                 typename tuple_result<Rs>::error_type>));
+
+// Raw payload bytes and the ok bits; the special members are trivial when
+// every payload is trivially copyable, as for ResultStorage.
+template <bool Trivial, typename... Rs> struct ResultTupleStorage {
+  using Layout = TupleLayout<Rs...>;
+  alignas(Layout::align()) unsigned char bytes_[Layout::size()];
+  tuple_mask_t<sizeof...(Rs)> ok_bits_;
+};
+
+template <typename... Rs> struct ResultTupleStorage<false, Rs...> {
+  using Layout = TupleLayout<Rs...>;
+  alignas(Layout::align()) unsigned char bytes_[Layout::size()];
+  tuple_mask_t<sizeof...(Rs)> ok_bits_;
+
+  ResultTupleStorage() = default;
+  ResultTupleStorage(const ResultTupleStorage &other) : ok_bits_(0) {
+    copy_from(other, std::index_sequence_for<Rs...>{});
+  }
+  ResultTupleStorage(ResultTupleStorage &&other) noexcept(
+      (... && (std::is_nothrow_move_constructible_v<
+                   typename tuple_result<Rs>::value_type> &&
+               std::is_nothrow_move_constructible_v<
+                   typename tuple_result<Rs>::error_type>)))
+      : ok_bits_(0) {
+    move_from(other, std::index_sequence_for<Rs...>{});
+  }
+  ResultTupleStorage &operator=(const ResultTupleStorage &other) {
+    if (this != &other) {
+      destroy(std::index_sequence_for<Rs...>{});
+      copy_from(other, std::index_sequence_for<Rs...>{});
+    }
+    return *this;
+  }
+  ResultTupleStorage &operator=(ResultTupleStorage &&other) noexcept(
+      std::is_nothrow_move_constructible_v<ResultTupleStorage>) {
+    if (this != &other) {
+      destroy(std::index_sequence_for<Rs...>{});
+      move_from(other, std::index_sequence_for<Rs...>{});
+    }
+    return *this;
+  }
+  ~ResultTupleStorage() { destroy(std::index_sequence_for<Rs...>{}); }
+
+  template <std::size_t I> void *slot() noexcept {
+    return bytes_ + Layout::offsets()[I];
+  }
+  template <std::size_t I> const void *slot() const noexcept {
+    return bytes_ + Layout::offsets()[I];
+  }
+  template <std::size_t I> bool ok_at() const noexcept {
+    return (ok_bits_ >> I) & 1u;
+  }
+
+  template <std::size_t I, typename Src>
+  void construct_from(Src &&src, bool ok) {
+    using R = std::tuple_element_t<I, std::tuple<Rs...>>;
+    using T = typename tuple_result<R>::value_type;
+    using E = typename tuple_result<R>::error_type;
+    using V = std::conditional_t<std::is_lvalue_reference_v<Src>, const void *,
+                                 void *>;
+    V from = src.template slot<I>();
+    if (ok) {
+      if constexpr (std::is_lvalue_reference_v<Src>)
+        new (slot<I>()) T(*std::launder(static_cast<const T *>(from)));
+      else
+        new (slot<I>()) T(std::move(*std::launder(static_cast<T *>(from))));
+    } else {
+      if constexpr (std::is_lvalue_reference_v<Src>)
+        new (slot<I>()) E(*std::launder(static_cast<const E *>(from)));
+      else
+        new (slot<I>()) E(std::move(*std::launder(static_cast<E *>(from))));
+    }
+  }
+
+  template <std::size_t... I>
+  void copy_from(const ResultTupleStorage &other, std::index_sequence<I...>) {
+    (construct_from<I>(other, other.template ok_at<I>()), ...);
+    ok_bits_ = other.ok_bits_;
+  }
+  template <std::size_t... I>
+  void move_from(ResultTupleStorage &other, std::index_sequence<I...>) {
+    (construct_from<I>(std::move(other), other.template ok_at<I>()), ...);
+    ok_bits_ = other.ok_bits_;
+  }
+
+  template <std::size_t I> void destroy_at() noexcept {
+    using R = std::tuple_element_t<I, std::tuple<Rs...>>;
+    using T = typename tuple_result<R>::value_type;
+    using E = typename tuple_result<R>::error_type;
+    if (ok_at<I>())
+      std::launder(static_cast<T *>(slot<I>()))->~T();
+    else
+      std::launder(static_cast<E *>(slot<I>()))->~E();
+  }
+  template <std::size_t... I> void destroy(std::index_sequence<I...>) noexcept {
+    (destroy_at<I>(), ...);
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief N Results stored with one header word of ok bits and the payloads
+ * packed back to back.
+ * @code
+ * using Field = Result<std::uint32_t, ErrCode>;
+ * ResultTuple<Field, Field, Field> rec(parse_id(a), parse_port(b),
+ *                                      parse_ttl(c));
+ * if (!rec.all_ok())
+ *   log_invalid_field(rec.first_err());
+ * else
+ *   std::uint32_t port = rec.get<1>().unwrap();
+ * @endcode
+ */
+template <typename... Rs>
+class ResultTuple
+    : private detail::ResultTupleStorage<detail::tuple_trivial_v<Rs...>,
+                                         Rs...> {
+  static_assert(sizeof...(Rs) > 0 && sizeof...(Rs) <= 64,
+                "ResultTuple holds 1 to 64 Results");
+  // Construction moves each payload into place and must not stop halfway.
+  static_assert(
+      (... && (std::is_nothrow_move_constructible_v<
+                   typename detail::tuple_result<Rs>::value_type> &&
+               std::is_nothrow_move_constructible_v<
+                   typename detail::tuple_result<Rs>::error_type>)),
+      "ResultTuple payloads must be nothrow move constructible");
+
+  using Storage =
+      detail::ResultTupleStorage<detail::tuple_trivial_v<Rs...>, Rs...>;
+  using Layout = detail::TupleLayout<Rs...>;
+  using Mask = detail::tuple_mask_t<sizeof...(Rs)>;
+  using Storage::bytes_;
+  using Storage::ok_bits_;
+
+  template <std::size_t I>
+  using R_ = std::tuple_element_t<I, std::tuple<Rs...>>;
+  template <std::size_t I>
+  using T_ = typename detail::tuple_result<R_<I>>::value_type;
+  template <std::size_t I>
+  using E_ = typename detail::tuple_result<R_<I>>::error_type;
+
+  static constexpr Mask kAllOk =
+      sizeof...(Rs) == 64 ? static_cast<Mask>(~Mask{0})
+                          : static_cast<Mask>((std::uint64_t{1}
+                                               << (sizeof...(Rs) % 64)) -
+                                              1);
+
+public:
+  /// Moves each Result into its slot.
+  explicit ResultTuple(Rs... results) {
+    ok_bits_ = 0;
+    init(std::index_sequence_for<Rs...>{}, std::move(results)...);
+  }
+
+  static constexpr std::size_t size() noexcept { return sizeof...(Rs); }
+
+  /// True when every element is Ok: one compare of the header word.
+  bool all_ok() const noexcept { return ok_bits_ == kAllOk; }
+
+  /// Bit I is set when element I is Ok.
+  Mask ok_bits() const noexcept { return ok_bits_; }
+
+  /// Index of the first Err element, or size() when all are Ok.
+  std::size_t first_err() const noexcept {
+    const std::uint64_t errs = ~std::uint64_t{ok_bits_} & kAllOk;
+    if (errs == 0)
+      return size();
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(errs));
+#else
+    std::size_t i = 0;
+    while (!((errs >> i) & 1u))
+      ++i;
+    return i;
+#endif
+  }
+
+  template <std::size_t I> bool is_ok() const noexcept {
+    return (ok_bits_ >> I) & 1u;
+  }
+
+  /// View of element I; no copy.
+  template <std::size_t I> ResultRef<T_<I>, E_<I>> get() const noexcept {
+    return ResultRef<T_<I>, E_<I>>(slot<I>(), is_ok<I>());
+  }
+
+  /// Copy of element I as a standalone Result.
+  template <std::size_t I> R_<I> to_result() const {
+    return get<I>().to_result();
+  }
+
+  /// Replaces element I with Ok(value).
+  template <std::size_t I> void set_ok(T_<I> value) {
+    destroy_at<I>();
+    new (slot<I>()) T_<I>(std::move(value));
+    ok_bits_ = static_cast<Mask>(ok_bits_ | (Mask{1} << I));
+  }
+
+  /// Replaces element I with Err(error).
+  template <std::size_t I> void set_err(E_<I> error) {
+    destroy_at<I>();
+    new (slot<I>()) E_<I>(std::move(error));
+    ok_bits_ = static_cast<Mask>(ok_bits_ & ~(Mask{1} << I));
+  }
+
+  /// Replaces element I with the contents of r.
+  template <std::size_t I> void set(R_<I> r) {
+    if (r.is_ok())
+      set_ok<I>(std::move(r.unwrap()));
+    else
+      set_err<I>(std::move(r.unwrap_err()));
+  }
+
+private:
+  template <std::size_t I> void *slot() noexcept {
+    return bytes_ + Layout::offsets()[I];
+  }
+  template <std::size_t I> const void *slot() const noexcept {
+    return bytes_ + Layout::offsets()[I];
+  }
+
+  template <std::size_t I> void destroy_at() noexcept {
+    if constexpr (!detail::tuple_trivial_v<Rs...>)
+      Storage::template destroy_at<I>();
+  }
+
+  template <std::size_t... I, typename... Args>
+  void init(std::index_sequence<I...>, Args &&...results) {
+    (place<I>(std::forward<Args>(results)), ...);
+  }
+  template <std::size_t I> void place(R_<I> &&r) {
+    if (r.is_ok()) {
+      new (slot<I>()) T_<I>(std::move(r.unwrap()));
+      ok_bits_ = static_cast<Mask>(ok_bits_ | (Mask{1} << I));
+    } else {
+      new (slot<I>()) E_<I>(std::move(r.unwrap_err()));
+    }
+  }
+};
+
+} // namespace cpp_result
@@ -0,0 +1,198 @@
+// retry.hpp - Retrying Result-returning calls with backoff and a budget
+// SPDX-License-Identifier: MIT
+//
+// retry(f, policy, is_retryable) calls f until it returns Ok, returns an
+// error is_retryable rejects, or runs out of attempts, sleeping with
+// exponential backoff and jitter in between. It returns f's last result.
+//
+// Retries add load exactly when a dependency is struggling. A RetryBudget
+// shared by the callers of a dependency bounds that: each call deposits a
+// fraction of a token and each retry withdraws a whole one, so retries
+// stay below `ratio` of the call volume (plus a small reserve) however
+// many callers fail at once. When the budget is empty the error is
+// returned at once.
+//
+// --- API OVERVIEW ---
+//
+//   retry(f, policy)                 -> Result<T, E>, every Err retryable
+//   retry(f, policy, is_retryable)   -> Result<T, E>
+//   RetryPolicy                      attempts, backoff, jitter, budget,
+//                                    sleeper
+//   RetryBudget(ratio, reserve)      try_withdraw(), tokens(), retries(),
+//                                    denied()
+
+#pragma once
+
+#include <result.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/**
+ * @brief Lock-free token bucket limiting retries to a fraction of calls.
+ *
+ * Tokens are kept in thousandths. A call deposits `ratio` of a token
+ * unless the bucket is full, which costs a single load in the steady
+ * state; a retry withdraws one token or is denied.
+ */
+class RetryBudget {
+public:
+  /**
+   * @param ratio    Retries allowed per call, e.g. 0.1 for 10% extra load.
+   * @param reserve  Tokens available at start and the bucket's floor of
+   *                 capacity, for low-traffic callers.
+   */
+  explicit RetryBudget(double ratio = 0.1, std::uint32_t reserve = 10)
+      : deposit_(static_cast<std::int64_t>(ratio * kUnit)),
+        capacity_(std::max<std::int64_t>(std::int64_t{reserve} * kUnit,
+                                         deposit_)),
+        tokens_(std::int64_t{reserve} * kUnit) {}
+
+  RetryBudget(const RetryBudget &) = delete;
+  RetryBudget &operator=(const RetryBudget &) = delete;
+
+  /// Credits one call.
+  void deposit() noexcept {
+    std::int64_t t = tokens_.load(std::memory_order_relaxed);
+    while (t < capacity_ &&
+           !tokens_.compare_exchange_weak(
+               t, std::min(capacity_, t + deposit_), std::memory_order_relaxed))
+      ;
+  }
+
+  /// Takes one token for a retry; false when the budget is spent.
+  bool try_withdraw() noexcept {
+    std::int64_t t = tokens_.load(std::memory_order_relaxed);
+    do {
+      if (t < kUnit) {
+        denied_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!tokens_.compare_exchange_weak(t, t - kUnit,
+                                            std::memory_order_relaxed));
+    retries_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  double tokens() const noexcept {
+    return static_cast<double>(tokens_.load(std::memory_order_relaxed)) /
+           kUnit;
+  }
+  /// Retries granted so far.
+  std::uint64_t retries() const noexcept {
+    return retries_.load(std::memory_order_relaxed);
+  }
+  /// Retries refused because the budget was spent.
+  std::uint64_t denied() const noexcept {
+    return denied_.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr std::int64_t kUnit = 1000;
+
+  const std::int64_t deposit_;
+  const std::int64_t capacity_;
+  std::atomic<std::int64_t> tokens_;
+  std::atomic<std::uint64_t> retries_{0};
+  std::atomic<std::uint64_t> denied_{0};
+};
+
+namespace detail {
+
+inline void retry_sleep(std::chrono::nanoseconds d) {
+  std::this_thread::sleep_for(d);
+}
+
+// Per-thread xorshift64*; jitter needs spread, not quality.
+inline double retry_uniform() noexcept {
+  thread_local std::uint64_t state =
+      0x9e3779b97f4a7c15ull ^
+      static_cast<std::uint64_t>(
+          std::chrono::steady_clock::now().time_since_epoch().count()) ^
+      reinterpret_cast<std::uintptr_t>(&state);
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return static_cast<double>((state * 0x2545f4914f6cdd1dull) >> 11) * 0x1p-53;
+}
+
+} // namespace detail
+
+/**
+ * @brief How retry() spaces and bounds its attempts.
+ */
+struct RetryPolicy {
+  /// Total calls, including the first.
+  unsigned max_attempts = 3;
+  /// Delay before the first retry; multiplied by `multiplier` after each.
+  std::chrono::nanoseconds base_delay = std::chrono::milliseconds(10);
+  std::chrono::nanoseconds max_delay = std::chrono::seconds(1);
+  double multiplier = 2.0;
+  /// Fraction of each delay that is randomized: 1 draws it uniformly from
+  /// [0, delay] ("full jitter"), 0 disables jitter.
+  double jitter = 1.0;
+  /// Shared budget drawn from by every retry; none when null.
+  RetryBudget *budget = nullptr;
+  /// Waits between attempts; replace to test without sleeping.
+  void (*sleep)(std::chrono::nanoseconds) = &detail::retry_sleep;
+
+  /// Delay before retry number `retry` (1-based), before jitter.
+  std::chrono::nanoseconds backoff(unsigned retry) const noexcept {
+    double d = static_cast<double>(base_delay.count());
+    const double cap = static_cast<double>(max_delay.count());
+    for (unsigned i = 1; i < retry && d < cap; ++i)
+      d *= multiplier;
+    return std::chrono::nanoseconds(
+        static_cast<std::chrono::nanoseconds::rep>(std::min(d, cap)));
+  }
+};
+
+/**
+ * @brief Calls f until it succeeds, fails with an error is_retryable
+ * rejects, exhausts policy.max_attempts or the budget is spent. Returns
+ * f's last result.
+ * @code
+ * static cpp_result::RetryBudget budget(0.1);
+ * cpp_result::RetryPolicy policy;
+ * policy.budget = &budget;
+ * auto user = cpp_result::retry(
+ *     [&] { return client.fetch_user(id); }, policy,
+ *     [](const RpcError &e) { return e.code == RpcError::Unavailable; });
+ * @endcode
+ */
+template <typename F, typename Pred>
+auto retry(F &&f, const RetryPolicy &policy, Pred &&is_retryable) {
+  using R = std::invoke_result_t<F &>;
+  if (policy.budget)
+    policy.budget->deposit();
+  R result = f();
+  for (unsigned attempt = 1;
+       attempt < policy.max_attempts && result.is_err_and(is_retryable);
+       ++attempt) {
+    if (policy.budget && !policy.budget->try_withdraw())
+      break;
+    const auto delay = policy.backoff(attempt);
+    const double keep = 1.0 - policy.jitter * detail::retry_uniform();
+    policy.sleep(std::chrono::nanoseconds(
+        static_cast<std::chrono::nanoseconds::rep>(
+            static_cast<double>(delay.count()) * keep)));
+    result = f();
+  }
+  return result;
+}
+
+/**
+ * @brief retry() treating every error as retryable.
+ */
+template <typename F> auto retry(F &&f, const RetryPolicy &policy) {
+  return retry(std::forward<F>(f), policy, [](const auto &) { return true; });
+}
+
+} // namespace cpp_result
@@ -0,0 +1,705 @@
+// shm_queue.hpp - Shared-memory Result queue between processes
+// SPDX-License-Identifier: MIT
+//
+// ShmQueue<T, E> is a bounded ring of Result<T, E> slots in a memfd
+// mapping, shared with forked children (or with any process the fd is
+// passed to). Producers claim slots with one atomic add (CAS for MPSC) and
+// publish each slot through its sequence number; the single consumer reads
+// published slots in order. Nothing crosses the kernel unless a side has to
+// sleep, in which case it waits on a futex in the mapping.
+//
+// Each endpoint holds a lease: a process-shared robust mutex locked for the
+// endpoint's lifetime. A process that exits or crashes without releasing it
+// leaves the mutex owner-dead, which the other side observes as
+// QueueError::Kind::PeerDead instead of waiting forever.
+//
+// --- API OVERVIEW ---
+//
+//   ShmQueue<T, E>::create(capacity, mode)  -> Result<ShmQueue, QueueError>
+//   ShmQueue<T, E>::attach(fd)              -> Result<ShmQueue, QueueError>
+//   queue.producer()  -> Result<Producer, QueueError>
+//   queue.consumer()  -> Result<Consumer, QueueError>
+//
+//   producer.try_push(item)                 -> Result<void, QueueError>
+//   producer.push(item, timeout)            -> Result<void, QueueError>
+//   producer.push_n(items, n, timeout)      -> Result<void, QueueError>
+//   consumer.try_pop()                      -> Result<Result<T, E>, QueueError>
+//   consumer.pop(timeout)                   -> Result<Result<T, E>, QueueError>
+//   consumer.pop_n(out, max, timeout)       -> Result<std::size_t, QueueError>
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/posix.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace cpp_result {
+
+/**
+ * @brief Error reported by ShmQueue and its endpoints.
+ */
+struct QueueError {
+  enum class Kind : std::uint8_t {
+    Create,       ///< memfd_create/ftruncate/mmap failed; see `error`.
+    Incompatible, ///< attach(): the mapping holds a different queue type.
+    Busy,         ///< No free endpoint lease (consumer or producer).
+    Full,         ///< try_push(): no free slot.
+    Empty,        ///< try_pop(): nothing published.
+    Timeout,      ///< A blocking call reached its timeout.
+    PeerDead,     ///< The other side exited without releasing its lease.
+    Closed,       ///< The other side released its lease cleanly.
+  };
+
+  Kind kind;
+  Errno error{0};
+
+  bool operator==(const QueueError &other) const noexcept {
+    return kind == other.kind && error == other.error;
+  }
+  bool operator!=(const QueueError &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief Number of producers a queue accepts.
+ */
+enum class QueueMode : std::uint32_t {
+  Spsc, ///< One producer; claiming a slot is a plain store.
+  Mpsc, ///< Up to ShmQueue::kMaxProducers producers.
+};
+
+namespace detail {
+
+inline long futex_wait(std::atomic<std::uint32_t> *word, std::uint32_t expected,
+                       const timespec *timeout) noexcept {
+  return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(word),
+                   FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+inline void futex_wake(std::atomic<std::uint32_t> *word, int count) noexcept {
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(word), FUTEX_WAKE,
+            count, nullptr, nullptr, 0);
+}
+
+enum LeaseState : std::uint32_t {
+  kLeaseFree,    // Never held.
+  kLeaseClaimed, // Being bound; counts as alive.
+  kLeaseHeld,    // Mutex locked by a live endpoint.
+  kLeaseClosed,  // Released by its owner.
+  kLeaseDead,    // Owner died holding it.
+};
+
+struct ShmLease {
+  pthread_mutex_t mutex;
+  std::atomic<std::uint32_t> state;
+
+  // Claims a free, closed or dead lease for the calling thread.
+  bool acquire() noexcept {
+    for (std::uint32_t s : {kLeaseFree, kLeaseClosed, kLeaseDead}) {
+      std::uint32_t expected = s;
+      if (state.compare_exchange_strong(expected, kLeaseClaimed,
+                                        std::memory_order_acq_rel)) {
+        if (pthread_mutex_lock(&mutex) == EOWNERDEAD)
+          pthread_mutex_consistent(&mutex);
+        state.store(kLeaseHeld, std::memory_order_release);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void release() noexcept {
+    state.store(kLeaseClosed, std::memory_order_release);
+    pthread_mutex_unlock(&mutex);
+  }
+
+  // Current state; a held lease whose owner died is turned into kLeaseDead.
+  std::uint32_t probe() noexcept {
+    const std::uint32_t s = state.load(std::memory_order_acquire);
+    if (s != kLeaseHeld)
+      return s;
+    const int rc = pthread_mutex_trylock(&mutex);
+    if (rc == EBUSY)
+      return kLeaseHeld;
+    if (rc == EOWNERDEAD) {
+      pthread_mutex_consistent(&mutex);
+      std::uint32_t expected = kLeaseHeld;
+      state.compare_exchange_strong(expected, kLeaseDead,
+                                    std::memory_order_acq_rel);
+      pthread_mutex_unlock(&mutex);
+      return kLeaseDead;
+    }
+    if (rc == 0)
+      pthread_mutex_unlock(&mutex);
+    return state.load(std::memory_order_acquire);
+  }
+};
+
+constexpr std::uint64_t kShmQueueMagic = 0x6370705f72736d71; // "cpp_rsmq"
+constexpr std::uint32_t kShmQueueMaxProducers = 16;
+
+struct ShmQueueHeader {
+  std::uint64_t magic;
+  std::uint32_t capacity;
+  std::uint32_t slot_size;
+  std::uint32_t item_size;
+  QueueMode mode;
+
+  alignas(64) std::atomic<std::uint64_t> tail;
+  alignas(64) std::atomic<std::uint64_t> head;
+  alignas(64) std::atomic<std::uint32_t> items_futex;
+  std::atomic<std::uint32_t> consumer_sleeping;
+  alignas(64) std::atomic<std::uint32_t> space_futex;
+  std::atomic<std::uint32_t> producers_sleeping;
+
+  ShmLease consumer;
+  ShmLease producers[kShmQueueMaxProducers];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "ShmQueue needs address-free atomics");
+
+// Splits a deadline into futex waits short enough to re-check the peer.
+inline timespec wait_slice(std::chrono::steady_clock::time_point deadline) {
+  constexpr auto kLivenessPoll = std::chrono::milliseconds(20);
+  const auto left = deadline - std::chrono::steady_clock::now();
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::max<std::chrono::steady_clock::duration>(
+          std::chrono::steady_clock::duration::zero(),
+          std::min<std::chrono::steady_clock::duration>(left, kLivenessPoll)));
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+  return ts;
+}
+
+inline std::chrono::steady_clock::time_point
+deadline_after(std::chrono::nanoseconds timeout) {
+  const auto now = std::chrono::steady_clock::now();
+  if (timeout >= std::chrono::steady_clock::time_point::max() - now)
+    return std::chrono::steady_clock::time_point::max();
+  return now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   timeout);
+}
+
+} // namespace detail
+
+/// Timeout value meaning "wait until the call can complete".
+constexpr std::chrono::nanoseconds kWaitForever =
+    std::chrono::nanoseconds::max();
+
+/**
+ * @brief Bounded multi-process queue of Result<T, E>.
+ *
+ * Result<T, E> must be trivially copyable (true whenever T and E are), so
+ * items are copied into the mapping without serialization. Create the
+ * queue before fork(); then bind endpoints in the processes that use them:
+ * @code
+ * using Q = cpp_result::ShmQueue<Sample, int>;
+ * auto q = Q::create(4096, cpp_result::QueueMode::Mpsc).unwrap();
+ * if (fork() == 0) {
+ *   {
+ *     auto tx = q.producer().unwrap();
+ *     tx.push(Q::Item::Ok(measure()));
+ *   } // releases the lease: the consumer sees Closed once drained
+ *   _exit(0);
+ * }
+ * auto rx = q.consumer().unwrap();
+ * while (auto item = rx.pop(); item.is_ok())
+ *   handle(item.unwrap());
+ * @endcode
+ *
+ * The peer is checked whenever a call has to wait, so a non-blocking call
+ * can still succeed against a dead peer. Endpoints use the mapping and must
+ * not outlive the queue. An endpoint's lease is owned by the thread that
+ * created it: create and destroy it on the same thread.
+ */
+template <typename T, typename E> class ShmQueue {
+public:
+  using Item = Result<T, E>;
+  static_assert(std::is_trivially_copyable_v<Item>,
+                "ShmQueue requires trivially copyable T and E");
+
+  static constexpr std::uint32_t kMaxProducers = detail::kShmQueueMaxProducers;
+  /// Largest capacity create() accepts (the largest 32-bit power of two).
+  static constexpr std::uint32_t kMaxCapacity = std::uint32_t{1} << 31;
+
+  class Producer;
+  class Consumer;
+
+  /**
+   * @brief Creates a queue with capacity rounded up to a power of two.
+   * A capacity above kMaxCapacity is a Create error with EINVAL.
+   */
+  static Result<ShmQueue, QueueError> create(std::uint32_t capacity,
+                                             QueueMode mode = QueueMode::Spsc) {
+    using R = Result<ShmQueue, QueueError>;
+    if (capacity > kMaxCapacity)
+      return R::Err({QueueError::Kind::Create, Errno{EINVAL}});
+    std::uint32_t cap = 1;
+    while (cap < capacity)
+      cap <<= 1;
+    const int fd = ::memfd_create("cpp_result_shm_queue", MFD_CLOEXEC);
+    if (fd < 0)
+      return R::Err({QueueError::Kind::Create, Errno::last()});
+    const std::size_t bytes = mapping_size(cap);
+    auto sized = posix::ftruncate(fd, static_cast<off_t>(bytes));
+    if (sized.is_err()) {
+      (void)posix::close(fd);
+      return R::Err({QueueError::Kind::Create, sized.unwrap_err()});
+    }
+    auto queue = map(fd, bytes);
+    if (queue.is_err())
+      return queue;
+    queue.unwrap().init(cap, mode);
+    return queue;
+  }
+
+  /**
+   * @brief Maps a queue created by another process; takes ownership of fd.
+   */
+  static Result<ShmQueue, QueueError> attach(int fd) {
+    using R = Result<ShmQueue, QueueError>;
+    auto st = posix::fstat(fd);
+    if (st.is_err()) {
+      (void)posix::close(fd);
+      return R::Err({QueueError::Kind::Create, st.unwrap_err()});
+    }
+    const auto bytes = static_cast<std::size_t>(st.unwrap().st_size);
+    if (bytes < sizeof(detail::ShmQueueHeader)) {
+      (void)posix::close(fd);
+      return R::Err({QueueError::Kind::Incompatible});
+    }
+    auto queue = map(fd, bytes);
+    if (queue.is_err())
+      return queue;
+    const auto &h = *queue.unwrap().header_;
+    if (h.magic != detail::kShmQueueMagic || h.slot_size != sizeof(Slot) ||
+        h.item_size != sizeof(Item) || bytes < mapping_size(h.capacity))
+      return R::Err({QueueError::Kind::Incompatible});
+    return queue;
+  }
+
+  ShmQueue(ShmQueue &&other) noexcept
+      : header_(std::exchange(other.header_, nullptr)),
+        slots_(std::exchange(other.slots_, nullptr)),
+        bytes_(std::exchange(other.bytes_, 0)),
+        fd_(std::exchange(other.fd_, -1)) {}
+  ShmQueue &operator=(ShmQueue &&other) noexcept {
+    if (this != &other) {
+      reset();
+      header_ = std::exchange(other.header_, nullptr);
+      slots_ = std::exchange(other.slots_, nullptr);
+      bytes_ = std::exchange(other.bytes_, 0);
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+  ShmQueue(const ShmQueue &) = delete;
+  ShmQueue &operator=(const ShmQueue &) = delete;
+  ~ShmQueue() { reset(); }
+
+  /// The memfd backing the queue, e.g. to pass over a Unix socket.
+  int fd() const noexcept { return fd_; }
+  std::uint32_t capacity() const noexcept { return header_->capacity; }
+  QueueMode mode() const noexcept { return header_->mode; }
+
+  /**
+   * @brief Binds a producer endpoint; Busy when all leases are taken.
+   */
+  Result<Producer, QueueError> producer() noexcept {
+    const std::uint32_t n =
+        header_->mode == QueueMode::Spsc ? 1 : kMaxProducers;
+    for (std::uint32_t i = 0; i < n; ++i)
+      if (header_->producers[i].acquire())
+        return Result<Producer, QueueError>::Ok(Producer(*this, i));
+    return Result<Producer, QueueError>::Err({QueueError::Kind::Busy});
+  }
+
+  /**
+   * @brief Binds the consumer endpoint; Busy when one is already bound.
+   */
+  Result<Consumer, QueueError> consumer() noexcept {
+    if (!header_->consumer.acquire())
+      return Result<Consumer, QueueError>::Err({QueueError::Kind::Busy});
+    return Result<Consumer, QueueError>::Ok(Consumer(*this));
+  }
+
+private:
+  struct Slot {
+    std::atomic<std::uint64_t> seq;
+    alignas(Item) unsigned char value[sizeof(Item)];
+  };
+
+  static std::size_t mapping_size(std::uint32_t capacity) noexcept {
+    return slots_offset() + std::size_t{capacity} * sizeof(Slot);
+  }
+  static constexpr std::size_t slots_offset() noexcept {
+    return (sizeof(detail::ShmQueueHeader) + 63) & ~std::size_t{63};
+  }
+
+  static Result<ShmQueue, QueueError> map(int fd, std::size_t bytes) {
+    auto addr = posix::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fd, 0);
+    if (addr.is_err()) {
+      (void)posix::close(fd);
+      return Result<ShmQueue, QueueError>::Err(
+          {QueueError::Kind::Create, addr.unwrap_err()});
+    }
+    auto *base = static_cast<unsigned char *>(addr.unwrap());
+    return Result<ShmQueue, QueueError>::Ok(ShmQueue(
+        reinterpret_cast<detail::ShmQueueHeader *>(base),
+        reinterpret_cast<Slot *>(base + slots_offset()), bytes, fd));
+  }
+
+  ShmQueue(detail::ShmQueueHeader *header, Slot *slots, std::size_t bytes,
+           int fd) noexcept
+      : header_(header), slots_(slots), bytes_(bytes), fd_(fd) {}
+
+  void init(std::uint32_t capacity, QueueMode mode) noexcept {
+    auto *h = new (header_) detail::ShmQueueHeader;
+    h->capacity = capacity;
+    h->slot_size = sizeof(Slot);
+    h->item_size = sizeof(Item);
+    h->mode = mode;
+    h->tail.store(0, std::memory_order_relaxed);
+    h->head.store(0, std::memory_order_relaxed);
+    h->items_futex.store(0, std::memory_order_relaxed);
+    h->consumer_sleeping.store(0, std::memory_order_relaxed);
+    h->space_futex.store(0, std::memory_order_relaxed);
+    h->producers_sleeping.store(0, std::memory_order_relaxed);
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    auto init_lease = [&](detail::ShmLease &lease) {
+      pthread_mutex_init(&lease.mutex, &attr);
+      lease.state.store(detail::kLeaseFree, std::memory_order_relaxed);
+    };
+    init_lease(h->consumer);
+    for (auto &lease : h->producers)
+      init_lease(lease);
+    pthread_mutexattr_destroy(&attr);
+
+    for (std::uint32_t i = 0; i < capacity; ++i)
+      new (&slots_[i].seq) std::atomic<std::uint64_t>(0);
+    // Publish the magic last so attach() never sees a half-built header.
+    std::atomic_thread_fence(std::memory_order_release);
+    h->magic = detail::kShmQueueMagic;
+  }
+
+  void reset() noexcept {
+    if (header_)
+      (void)posix::munmap(header_, bytes_);
+    if (fd_ >= 0)
+      (void)posix::close(fd_);
+    header_ = nullptr;
+    slots_ = nullptr;
+    fd_ = -1;
+  }
+
+  detail::ShmQueueHeader *header_ = nullptr;
+  Slot *slots_ = nullptr;
+  std::size_t bytes_ = 0;
+  int fd_ = -1;
+};
+
+/**
+ * @brief Publishing endpoint. Releases its lease on destruction.
+ */
+template <typename T, typename E> class ShmQueue<T, E>::Producer {
+public:
+  Producer(Producer &&other) noexcept
+      : header_(std::exchange(other.header_, nullptr)), slots_(other.slots_),
+        lease_(other.lease_) {}
+  Producer &operator=(Producer &&) = delete;
+  Producer(const Producer &) = delete;
+  Producer &operator=(const Producer &) = delete;
+  ~Producer() {
+    if (header_)
+      header_->producers[lease_].release();
+  }
+
+  /**
+   * @brief Publishes one item if a slot is free; Err(Full) otherwise.
+   */
+  Result<void, QueueError> try_push(const Item &item) noexcept {
+    if (publish(&item, 1) == 0)
+      return Result<void, QueueError>::Err({QueueError::Kind::Full});
+    return Result<void, QueueError>::Ok();
+  }
+
+  /**
+   * @brief Publishes one item, waiting for a free slot.
+   */
+  Result<void, QueueError>
+  push(const Item &item, std::chrono::nanoseconds timeout = kWaitForever) {
+    return push_n(&item, 1, timeout);
+  }
+
+  /**
+   * @brief Publishes n items, claiming as many slots per step as are free
+   * and waking the consumer once per step.
+   *
+   * On error, the items before the first unpublished one were delivered.
+   */
+  Result<void, QueueError>
+  push_n(const Item *items, std::size_t n,
+         std::chrono::nanoseconds timeout = kWaitForever) {
+    auto &h = *header_;
+    const auto deadline = detail::deadline_after(timeout);
+    while (n > 0) {
+      const std::size_t done = publish(items, n);
+      items += done;
+      n -= done;
+      if (n == 0)
+        break;
+
+      h.producers_sleeping.fetch_add(1, std::memory_order_seq_cst);
+      const std::uint32_t seen = h.space_futex.load(std::memory_order_acquire);
+      if (!has_space()) {
+        switch (h.consumer.probe()) {
+        case detail::kLeaseDead:
+          h.producers_sleeping.fetch_sub(1, std::memory_order_relaxed);
+          return Result<void, QueueError>::Err({QueueError::Kind::PeerDead});
+        case detail::kLeaseClosed:
+          h.producers_sleeping.fetch_sub(1, std::memory_order_relaxed);
+          return Result<void, QueueError>::Err({QueueError::Kind::Closed});
+        default:
+          break;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+          h.producers_sleeping.fetch_sub(1, std::memory_order_relaxed);
+          return Result<void, QueueError>::Err({QueueError::Kind::Timeout});
+        }
+        const timespec ts = detail::wait_slice(deadline);
+        detail::futex_wait(&h.space_futex, seen, &ts);
+      }
+      h.producers_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return Result<void, QueueError>::Ok();
+  }
+
+private:
+  friend class ShmQueue;
+  Producer(ShmQueue &queue, std::uint32_t lease) noexcept
+      : header_(queue.header_), slots_(queue.slots_), lease_(lease) {}
+
+  bool has_space() const noexcept {
+    const auto &h = *header_;
+    return h.tail.load(std::memory_order_acquire) -
+               h.head.load(std::memory_order_acquire) <
+           h.capacity;
+  }
+
+  // Claims up to n slots, fills and publishes them; returns the count.
+  std::size_t publish(const Item *items, std::size_t n) noexcept {
+    auto &h = *header_;
+    const std::uint64_t cap = h.capacity;
+    std::uint64_t pos = h.tail.load(std::memory_order_relaxed);
+    std::uint64_t k;
+    for (;;) {
+      const std::uint64_t head = h.head.load(std::memory_order_acquire);
+      const std::uint64_t used = pos - head;
+      // A stale pos can trail head under MPSC; the CAS below rejects it.
+      k = used >= cap ? 0 : std::min<std::uint64_t>(n, cap - used);
+      if (k == 0) {
+        if (h.mode == QueueMode::Spsc || pos >= head)
+          return 0;
+        pos = h.tail.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (h.mode == QueueMode::Spsc) {
+        h.tail.store(pos + k, std::memory_order_relaxed);
+        break;
+      }
+      if (h.tail.compare_exchange_weak(pos, pos + k,
+                                       std::memory_order_relaxed))
+        break;
+    }
+    for (std::uint64_t i = 0; i < k; ++i) {
+      Slot &slot = slots_[(pos + i) & (cap - 1)];
+      new (slot.value) Item(items[i]);
+      slot.seq.store(pos + i + 1, std::memory_order_release);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (h.consumer_sleeping.load(std::memory_order_relaxed)) {
+      h.items_futex.fetch_add(1, std::memory_order_release);
+      detail::futex_wake(&h.items_futex, 1);
+    }
+    return static_cast<std::size_t>(k);
+  }
+
+  detail::ShmQueueHeader *header_;
+  Slot *slots_;
+  std::uint32_t lease_;
+};
+
+/**
+ * @brief The single reading endpoint. Releases its lease on destruction.
+ */
+template <typename T, typename E> class ShmQueue<T, E>::Consumer {
+public:
+  Consumer(Consumer &&other) noexcept
+      : header_(std::exchange(other.header_, nullptr)), slots_(other.slots_) {}
+  Consumer &operator=(Consumer &&) = delete;
+  Consumer(const Consumer &) = delete;
+  Consumer &operator=(const Consumer &) = delete;
+  ~Consumer() {
+    if (header_)
+      header_->consumer.release();
+  }
+
+  /**
+   * @brief Takes the next item if one is published; Err(Empty) otherwise.
+   */
+  Result<Item, QueueError> try_pop() noexcept {
+    const Item *item = peek();
+    if (!item)
+      return Result<Item, QueueError>::Err({QueueError::Kind::Empty});
+    Item out = *item;
+    advance(1);
+    return Result<Item, QueueError>::Ok(out);
+  }
+
+  /**
+   * @brief Takes the next item, waiting for one to be published.
+   *
+   * Once every bound producer is gone and the queue is drained, returns
+   * Closed, or PeerDead if any of them died holding its lease.
+   */
+  Result<Item, QueueError> pop(std::chrono::nanoseconds timeout = kWaitForever) {
+    const auto deadline = detail::deadline_after(timeout);
+    for (;;) {
+      auto item = try_pop();
+      if (item.is_ok())
+        return item;
+      auto waited = wait(deadline);
+      if (waited.is_err())
+        return Result<Item, QueueError>::Err(waited.unwrap_err());
+    }
+  }
+
+  /**
+   * @brief Appends up to max items to out, waiting until at least one is
+   * published. Returns the number appended.
+   */
+  Result<std::size_t, QueueError>
+  pop_n(std::vector<Item> &out, std::size_t max,
+        std::chrono::nanoseconds timeout = kWaitForever) {
+    const auto deadline = detail::deadline_after(timeout);
+    for (;;) {
+      const std::size_t n = drain(out, max);
+      if (n > 0 || max == 0)
+        return Result<std::size_t, QueueError>::Ok(n);
+      auto waited = wait(deadline);
+      if (waited.is_err())
+        return Result<std::size_t, QueueError>::Err(waited.unwrap_err());
+    }
+  }
+
+private:
+  friend class ShmQueue;
+  static constexpr int kYieldsBeforeSleep = 4;
+
+  explicit Consumer(ShmQueue &queue) noexcept
+      : header_(queue.header_), slots_(queue.slots_) {}
+
+  const Item *peek(std::uint64_t offset = 0) const noexcept {
+    const auto &h = *header_;
+    const std::uint64_t pos = h.head.load(std::memory_order_relaxed) + offset;
+    const Slot &slot = slots_[pos & (h.capacity - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != pos + 1)
+      return nullptr;
+    return std::launder(reinterpret_cast<const Item *>(slot.value));
+  }
+
+  std::size_t drain(std::vector<Item> &out, std::size_t max) {
+    std::size_t n = 0;
+    while (n < max) {
+      const Item *item = peek(n);
+      if (!item)
+        break;
+      out.push_back(*item);
+      ++n;
+    }
+    if (n)
+      advance(n);
+    return n;
+  }
+
+  void advance(std::size_t n) noexcept {
+    auto &h = *header_;
+    h.head.store(h.head.load(std::memory_order_relaxed) + n,
+                 std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (h.producers_sleeping.load(std::memory_order_relaxed)) {
+      h.space_futex.fetch_add(1, std::memory_order_release);
+      detail::futex_wake(&h.space_futex, INT32_MAX);
+    }
+  }
+
+  // Sleeps until an item may be available. Errs when no producer can
+  // publish any more or the deadline passed.
+  Result<void, QueueError>
+  wait(std::chrono::steady_clock::time_point deadline) {
+    auto &h = *header_;
+    // Yield a few times first: a producer that is mid-batch publishes again
+    // shortly, and skipping the futex saves a wake-up syscall per item.
+    for (int i = 0; i < kYieldsBeforeSleep; ++i) {
+      if (peek())
+        return Result<void, QueueError>::Ok();
+      sched_yield();
+    }
+    h.consumer_sleeping.store(1, std::memory_order_seq_cst);
+    const std::uint32_t seen = h.items_futex.load(std::memory_order_acquire);
+    Result<void, QueueError> out = Result<void, QueueError>::Ok();
+    if (!peek()) {
+      bool alive = false, dead = false, any = false;
+      for (auto &lease : h.producers) {
+        const std::uint32_t s = lease.probe();
+        alive |= s == detail::kLeaseHeld || s == detail::kLeaseClaimed;
+        dead |= s == detail::kLeaseDead;
+        any |= s != detail::kLeaseFree;
+      }
+      // Re-check: a producer may have published right before leaving.
+      if (any && !alive && !peek())
+        out = Result<void, QueueError>::Err(
+            {dead ? QueueError::Kind::PeerDead : QueueError::Kind::Closed});
+      else if (std::chrono::steady_clock::now() >= deadline)
+        out = Result<void, QueueError>::Err({QueueError::Kind::Timeout});
+      else if (!peek()) {
+        const timespec ts = detail::wait_slice(deadline);
+        detail::futex_wait(&h.items_futex, seen, &ts);
+      }
+    }
+    h.consumer_sleeping.store(0, std::memory_order_relaxed);
+    return out;
+  }
+
+  detail::ShmQueueHeader *header_;
+  Slot *slots_;
+};
+
+} // namespace cpp_result
@@ -0,0 +1,122 @@
+// site.hpp - Compile-time call-site descriptors for errors
+// SPDX-License-Identifier: MIT
+//
+// CPP_RESULT_HERE yields a pointer to a Site (file, line, function and an
+// optional message) that is a static constant of the enclosing function:
+// it is built by the compiler, not at run time, and taking it is a single
+// address load. Traced<E> pairs an error with such a pointer, so an error
+// records where it was raised for the price of one pointer store.
+//
+// TRY keeps the Traced<E> as it is and TRY_INTO converts between Traced
+// types, so the site of the original Err survives any number of
+// propagation steps.
+//
+// --- API OVERVIEW ---
+//
+//   CPP_RESULT_HERE                  -> const Site *  (statement expression)
+//   CPP_RESULT_HERE_MSG("text")      -> const Site *  with a static message
+//   ERR_HERE(e), ERR_HERE_MSG(e, "text")
+//                                    -> Traced<E> raised at this line
+//   Traced<E>(error, site)           error(), site(), ==, converts from
+//                                    Traced<E2> keeping the site
+//   Site                             file, line, function, message
+
+#pragma once
+
+#include <result.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace cpp_result {
+
+/**
+ * @brief Where an error was raised. Instances are static constants made
+ * by CPP_RESULT_HERE; errors hold a pointer to one.
+ */
+struct Site {
+  const char *file;
+  unsigned line;
+  const char *function;
+  const char *message; ///< Static message, or nullptr
+};
+
+#if CPP_RESULT_HAS_STATEMENT_EXPR
+#define CPP_RESULT_HERE_MSG(msg)                                               \
+  ({                                                                           \
+    static constexpr ::cpp_result::Site __cpp_result_site{                     \
+        __FILE__, __LINE__, __func__, msg};                                    \
+    &__cpp_result_site;                                                        \
+  })
+#else
+// Without statement expressions the descriptor lives in a lambda, whose
+// __func__ would name the lambda; the function is left out.
+#define CPP_RESULT_HERE_MSG(msg)                                               \
+  ([]() -> const ::cpp_result::Site * {                                        \
+    static constexpr ::cpp_result::Site __cpp_result_site{                     \
+        __FILE__, __LINE__, nullptr, msg};                                     \
+    return &__cpp_result_site;                                                 \
+  }())
+#endif
+
+#define CPP_RESULT_HERE CPP_RESULT_HERE_MSG(nullptr)
+
+/**
+ * @brief An error together with the site that raised it.
+ *
+ * One pointer larger than E. Comparison looks at the error only.
+ * @code
+ * enum class ParseError { Empty, BadDigit };
+ * Result<int, Traced<ParseError>> parse(std::string_view s) {
+ *   if (s.empty())
+ *     return Result<int, Traced<ParseError>>::Err(ERR_HERE(ParseError::Empty));
+ *   ...
+ * }
+ * auto r = parse("");
+ * std::fprintf(stderr, "%s:%u\n", r.unwrap_err().site()->file,
+ *              r.unwrap_err().site()->line);
+ * @endcode
+ */
+template <typename E> class Traced {
+public:
+  Traced(E error, const Site *site) noexcept(
+      std::is_nothrow_move_constructible_v<E>)
+      : error_(std::move(error)), site_(site) {}
+
+  /// Converts the error and keeps the original site, e.g. through TRY_INTO.
+  template <typename E2,
+            std::enable_if_t<!std::is_same_v<E2, E> &&
+                                 std::is_constructible_v<E, E2 &&>,
+                             int> = 0>
+  Traced(Traced<E2> &&other) noexcept(std::is_nothrow_constructible_v<E, E2 &&>)
+      : error_(std::move(other.error())), site_(other.site()) {}
+  template <typename E2,
+            std::enable_if_t<!std::is_same_v<E2, E> &&
+                                 std::is_constructible_v<E, const E2 &>,
+                             int> = 0>
+  Traced(const Traced<E2> &other) noexcept(
+      std::is_nothrow_constructible_v<E, const E2 &>)
+      : error_(other.error()), site_(other.site()) {}
+
+  E &error() noexcept { return error_; }
+  const E &error() const noexcept { return error_; }
+  const Site *site() const noexcept { return site_; }
+
+  bool operator==(const Traced &other) const { return error_ == other.error_; }
+  bool operator!=(const Traced &other) const { return !(*this == other); }
+
+private:
+  E error_;
+  const Site *site_;
+};
+
+/// Pairs an error with a site; see ERR_HERE.
+template <typename E>
+Traced<std::decay_t<E>> traced(E &&error, const Site *site) {
+  return Traced<std::decay_t<E>>(std::forward<E>(error), site);
+}
+
+#define ERR_HERE(e) ::cpp_result::traced((e), CPP_RESULT_HERE)
+#define ERR_HERE_MSG(e, msg) ::cpp_result::traced((e), CPP_RESULT_HERE_MSG(msg))
+
+} // namespace cpp_result
@@ -0,0 +1,464 @@
+// uring.hpp - Batched I/O over io_uring with one Result per operation
+// SPDX-License-Identifier: MIT
+//
+// Minimal io_uring driver built directly on the io_uring_setup(2) and
+// io_uring_enter(2) system calls (no liburing). A batch of read/write
+// operations is submitted at once and each operation completes with its own
+// Result<std::size_t, Errno>. IORING_OP_READ/WRITE need Linux 5.6; BatchIo
+// falls back to preadv2/pwritev2 when io_uring is unavailable (older
+// kernel, seccomp, io_uring_disabled sysctl).
+//
+// --- API OVERVIEW ---
+//
+//   IoOp::read(fd, buf, len, off), IoOp::write(fd, buf, len, off)
+//   IoUring::create(entries)  -> Result<IoUring, Errno>
+//   ring.submit(ops, n)       -> Result<Completions, Errno>
+//   BatchIo::create(entries)  -> BatchIo (io_uring or synchronous fallback)
+//   io.submit(ops, n)         -> Result<Completions, Errno>
+//   Completions               -> vector-like, one Result per IoOp
+
+#pragma once
+
+#include <result.hpp>
+
+#include <cpp_result/posix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <utility>
+#include <vector>
+
+namespace cpp_result {
+
+/**
+ * @brief One positional read or write of a batch.
+ */
+struct IoOp {
+  enum class Kind : std::uint8_t { Read, Write };
+
+  Kind kind;
+  int fd;
+  void *buf;
+  std::uint32_t len;
+  std::uint64_t offset;
+
+  static IoOp read(int fd, void *buf, std::uint32_t len,
+                   std::uint64_t offset) noexcept {
+    return {Kind::Read, fd, buf, len, offset};
+  }
+  static IoOp write(int fd, const void *buf, std::uint32_t len,
+                    std::uint64_t offset) noexcept {
+    return {Kind::Write, fd, const_cast<void *>(buf), len, offset};
+  }
+};
+
+/**
+ * @brief Per-operation outcomes of a batch, in submission order.
+ *
+ * Each element is the byte count transferred or the Errno of that
+ * operation.
+ */
+class Completions {
+public:
+  using value_type = Result<std::size_t, Errno>;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  Completions() = default;
+  explicit Completions(std::size_t n)
+      : results_(n, value_type::Err(Errno{0})) {}
+
+  std::size_t size() const noexcept { return results_.size(); }
+  bool empty() const noexcept { return results_.empty(); }
+  const value_type &operator[](std::size_t i) const noexcept {
+    return results_[i];
+  }
+  value_type &operator[](std::size_t i) noexcept { return results_[i]; }
+  const_iterator begin() const noexcept { return results_.begin(); }
+  const_iterator end() const noexcept { return results_.end(); }
+
+  /**
+   * @brief Returns true if every operation succeeded.
+   */
+  bool all_ok() const noexcept {
+    for (const auto &r : results_)
+      if (r.is_err())
+        return false;
+    return true;
+  }
+
+  /**
+   * @brief Returns the number of failed operations.
+   */
+  std::size_t error_count() const noexcept {
+    std::size_t n = 0;
+    for (const auto &r : results_)
+      n += r.is_err();
+    return n;
+  }
+
+private:
+  std::vector<value_type> results_;
+};
+
+namespace detail {
+inline int io_uring_setup(unsigned entries, io_uring_params *p) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+inline int io_uring_register(int fd, unsigned opcode, void *arg,
+                             unsigned nr_args) noexcept {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+inline int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                          unsigned flags) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+template <typename T> inline T load_acquire(const T *p) noexcept {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+template <typename T> inline void store_release(T *p, T v) noexcept {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+} // namespace detail
+
+/**
+ * @brief An io_uring instance driven with raw system calls.
+ *
+ * Not thread-safe: one ring per thread. Move-only.
+ *
+ * @code
+ * auto ring = cpp_result::IoUring::create(64);
+ * std::vector<cpp_result::IoOp> ops = {IoOp::read(fd, buf, 4096, 0)};
+ * auto done = ring.unwrap().submit(ops.data(), ops.size());
+ * @endcode
+ */
+class IoUring {
+public:
+  /**
+   * @brief Sets up a ring with room for `entries` in-flight operations.
+   *
+   * Err(EOPNOTSUPP) when the kernel lacks IORING_OP_READ/WRITE (before
+   * Linux 5.6, where setup succeeds but every operation fails with EINVAL).
+   */
+  static Result<IoUring, Errno> create(unsigned entries) noexcept {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    int fd = detail::io_uring_setup(entries, &p);
+    if (fd < 0)
+      return Result<IoUring, Errno>::Err(Errno::last());
+    IoUring ring;
+    ring.fd_ = fd;
+    auto mapped = ring.map_rings(p);
+    if (mapped.is_err())
+      return Result<IoUring, Errno>::Err(mapped.unwrap_err());
+    if (!ring.supports_read_write())
+      return Result<IoUring, Errno>::Err(Errno{EOPNOTSUPP});
+    return Result<IoUring, Errno>::Ok(std::move(ring));
+  }
+
+  IoUring(IoUring &&other) noexcept { steal(other); }
+  IoUring &operator=(IoUring &&other) noexcept {
+    if (this != &other) {
+      reset();
+      steal(other);
+    }
+    return *this;
+  }
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+  ~IoUring() { reset(); }
+
+  /**
+   * @brief Returns the submission queue size.
+   */
+  unsigned capacity() const noexcept { return sq_entries_; }
+
+  /**
+   * @brief Submits n operations and waits until all of them complete.
+   *
+   * Batches larger than capacity() are split into rounds. An Err is
+   * returned only when io_uring_enter itself fails; per-operation failures
+   * are reported in the Completions. After such an Err no operation of the
+   * batch is still running, unless the ring could not be drained: it then
+   * answers every later submit with EBADFD.
+   */
+  Result<Completions, Errno> submit(const IoOp *ops, std::size_t n) {
+    if (broken_)
+      return Result<Completions, Errno>::Err(Errno{EBADFD});
+    Completions out(n);
+    std::size_t next = 0;
+    while (next < n) {
+      const unsigned round = static_cast<unsigned>(
+          std::min<std::size_t>(n - next, sq_entries_));
+      push(ops + next, round, next);
+      auto done = wait(round, out);
+      if (done.is_err())
+        return Result<Completions, Errno>::Err(done.unwrap_err());
+      next += round;
+    }
+    return Result<Completions, Errno>::Ok(std::move(out));
+  }
+
+  Result<Completions, Errno> submit(const std::vector<IoOp> &ops) {
+    return submit(ops.data(), ops.size());
+  }
+
+private:
+  int fd_ = -1;
+  void *sq_ring_ = nullptr;
+  std::size_t sq_ring_size_ = 0;
+  void *cq_ring_ = nullptr;
+  std::size_t cq_ring_size_ = 0;
+  io_uring_sqe *sqes_ = nullptr;
+  std::size_t sqes_size_ = 0;
+
+  unsigned *sq_head_ = nullptr;
+  unsigned *sq_tail_ = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe *cqes_ = nullptr;
+  bool broken_ = false;
+
+  IoUring() noexcept = default;
+
+  bool supports_read_write() noexcept {
+    constexpr unsigned kOps = 256;
+    alignas(io_uring_probe) unsigned char
+        buf[sizeof(io_uring_probe) + kOps * sizeof(io_uring_probe_op)] = {};
+    auto *probe = reinterpret_cast<io_uring_probe *>(buf);
+    if (detail::io_uring_register(fd_, IORING_REGISTER_PROBE, probe, kOps) < 0)
+      return false; // IORING_REGISTER_PROBE is 5.6 too
+    auto supported = [&](unsigned op) {
+      return op <= probe->last_op && op < probe->ops_len &&
+             (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    };
+    return supported(IORING_OP_READ) && supported(IORING_OP_WRITE);
+  }
+
+  Result<void, Errno> map_rings(const io_uring_params &p) noexcept {
+    sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    auto sq = posix::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (sq.is_err())
+      return Result<void, Errno>::Err(sq.unwrap_err());
+    sq_ring_ = sq.unwrap();
+    if (single) {
+      cq_ring_ = sq_ring_;
+    } else {
+      auto cq =
+          posix::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+      if (cq.is_err())
+        return Result<void, Errno>::Err(cq.unwrap_err());
+      cq_ring_ = cq.unwrap();
+    }
+    sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+    auto sqes = posix::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (sqes.is_err())
+      return Result<void, Errno>::Err(sqes.unwrap_err());
+    sqes_ = static_cast<io_uring_sqe *>(sqes.unwrap());
+
+    auto *sq_base = static_cast<char *>(sq_ring_);
+    auto *cq_base = static_cast<char *>(cq_ring_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq_base + p.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq_base + p.sq_off.tail);
+    sq_array_ = reinterpret_cast<unsigned *>(sq_base + p.sq_off.array);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq_base + p.sq_off.ring_mask);
+    sq_entries_ = p.sq_entries;
+    cq_head_ = reinterpret_cast<unsigned *>(cq_base + p.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq_base + p.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq_base + p.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq_base + p.cq_off.cqes);
+    return Result<void, Errno>::Ok();
+  }
+
+  // Fills `count` submission entries; user_data carries the batch index.
+  void push(const IoOp *ops, unsigned count, std::size_t first) noexcept {
+    unsigned tail = *sq_tail_;
+    for (unsigned i = 0; i < count; ++i, ++tail) {
+      const unsigned idx = tail & sq_mask_;
+      io_uring_sqe *sqe = &sqes_[idx];
+      std::memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = ops[i].kind == IoOp::Kind::Read ? IORING_OP_READ
+                                                    : IORING_OP_WRITE;
+      sqe->fd = ops[i].fd;
+      sqe->addr = reinterpret_cast<std::uint64_t>(ops[i].buf);
+      sqe->len = ops[i].len;
+      sqe->off = ops[i].offset;
+      sqe->user_data = first + i;
+      sq_array_[idx] = idx;
+    }
+    detail::store_release(sq_tail_, tail);
+  }
+
+  // Submits the pushed entries and reaps `count` completions into out.
+  Result<void, Errno> wait(unsigned count, Completions &out) noexcept {
+    unsigned to_submit = count;
+    unsigned reaped = 0;
+    while (reaped < count) {
+      int ret = detail::io_uring_enter(fd_, to_submit, count - reaped,
+                                       IORING_ENTER_GETEVENTS);
+      if (ret < 0) {
+        if (errno == EINTR)
+          continue;
+        const Errno err = Errno::last();
+        abandon(count - to_submit - reaped);
+        return Result<void, Errno>::Err(err);
+      }
+      to_submit -= std::min(to_submit, static_cast<unsigned>(ret));
+      unsigned head = *cq_head_;
+      const unsigned tail = detail::load_acquire(cq_tail_);
+      for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+        if (cqe.user_data >= out.size())
+          continue; // not from this batch
+        ++reaped;
+        out[static_cast<std::size_t>(cqe.user_data)] =
+            cqe.res < 0 ? Completions::value_type::Err(Errno{-cqe.res})
+                        : Completions::value_type::Ok(
+                              static_cast<std::size_t>(cqe.res));
+      }
+      detail::store_release(cq_head_, head);
+    }
+    return Result<void, Errno>::Ok();
+  }
+
+  // After io_uring_enter failed: drops the entries the kernel has not taken
+  // and waits out the `in_flight` ones it has, so none of them completes
+  // into the caller's buffers later or into the next batch's Completions.
+  void abandon(unsigned in_flight) noexcept {
+    detail::store_release(sq_tail_, detail::load_acquire(sq_head_));
+    while (in_flight > 0) {
+      int ret = detail::io_uring_enter(fd_, 0, in_flight,
+                                       IORING_ENTER_GETEVENTS);
+      if (ret < 0 && errno != EINTR) {
+        broken_ = true;
+        return;
+      }
+      const unsigned head = *cq_head_;
+      const unsigned tail = detail::load_acquire(cq_tail_);
+      in_flight -= std::min(in_flight, tail - head);
+      detail::store_release(cq_head_, tail);
+    }
+  }
+
+  void steal(IoUring &other) noexcept {
+    fd_ = std::exchange(other.fd_, -1);
+    sq_ring_ = std::exchange(other.sq_ring_, nullptr);
+    sq_ring_size_ = other.sq_ring_size_;
+    cq_ring_ = std::exchange(other.cq_ring_, nullptr);
+    cq_ring_size_ = other.cq_ring_size_;
+    sqes_ = std::exchange(other.sqes_, nullptr);
+    sqes_size_ = other.sqes_size_;
+    sq_head_ = other.sq_head_;
+    sq_tail_ = other.sq_tail_;
+    sq_array_ = other.sq_array_;
+    sq_mask_ = other.sq_mask_;
+    sq_entries_ = other.sq_entries_;
+    cq_head_ = other.cq_head_;
+    cq_tail_ = other.cq_tail_;
+    cq_mask_ = other.cq_mask_;
+    cqes_ = other.cqes_;
+    broken_ = other.broken_;
+  }
+
+  void reset() noexcept {
+    if (sqes_)
+      (void)posix::munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_)
+      (void)posix::munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_)
+      (void)posix::munmap(sq_ring_, sq_ring_size_);
+    if (fd_ >= 0)
+      (void)posix::close(fd_);
+    fd_ = -1;
+    sq_ring_ = cq_ring_ = nullptr;
+    sqes_ = nullptr;
+  }
+};
+
+/**
+ * @brief Batched positional I/O: io_uring when available, preadv2/pwritev2
+ * otherwise.
+ *
+ * @code
+ * auto io = cpp_result::BatchIo::create(128);
+ * auto done = io.submit(ops);
+ * if (done.is_ok() && done.unwrap().all_ok()) {  ...  }
+ * @endcode
+ */
+class BatchIo {
+public:
+  enum class Backend : std::uint8_t { IoUring, Sync };
+
+  /**
+   * @brief Uses an io_uring of `entries` slots, or the synchronous
+   * fallback when one cannot be set up.
+   */
+  static BatchIo create(unsigned entries) {
+    auto ring = IoUring::create(entries);
+    if (ring.is_ok())
+      return BatchIo(std::move(ring.unwrap()));
+    return BatchIo();
+  }
+
+  /**
+   * @brief Always uses the synchronous preadv2/pwritev2 loop.
+   */
+  static BatchIo create_sync() { return BatchIo(); }
+
+  Backend backend() const noexcept {
+    return ring_.is_ok() ? Backend::IoUring : Backend::Sync;
+  }
+
+  /**
+   * @brief Runs n operations; see IoUring::submit.
+   */
+  Result<Completions, Errno> submit(const IoOp *ops, std::size_t n) {
+    if (ring_.is_ok())
+      return ring_.unwrap().submit(ops, n);
+    Completions out(n);
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = sync_op(ops[i]);
+    return Result<Completions, Errno>::Ok(std::move(out));
+  }
+
+  Result<Completions, Errno> submit(const std::vector<IoOp> &ops) {
+    return submit(ops.data(), ops.size());
+  }
+
+private:
+  Result<IoUring, Errno> ring_;
+
+  BatchIo() : ring_(Result<IoUring, Errno>::Err(Errno{ENOSYS})) {}
+  explicit BatchIo(IoUring &&ring)
+      : ring_(Result<IoUring, Errno>::Ok(std::move(ring))) {}
+
+  static Result<std::size_t, Errno> sync_op(const IoOp &op) noexcept {
+    iovec iov{op.buf, op.len};
+    const auto off = static_cast<off_t>(op.offset);
+    return posix::retry_eintr([&] {
+      ssize_t n = op.kind == IoOp::Kind::Read
+                      ? ::preadv2(op.fd, &iov, 1, off, 0)
+                      : ::pwritev2(op.fd, &iov, 1, off, 0);
+      return posix::detail::check<std::size_t>(n);
+    });
+  }
+};
+
+} // namespace cpp_result
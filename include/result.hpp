@@ -102,7 +102,6 @@
  * 
  * - The `TRY` macro requires your compiler to support statement expressions.
  * - `T` and `E` must not be reference types.
- * - `T` and `E` must not be same types. 
  */
 // result.hpp - Rust-like Result<T, E> for C++17
 // SPDX-License-Identifier: MIT
@@ -126,13 +125,25 @@
 //
 // Query:
 //   is_ok(), is_err()
+//   likely_ok(r), likely_err(r)    (branch hint at the call site)
+//   result_bias<T, E>              (specialize: LikelyOk / LikelyErr)
+//   can_fail, can_succeed          (static, false for a Never side)
 //
 // Unwrap:
 //   unwrap(), unwrap_err(), unwrap_or(value), unwrap_or_else(fn)
+//   unwrap_or_ref(fallback)        (no copy)
+//   select_or(value), unwrap_or_zero(), ok_mask()
+//                                  (branchless, trivially copyable T and E)
 //   expect(msg), expect_err(msg)
+//   into_ok()  (Result<T, Never>), into_err()  (Result<Never, E>)
+//
+// Infallible results:
+//   Never (alias Infallible): Result<T, Never> is sizeof(T) and never Err
 //
 // Combinators:
 //   map(fn), map_err(fn), and_then(fn)
+//   map_inplace(fn), map_err_inplace(fn), replace_ok(value)
+//   take_ok(), take_err()          (move out, leave T{} / E{} behind)
 //   inspect(fn), inspect_err(fn)
 //
 // See the documentation below each function for usage examples.
@@ -148,6 +159,14 @@
 #endif
 #endif
 
+#ifndef CPP_RESULT_HAS_BUILTIN_EXPECT
+#if defined(__GNUC__) || defined(__clang__)
+#define CPP_RESULT_HAS_BUILTIN_EXPECT 1
+#else
+#define CPP_RESULT_HAS_BUILTIN_EXPECT 0
+#endif
+#endif
+
 #ifndef CPP_RESULT_FEATURE_ALL
 #define CPP_RESULT_FEATURE_ALL 1
 #endif
@@ -181,6 +200,12 @@
  * Evaluates `expr` (which must return a Result). If it is an error, returns the
  * error from the current function. Otherwise, yields the value.
  *
+ * The error is returned as a Result of the same type as `expr`, moved out
+ * when `expr` is a temporary, so the enclosing function may deduce its return
+ * type. On a `Result<T, Never>` there is no error branch and no return at
+ * all, so it fits any function, deduced return type included. Use TRY_INTO
+ * to convert the error to another Result type.
+ *
  * @note This implementation needs your compiler support statement expressions.
  * @see Source code for the macro definition.
  *
@@ -198,9 +223,36 @@
 #define TRY(expr)                                                              \
   ({                                                                           \
     auto &&__res = (expr);                                                     \
-    using __res_type = std::decay_t<decltype(__res)>;                          \
+    if constexpr (::cpp_result::detail::can_fail_v<decltype(__res)>) {         \
+      if (__res.is_err())                                                      \
+        return ::cpp_result::detail::propagate<decltype(__res)>(__res);        \
+    }                                                                          \
+    std::move(__res.unwrap());                                                 \
+  })
+
+// clang-format off
+/**
+ * @def TRY_INTO(expr)
+ * @brief Like TRY, converting the error to the enclosing function's type.
+ *
+ * The enclosing function must return a Result (or a type such as Poll that
+ * accepts a propagated error) whose error type is constructible from the
+ * error of `expr`; its return type cannot be deduced.
+ *
+ * Example:
+ * @code
+ * Result<Config, LoadError> load(const std::string& path) {
+ *   std::string text = TRY_INTO(read_file(path));   // IoError -> LoadError
+ *   return parse_config(text).map_err(LoadError::from);
+ * }
+ * @endcode
+ */
+// clang-format on
+#define TRY_INTO(expr)                                                         \
+  ({                                                                           \
+    auto &&__res = (expr);                                                     \
     if (__res.is_err())                                                        \
-      return __res_type::Err(__res.unwrap_err());                              \
+      return ::cpp_result::detail::propagate_into<decltype(__res)>(__res);     \
     std::move(__res.unwrap());                                                 \
   })
 #endif
@@ -226,22 +278,33 @@
 // clang-format on
 #define TRY_ASSIGN(name, expr)                                                 \
   auto &&__res_##name = (expr);                                                \
-  using __res_type_##name = std::decay_t<decltype(__res_##name)>;              \
-  if (__res_##name.is_err())                                                   \
-    return __res_type_##name::Err(__res_##name.unwrap_err());                  \
+  if constexpr (::cpp_result::detail::can_fail_v<decltype(__res_##name)>) {   \
+    if (__res_##name.is_err())                                                 \
+      return ::cpp_result::detail::propagate<decltype(__res_##name)>(          \
+          __res_##name);                                                       \
+  }                                                                            \
   auto &name = __res_##name.unwrap()
 
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <new>
 #if CPP_RESULT_FEATURE_OPTIONAL
 #include <optional>
 #endif // CPP_RESULT_FEATURE_OPTIONAL
 #include <type_traits>
 #include <utility>
 
+#if CPP_RESULT_HAS_BUILTIN_EXPECT
+#define CPP_RESULT_COLD(cond) __builtin_expect(!!(cond), 0)
+#else
+#define CPP_RESULT_COLD(cond) (cond)
+#endif
+
 #define EXPECT_OR_ABORT(cond, msg)                                             \
   do {                                                                         \
-    if (!(cond)) {                                                             \
+    if (CPP_RESULT_COLD(!(cond))) {                                            \
       std::fputs(msg, stderr);                                                 \
       std::fputc('\n', stderr);                                                \
       std::abort();                                                            \
@@ -250,6 +313,292 @@
 
 namespace cpp_result {
 
+/**
+ * @brief Uninhabited type: no value of it can be created.
+ *
+ * `Result<T, Never>` cannot fail: it is exactly `sizeof(T)`, `is_err()` is
+ * a constant `false` and every error branch folds away, and `into_ok()`
+ * extracts the value without a check. `Result<Never, E>` is the mirror
+ * image for paths that always fail, with `into_err()`.
+ * @code
+ * Result<int, Never> parse_trusted(std::string_view s);
+ * int v = parse_trusted("42").into_ok();
+ * @endcode
+ */
+struct Never {
+  explicit Never() = delete; // explicit: not an aggregate, so no Never{}
+};
+
+/// Alias of Never, after Rust's `Infallible`.
+using Infallible = Never;
+
+/// Which outcome of a Result the compiler lays out as the fall-through path.
+enum class ResultBias { Unbiased, LikelyOk, LikelyErr };
+
+/**
+ * @brief Branch-weight policy of Result<T, E>, read by is_ok()/is_err() and
+ * so by every combinator and by TRY. Unbiased by default; specialize it
+ * for Results that are overwhelmingly Ok (parsers) or Err (cache probes).
+ * Use `void` as T for Result<void, E>. The specialization must be visible
+ * wherever the Result is used.
+ * @code
+ * template <typename T>
+ * struct cpp_result::result_bias<T, CacheMiss>
+ *     : std::integral_constant<cpp_result::ResultBias,
+ *                              cpp_result::ResultBias::LikelyErr> {};
+ * @endcode
+ */
+template <typename T, typename E>
+struct result_bias
+    : std::integral_constant<ResultBias, ResultBias::Unbiased> {};
+
+namespace detail {
+// Tags selecting the Ok or Err private constructor, so that Result<T, T> is
+// not ambiguous.
+struct OkTag {};
+struct ErrTag {};
+struct NeverTag {};
+
+// Placeholder value type used to store Result<void, E>.
+struct Unit {};
+
+// select_or() reads the value slot whatever the active member; that is
+// only a copy of bytes when both sides are trivially copyable.
+template <typename T, typename E>
+constexpr bool select_safe_v =
+    std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E> &&
+    std::is_default_constructible_v<T>;
+
+template <std::size_t N> struct select_word {};
+template <> struct select_word<1> { using type = std::uint8_t; };
+template <> struct select_word<2> { using type = std::uint16_t; };
+template <> struct select_word<4> { using type = std::uint32_t; };
+template <> struct select_word<8> { using type = std::uint64_t; };
+
+// Returns a copy of `a` if take_a, else of `b`, without a conditional jump:
+// both are blended word by word with a mask, since a plain
+// `take_a ? a : b` lets the compiler sink the load of `a` behind a branch.
+// `a` may hold indeterminate bytes (the inactive union member); they are
+// copied and masked, never inspected.
+template <typename T>
+T select_bytes(bool take_a, const T &a, const T &b) noexcept {
+  constexpr std::size_t n = sizeof(T);
+  constexpr std::size_t w = n % 8 == 0 ? 8 : n % 4 == 0 ? 4 : n % 2 == 0 ? 2 : 1;
+  using W = typename select_word<w>::type;
+  const W mask = static_cast<W>(-static_cast<W>(take_a));
+  unsigned char out[n];
+  for (std::size_t i = 0; i < n; i += w) {
+    W x, y;
+    std::memcpy(&x, reinterpret_cast<const unsigned char *>(&a) + i, w);
+    std::memcpy(&y, reinterpret_cast<const unsigned char *>(&b) + i, w);
+    const W picked = static_cast<W>((x & mask) | (y & ~mask));
+    std::memcpy(out + i, &picked, w);
+  }
+  T result;
+  std::memcpy(&result, out, n);
+  return result;
+}
+
+// Applies a ResultBias to a discriminant test.
+template <ResultBias B> constexpr bool hint_ok(bool ok) noexcept {
+#if CPP_RESULT_HAS_BUILTIN_EXPECT
+  if constexpr (B == ResultBias::LikelyOk)
+    return __builtin_expect(ok, 1);
+  else if constexpr (B == ResultBias::LikelyErr)
+    return __builtin_expect(ok, 0);
+#endif
+  return ok;
+}
+
+// Discriminant of a Result. When one side is Never it is a static constant:
+// the storage holds only the union and every branch on it folds away.
+// ResultStorage needs set_ok() and holds_value()/holds_error(); other
+// discriminants (Poll's) may report neither member as live.
+template <typename T, typename E> struct ResultTag {
+  bool is_ok_;
+  void set_ok(bool ok) noexcept { is_ok_ = ok; }
+  constexpr bool holds_value() const noexcept { return is_ok_; }
+  constexpr bool holds_error() const noexcept { return !is_ok_; }
+};
+template <typename T> struct ResultTag<T, Never> {
+  static constexpr bool is_ok_ = true;
+  void set_ok(bool) noexcept {}
+  constexpr bool holds_value() const noexcept { return true; }
+  constexpr bool holds_error() const noexcept { return false; }
+};
+template <typename E> struct ResultTag<Never, E> {
+  static constexpr bool is_ok_ = false;
+  void set_ok(bool) noexcept {}
+  constexpr bool holds_value() const noexcept { return false; }
+  constexpr bool holds_error() const noexcept { return true; }
+};
+
+// What TRY_INTO returns from the enclosing function: the error, by rvalue
+// reference when the tried expression was a temporary and by const
+// reference otherwise. Result converts from it to its own error type.
+template <typename Ref> struct Propagated {
+  Ref error;
+};
+
+template <typename Fwd, typename R> auto propagate_into(R &res) noexcept {
+  using E = std::remove_reference_t<decltype(res.unwrap_err())>;
+  if constexpr (std::is_lvalue_reference_v<Fwd> || std::is_const_v<E>)
+    return Propagated<const E &>{res.unwrap_err()};
+  else
+    return Propagated<E &&>{std::move(res.unwrap_err())};
+}
+
+// Whether TRY on a Result of type R has an error branch. Without one (a
+// Never error) the return statement is discarded, so it takes no part in
+// return type deduction; outside templates it is still checked, which the
+// converting proxy below satisfies.
+template <typename R>
+constexpr bool can_fail_v = std::remove_reference_t<R>::can_fail;
+
+// What TRY returns: a Result of the tried type, so that lambdas and auto
+// functions deduce one return type. Only a Never error, which no Result of
+// the tried type can carry out, goes through the converting proxy.
+template <typename Fwd, typename R> auto propagate(R &res) {
+  using Res = std::remove_cv_t<R>;
+  if constexpr (!Res::can_fail)
+    return propagate_into<Fwd>(res);
+  else if constexpr (std::is_lvalue_reference_v<Fwd> || std::is_const_v<R>)
+    return Res::Err(res.unwrap_err());
+  else
+    return Res::Err(std::move(res.unwrap_err()));
+}
+
+// A Propagated<Never> cannot be built at run time (no Never exists), but
+// TRY on a Result<T, Never> must still type-check in any function.
+template <typename Ref>
+constexpr bool propagates_never_v =
+    std::is_same_v<std::remove_cv_t<std::remove_reference_t<Ref>>, Never>;
+
+// Storage for the value/error union and its discriminant Tag (ResultTag for
+// Result, PollTag for Poll). The special members are trivial when T and E
+// are trivially copyable, which makes Result<T, E> itself trivially copyable
+// (passed in registers, memcpy-able).
+template <typename T, typename E, typename Tag = ResultTag<T, E>,
+          bool Trivial = std::is_trivially_copyable_v<T> &&
+                         std::is_trivially_copyable_v<E>>
+class ResultStorage : protected Tag {
+protected:
+  using Tag::holds_error;
+  using Tag::holds_value;
+  using Tag::set_ok;
+
+  union Data {
+    T value;
+    E error;
+    Data() {}
+    ~Data() {}
+  } data_;
+
+  // The default Tag: Pending for a Poll, unused by Result.
+  ResultStorage() noexcept = default;
+  template <typename U>
+  ResultStorage(OkTag, U &&val) noexcept(
+      std::is_nothrow_constructible_v<T, U &&>) {
+    set_ok(true);
+    new (&data_.value) T(std::forward<U>(val));
+  }
+  template <typename U>
+  ResultStorage(ErrTag, U &&err) noexcept(
+      std::is_nothrow_constructible_v<E, U &&>) {
+    set_ok(false);
+    new (&data_.error) E(std::forward<U>(err));
+  }
+
+  // Stands for a propagated Never error, which cannot exist.
+  explicit ResultStorage(NeverTag) noexcept { std::abort(); }
+
+  ~ResultStorage() { destroy(); }
+
+  ResultStorage(ResultStorage &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T> &&
+      std::is_nothrow_move_constructible_v<E>)
+      : Tag(other) {
+    if (holds_value())
+      new (&data_.value) T(std::move(other.data_.value));
+    else if (holds_error())
+      new (&data_.error) E(std::move(other.data_.error));
+  }
+
+  ResultStorage &operator=(ResultStorage &&other) noexcept(
+      std::is_nothrow_move_assignable_v<T> &&
+      std::is_nothrow_move_assignable_v<E>) {
+    if (this != &other) {
+      destroy();
+      Tag::operator=(other);
+      if (holds_value())
+        new (&data_.value) T(std::move(other.data_.value));
+      else if (holds_error())
+        new (&data_.error) E(std::move(other.data_.error));
+    }
+    return *this;
+  }
+
+  ResultStorage(const ResultStorage &other) noexcept(
+      std::is_nothrow_copy_constructible_v<T> &&
+      std::is_nothrow_copy_constructible_v<E>)
+      : Tag(other) {
+    if (holds_value())
+      new (&data_.value) T(other.data_.value);
+    else if (holds_error())
+      new (&data_.error) E(other.data_.error);
+  }
+
+  ResultStorage &operator=(const ResultStorage &other) noexcept(
+      std::is_nothrow_copy_assignable_v<T> &&
+      std::is_nothrow_copy_assignable_v<E>) {
+    if (this != &other) {
+      destroy();
+      Tag::operator=(other);
+      if (holds_value())
+        new (&data_.value) T(other.data_.value);
+      else if (holds_error())
+        new (&data_.error) E(other.data_.error);
+    }
+    return *this;
+  }
+
+  void destroy() noexcept {
+    if (holds_value())
+      data_.value.~T();
+    else if (holds_error())
+      data_.error.~E();
+  }
+};
+
+template <typename T, typename E, typename Tag>
+class ResultStorage<T, E, Tag, true> : protected Tag {
+protected:
+  using Tag::set_ok;
+
+  union Data {
+    T value;
+    E error;
+    Data() {}
+  } data_;
+
+  ResultStorage() noexcept = default;
+  template <typename U>
+  ResultStorage(OkTag, U &&val) noexcept(
+      std::is_nothrow_constructible_v<T, U &&>) {
+    set_ok(true);
+    new (&data_.value) T(std::forward<U>(val));
+  }
+  template <typename U>
+  ResultStorage(ErrTag, U &&err) noexcept(
+      std::is_nothrow_constructible_v<E, U &&>) {
+    set_ok(false);
+    new (&data_.error) E(std::forward<U>(err));
+  }
+  // Stands for a propagated Never error, which cannot exist.
+  explicit ResultStorage(NeverTag) noexcept { std::abort(); }
+};
+} // namespace detail
+
 /**
  * @brief Result<T, E> - Holds either a value (Ok) or an error (Err).
  *
@@ -263,11 +612,37 @@ namespace cpp_result {
  *  std::cout << r.unwrap();
  * @endcode
  */
-template <typename T, typename E> class [[nodiscard]] Result {
+template <typename T, typename E>
+class [[nodiscard]] Result : private detail::ResultStorage<T, E> {
   static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>,
                 "Result<T,E> does not support reference types");
+  static_assert(!(std::is_same_v<T, Never> && std::is_same_v<E, Never>),
+                "Result<Never,Never> has no values");
+
+  using Storage = detail::ResultStorage<T, E>;
+  using Storage::data_;
+  using Storage::is_ok_;
 
 public:
+  /// False for Result<T, Never>: is_err() is then a constant false.
+  static constexpr bool can_fail = !std::is_same_v<E, Never>;
+  /// False for Result<Never, E>: is_ok() is then a constant false.
+  static constexpr bool can_succeed = !std::is_same_v<T, Never>;
+
+  /**
+   * @brief Converts the error returned by TRY/TRY_ASSIGN from another
+   * Result whose error type E is constructible from.
+   */
+  template <typename Ref,
+            std::enable_if_t<std::is_constructible_v<E, Ref> ||
+                                 detail::propagates_never_v<Ref>,
+                             int> = 0>
+  Result(detail::Propagated<Ref> &&p) noexcept(
+      std::is_nothrow_constructible_v<E, Ref> ||
+      detail::propagates_never_v<Ref>)
+      : Result(std::move(p),
+               std::bool_constant<detail::propagates_never_v<Ref>>{}) {}
+
   /**
    * @brief Construct an Ok result.
    * @param val Value to store
@@ -279,7 +654,14 @@ public:
    * auto r2 = Result::Ok(42);
    * @endcode
    */
-  static inline Result Ok(T val) noexcept { return Result(std::move(val)); }
+  static inline Result Ok(const T &val) noexcept(
+      std::is_nothrow_copy_constructible_v<T>) {
+    return Result(detail::OkTag{}, val);
+  }
+  static inline Result Ok(T &&val) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    return Result(detail::OkTag{}, std::move(val));
+  }
 
   /**
    * @brief Construct an Err result.
@@ -292,7 +674,14 @@ public:
    * auto r2 = cpp_result::Err<int, std::string>("fail");
    * @endcode
    */
-  static inline Result Err(E err) noexcept { return Result(std::move(err)); }
+  static inline Result Err(const E &err) noexcept(
+      std::is_nothrow_copy_constructible_v<E>) {
+    return Result(detail::ErrTag{}, err);
+  }
+  static inline Result Err(E &&err) noexcept(
+      std::is_nothrow_move_constructible_v<E>) {
+    return Result(detail::ErrTag{}, std::move(err));
+  }
 
   /**
    * @brief Returns true if the result is Ok.
@@ -301,7 +690,9 @@ public:
    * if (r.is_ok()) {  ...  }
    * @endcode
    */
-  constexpr bool is_ok() const noexcept { return is_ok_; }
+  constexpr bool is_ok() const noexcept {
+    return detail::hint_ok<result_bias<T, E>::value>(is_ok_);
+  }
 
   /**
    * @brief Returns true if the result is Err.
@@ -310,7 +701,7 @@ public:
    * if (r.is_err()) {  ...  }
    * @endcode
    */
-  constexpr bool is_err() const noexcept { return !is_ok_; }
+  constexpr bool is_err() const noexcept { return !is_ok(); }
 
 #if CPP_RESULT_FEATURE_UNWRAP
   /**
@@ -348,15 +739,104 @@ public:
   }
 
   /**
-   * @brief Returns value if Ok, else returns default_value.
+   * @brief Moves out the value of a Result that cannot fail, without a
+   * check. Only available for Result<T, Never>.
+   * @code
+   * Result<int, Never> r = Result<int, Never>::Ok(3);
+   * int v = std::move(r).into_ok();
+   * @endcode
+   */
+  template <typename E2 = E,
+            std::enable_if_t<std::is_same_v<E2, Never>, int> = 0>
+  T into_ok() && noexcept(std::is_nothrow_move_constructible_v<T>) {
+    return std::move(data_.value);
+  }
+  template <typename E2 = E,
+            std::enable_if_t<std::is_same_v<E2, Never>, int> = 0>
+  T into_ok() const & noexcept(std::is_nothrow_copy_constructible_v<T>) {
+    return data_.value;
+  }
+
+  /**
+   * @brief Moves out the error of a Result that cannot succeed, without a
+   * check. Only available for Result<Never, E>.
+   */
+  template <typename T2 = T,
+            std::enable_if_t<std::is_same_v<T2, Never>, int> = 0>
+  E into_err() && noexcept(std::is_nothrow_move_constructible_v<E>) {
+    return std::move(data_.error);
+  }
+  template <typename T2 = T,
+            std::enable_if_t<std::is_same_v<T2, Never>, int> = 0>
+  E into_err() const & noexcept(std::is_nothrow_copy_constructible_v<E>) {
+    return data_.error;
+  }
+
+  /**
+   * @brief Returns value if Ok, else returns default_value. On an rvalue
+   * Result the value is moved out instead of copied.
    * @code
    * auto r = Err<int, std::string>("fail");
    * int v = r.unwrap_or(123);
    * assert(v == 123);
    * @endcode
    */
-  inline T unwrap_or(T default_value) const noexcept {
-    return is_ok_ ? data_.value : default_value;
+  inline T unwrap_or(T default_value) const & noexcept {
+    return is_ok() ? data_.value : std::move(default_value);
+  }
+  inline T unwrap_or(T default_value) && noexcept {
+    return is_ok() ? std::move(data_.value) : std::move(default_value);
+  }
+
+  /**
+   * @brief Reference to the value if Ok, else to fallback; copies nothing.
+   * Like std::min, the result dangles if fallback is a temporary that
+   * dies first.
+   * @code
+   * static const Config kDefaults;
+   * const Config &cfg = loaded.unwrap_or_ref(kDefaults);
+   * @endcode
+   */
+  const T &unwrap_or_ref(const T &fallback) const & noexcept {
+    return is_ok() ? data_.value : fallback;
+  }
+  const T &unwrap_or_ref(const T &) && = delete;
+
+  /**
+   * @brief Branchless unwrap_or() for trivially copyable T and E: the
+   * value slot is read unconditionally and the result picked with a
+   * select (cmov) instead of a jump. Suits unpredictable outcomes.
+   * @code
+   * std::uint64_t total = 0;
+   * for (const auto &r : parsed)
+   *   total += r.select_or(0);
+   * @endcode
+   */
+  template <typename T2 = T,
+            std::enable_if_t<detail::select_safe_v<T2, E>, int> = 0>
+  T select_or(T fallback) const noexcept {
+    return detail::select_bytes(is_ok_, data_.value, fallback);
+  }
+
+  /// select_or(T{}): the value, or zero when Err.
+  template <typename T2 = T,
+            std::enable_if_t<detail::select_safe_v<T2, E>, int> = 0>
+  T unwrap_or_zero() const noexcept {
+    return select_or(T{});
+  }
+
+  /**
+   * @brief All ones when Ok, zero when Err, for masking arithmetic
+   * without a branch.
+   * @code
+   * std::uint64_t weight_ok = 0;
+   * for (std::size_t i = 0; i < n; ++i)
+   *   weight_ok += weights[i] & results[i].ok_mask();
+   * @endcode
+   */
+  template <typename M = std::uint64_t> constexpr M ok_mask() const noexcept {
+    static_assert(std::is_unsigned_v<M>, "ok_mask needs an unsigned type");
+    return static_cast<M>(-static_cast<M>(is_ok_));
   }
 
   /**
@@ -369,7 +849,7 @@ public:
    */
   template <typename F>
   inline T unwrap_or_else(F &&func) const noexcept(noexcept(func())) {
-    return is_ok_ ? data_.value : std::forward<F>(func)();
+    return is_ok() ? data_.value : std::forward<F>(func)();
   }
 
   /**
@@ -384,7 +864,7 @@ public:
    */
   T unwrap_or_default() const
       noexcept(std::is_nothrow_default_constructible_v<T>) {
-    if (is_ok_)
+    if (is_ok())
       return data_.value;
     return T{};
   }
@@ -433,7 +913,7 @@ public:
   template <typename Pred>
   bool is_ok_and(Pred &&pred) const
       noexcept(noexcept(pred(std::declval<T>()))) {
-    return is_ok_ && pred(data_.value);
+    return is_ok() && pred(data_.value);
   }
 
   /**
@@ -448,7 +928,7 @@ public:
   template <typename Pred>
   bool is_err_and(Pred &&pred) const
       noexcept(noexcept(pred(std::declval<E>()))) {
-    return !is_ok_ && pred(data_.error);
+    return !is_ok() && pred(data_.error);
   }
 #endif // CPP_RESULT_FEATURE_UNWRAP
 
@@ -463,7 +943,7 @@ public:
    */
   template <typename F, typename U = std::invoke_result_t<F, T>>
   Result<U, E> map(F &&func) const noexcept(noexcept(func(std::declval<T>()))) {
-    if (is_ok_)
+    if (is_ok())
       return Result<U, E>::Ok(func(data_.value));
     return Result<U, E>::Err(data_.error);
   }
@@ -479,7 +959,7 @@ public:
   template <typename F, typename E2 = std::invoke_result_t<F, E>>
   Result<T, E2> map_err(F &&func) const
       noexcept(noexcept(func(std::declval<E>()))) {
-    if (is_ok_)
+    if (is_ok())
       return Result<T, E2>::Ok(data_.value);
     return Result<T, E2>::Err(func(data_.error));
   }
@@ -492,7 +972,7 @@ public:
    * @endcode
    */
   template <typename U, typename F> U map_or(U default_value, F &&func) const {
-    return is_ok_ ? func(data_.value) : default_value;
+    return is_ok() ? func(data_.value) : default_value;
   }
 
   /**
@@ -506,7 +986,68 @@ public:
    */
   template <typename D, typename F>
   auto map_or_else(D &&default_fn, F &&func) const {
-    return is_ok_ ? func(data_.value) : default_fn();
+    return is_ok() ? func(data_.value) : default_fn();
+  }
+
+  /**
+   * @brief Calls func(T&) on the value if Ok, modifying it where it lies;
+   * no Result is constructed. Returns *this for chaining.
+   * @code
+   * auto r = Ok<std::string, int>("hello");
+   * r.map_inplace([](std::string &s) { s += " world"; });
+   * assert(r.unwrap() == "hello world");
+   * @endcode
+   */
+  template <typename F> Result &map_inplace(F &&func) & {
+    if (is_ok())
+      std::forward<F>(func)(data_.value);
+    return *this;
+  }
+  template <typename F> Result &&map_inplace(F &&func) && {
+    return std::move(map_inplace(std::forward<F>(func)));
+  }
+
+  /**
+   * @brief Calls func(E&) on the error if Err, modifying it in place.
+   * @code
+   * auto r = Err<int, std::string>("fail");
+   * r.map_err_inplace([](std::string &e) { e.insert(0, "read: "); });
+   * @endcode
+   */
+  template <typename F> Result &map_err_inplace(F &&func) & {
+    if (!is_ok())
+      std::forward<F>(func)(data_.error);
+    return *this;
+  }
+  template <typename F> Result &&map_err_inplace(F &&func) && {
+    return std::move(map_err_inplace(std::forward<F>(func)));
+  }
+
+  /**
+   * @brief Makes this Ok(value) and returns the previous contents. An Ok
+   * value is move-assigned in place rather than destroyed and rebuilt.
+   *
+   * T's move constructor must not throw: an Err is replaced by destroying
+   * the error and moving value into its storage.
+   * @code
+   * auto r = Ok<int, std::string>(1);
+   * auto old = r.replace_ok(2);
+   * assert(old.unwrap() == 1 && r.unwrap() == 2);
+   * @endcode
+   */
+  Result replace_ok(T value) {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "replace_ok requires a noexcept move constructor");
+    Result old = is_ok() ? Result(detail::OkTag{}, std::move(data_.value))
+                         : Result(detail::ErrTag{}, std::move(data_.error));
+    if (old.is_ok()) {
+      data_.value = std::move(value);
+    } else {
+      data_.error.~E();
+      new (&data_.value) T(std::move(value));
+      this->set_ok(true);
+    }
+    return old;
   }
 #endif // CPP_RESULT_FEATURE_MAP
 
@@ -523,7 +1064,7 @@ public:
    */
   template <typename F, typename R = typename std::invoke_result_t<F, T>>
   R and_then(F &&func) const noexcept(noexcept(func(std::declval<T>()))) {
-    if (is_ok_)
+    if (is_ok())
       return func(data_.value);
     return R::Err(data_.error);
   }
@@ -537,7 +1078,7 @@ public:
    * @endcode
    */
   template <typename R2> auto and_(R2 &&res) const {
-    if (is_ok_)
+    if (is_ok())
       return std::forward<R2>(res);
     return Result<T, E>::Err(data_.error);
   }
@@ -551,7 +1092,7 @@ public:
    * @endcode
    */
   template <typename R2> auto or_(R2 &&res) const {
-    if (!is_ok_)
+    if (!is_ok())
       return std::forward<R2>(res);
     return *this;
   }
@@ -564,7 +1105,7 @@ public:
    * @endcode
    */
   template <typename F> auto or_else(F &&op) const {
-    if (!is_ok_)
+    if (!is_ok())
       return op();
     return *this;
   }
@@ -581,7 +1122,7 @@ public:
   template <typename F>
   const Result &inspect(F &&func) const
       noexcept(noexcept(func(std::declval<const T &>()))) {
-    if (is_ok_)
+    if (is_ok())
       func(data_.value);
     return *this;
   }
@@ -596,7 +1137,7 @@ public:
   template <typename F>
   const Result &inspect_err(F &&func) const
       noexcept(noexcept(func(std::declval<const E &>()))) {
-    if (!is_ok_)
+    if (!is_ok())
       func(data_.error);
     return *this;
   }
@@ -610,7 +1151,7 @@ public:
    * assert(r.contains(42));
    * @endcode
    */
-  bool contains(const T &value) const { return is_ok_ && data_.value == value; }
+  bool contains(const T &value) const { return is_ok() && data_.value == value; }
 
   /**
    * @brief Returns true if the result is Err and contains the given error.
@@ -620,7 +1161,7 @@ public:
    * @endcode
    */
   bool contains_err(const E &error) const {
-    return !is_ok_ && data_.error == error;
+    return !is_ok() && data_.error == error;
   }
 #endif // CPP_RESULT_FEATURE_CONTAINS
 
@@ -635,7 +1176,7 @@ public:
    */
   auto flatten() const {
     using Inner = decltype(data_.value);
-    if (is_ok_)
+    if (is_ok())
       return data_.value;
     return Inner::Err(data_.error);
   }
@@ -651,7 +1192,7 @@ public:
    * @endcode
    */
   std::optional<T> ok() const {
-    return is_ok_ ? std::optional<T>(data_.value) : std::nullopt;
+    return is_ok() ? std::optional<T>(data_.value) : std::nullopt;
   }
 
   /**
@@ -663,79 +1204,59 @@ public:
    * @endcode
    */
   std::optional<E> err() const {
-    return !is_ok_ ? std::optional<E>(data_.error) : std::nullopt;
-  }
-#endif
-
-  ~Result() { destroy(); }
-
-  // Move semantics
-  Result(Result &&other) noexcept(std::is_nothrow_move_constructible_v<T> &&
-                                  std::is_nothrow_move_constructible_v<E>)
-      : is_ok_(other.is_ok_) {
-    if (is_ok_)
-      new (&data_.value) T(std::move(other.data_.value));
-    else
-      new (&data_.error) E(std::move(other.data_.error));
+    return !is_ok() ? std::optional<E>(data_.error) : std::nullopt;
   }
 
-  Result &
-  operator=(Result &&other) noexcept(std::is_nothrow_move_assignable_v<T> &&
-                                     std::is_nothrow_move_assignable_v<E>) {
-    if (this != &other) {
-      destroy();
-      is_ok_ = other.is_ok_;
-      if (is_ok_)
-        new (&data_.value) T(std::move(other.data_.value));
-      else
-        new (&data_.error) E(std::move(other.data_.error));
-    }
-    return *this;
+  /**
+   * @brief Moves the value out if Ok, leaving Ok(T{}) behind (no
+   * reconstruction: the slot is move-assigned), else std::nullopt.
+   * @code
+   * auto buf = Ok<std::vector<char>, int>(std::vector<char>(4096));
+   * std::optional<std::vector<char>> owned = buf.take_ok(); // buf: Ok({})
+   * @endcode
+   */
+  template <typename T2 = T,
+            std::enable_if_t<std::is_default_constructible_v<T2>, int> = 0>
+  std::optional<T> take_ok() {
+    if (!is_ok())
+      return std::nullopt;
+    return std::optional<T>(std::exchange(data_.value, T{}));
   }
 
-  // Conditional copy semantics
-  Result(const Result &other) noexcept(
-      std::is_nothrow_copy_constructible_v<T> &&
-      std::is_nothrow_copy_constructible_v<E>)
-      : is_ok_(other.is_ok_) {
-    if (is_ok_)
-      new (&data_.value) T(other.data_.value);
-    else
-      new (&data_.error) E(other.data_.error);
+  /// Moves the error out if Err, leaving Err(E{}) behind.
+  template <typename E2 = E,
+            std::enable_if_t<std::is_default_constructible_v<E2>, int> = 0>
+  std::optional<E> take_err() {
+    if (is_ok())
+      return std::nullopt;
+    return std::optional<E>(std::exchange(data_.error, E{}));
   }
+#endif
 
-  Result &operator=(const Result &other) noexcept(
-      std::is_nothrow_copy_assignable_v<T> &&
-      std::is_nothrow_copy_assignable_v<E>) {
-    if (this != &other) {
-      destroy();
-      is_ok_ = other.is_ok_;
-      if (is_ok_)
-        new (&data_.value) T(other.data_.value);
-      else
-        new (&data_.error) E(other.data_.error);
-    }
-    return *this;
-  }
+  Result(Result &&) = default;
+  Result &operator=(Result &&) = default;
+  Result(const Result &) = default;
+  Result &operator=(const Result &) = default;
 
 private:
-  union Data {
-    T value;
-    E error;
-    Data() {}
-    ~Data() {}
-  } data_;
-  bool is_ok_;
-
-  explicit Result(T val) noexcept : is_ok_(true) {
-    new (&data_.value) T(std::move(val));
-  }
-
-  explicit Result(E err) noexcept : is_ok_(false) {
-    new (&data_.error) E(std::move(err));
-  }
-
-  void destroy() noexcept { is_ok_ ? data_.value.~T() : data_.error.~E(); }
+  // The payload is forwarded into the storage, so Ok(x) and Err(x) copy
+  // or move it exactly once.
+  template <typename U>
+  Result(detail::OkTag, U &&val) noexcept(
+      std::is_nothrow_constructible_v<T, U &&>)
+      : Storage(detail::OkTag{}, std::forward<U>(val)) {}
+
+  template <typename U>
+  Result(detail::ErrTag, U &&err) noexcept(
+      std::is_nothrow_constructible_v<E, U &&>)
+      : Storage(detail::ErrTag{}, std::forward<U>(err)) {}
+  template <typename Ref>
+  Result(detail::Propagated<Ref> &&p, std::false_type) noexcept(
+      std::is_nothrow_constructible_v<E, Ref>)
+      : Storage(detail::ErrTag{}, static_cast<Ref>(p.error)) {}
+  template <typename Ref>
+  Result(detail::Propagated<Ref> &&, std::true_type) noexcept
+      : Storage(detail::NeverTag{}) {}
 };
 
 /**
@@ -753,11 +1274,35 @@ private:
  *   std::cout << r.unwrap_err();
  * @endcode
  */
-template <typename E> class [[nodiscard]] Result<void, E> {
+template <typename E>
+class [[nodiscard]] Result<void, E>
+    : private detail::ResultStorage<detail::Unit, E> {
   static_assert(!std::is_reference_v<E>,
                 "Result<void,E> does not support reference types");
 
+  using Storage = detail::ResultStorage<detail::Unit, E>;
+  using Storage::data_;
+  using Storage::is_ok_;
+
 public:
+  /// False for Result<void, Never>: is_err() is then a constant false.
+  static constexpr bool can_fail = !std::is_same_v<E, Never>;
+  static constexpr bool can_succeed = true;
+
+  /**
+   * @brief Converts the error returned by TRY/TRY_ASSIGN from another
+   * Result whose error type E is constructible from.
+   */
+  template <typename Ref,
+            std::enable_if_t<std::is_constructible_v<E, Ref> ||
+                                 detail::propagates_never_v<Ref>,
+                             int> = 0>
+  Result(detail::Propagated<Ref> &&p) noexcept(
+      std::is_nothrow_constructible_v<E, Ref> ||
+      detail::propagates_never_v<Ref>)
+      : Result(std::move(p),
+               std::bool_constant<detail::propagates_never_v<Ref>>{}) {}
+
   /**
    * @brief Construct an Ok result.
    * @return Ok result
@@ -775,7 +1320,14 @@ public:
    * auto r = Err<std::string>("fail");
    * @endcode
    */
-  static inline Result Err(E err) noexcept { return Result(std::move(err)); }
+  static inline Result Err(const E &err) noexcept(
+      std::is_nothrow_copy_constructible_v<E>) {
+    return Result(detail::ErrTag{}, err);
+  }
+  static inline Result Err(E &&err) noexcept(
+      std::is_nothrow_move_constructible_v<E>) {
+    return Result(detail::ErrTag{}, std::move(err));
+  }
 
   /**
    * @brief Returns true if the result is Ok.
@@ -784,7 +1336,9 @@ public:
    * if (r.is_ok()) {  ...  }
    * @endcode
    */
-  inline bool is_ok() const noexcept { return is_ok_; }
+  constexpr bool is_ok() const noexcept {
+    return detail::hint_ok<result_bias<void, E>::value>(is_ok_);
+  }
 
   /**
    * @brief Returns true if the result is Err.
@@ -793,7 +1347,13 @@ public:
    * if (r.is_err()) {  ...  }
    * @endcode
    */
-  inline bool is_err() const noexcept { return !is_ok_; }
+  constexpr bool is_err() const noexcept { return !is_ok(); }
+
+  /// All ones when Ok, zero when Err; see Result<T, E>::ok_mask().
+  template <typename M = std::uint64_t> constexpr M ok_mask() const noexcept {
+    static_assert(std::is_unsigned_v<M>, "ok_mask needs an unsigned type");
+    return static_cast<M>(-static_cast<M>(is_ok_));
+  }
 
   /**
    * @brief Unwraps the value. Aborts if Err.
@@ -816,11 +1376,11 @@ public:
    */
   inline E &unwrap_err() noexcept {
     EXPECT_OR_ABORT(!is_ok_, "unwrap_err called on Result::Ok()");
-    return error_;
+    return data_.error;
   }
   inline const E &unwrap_err() const noexcept {
     EXPECT_OR_ABORT(!is_ok_, "unwrap_err called on Result::Ok()");
-    return error_;
+    return data_.error;
   }
 
   /**
@@ -833,9 +1393,9 @@ public:
    */
   template <typename F, typename U = std::invoke_result_t<F>>
   Result<U, E> map(F &&func) const noexcept(noexcept(func())) {
-    if (is_ok_)
+    if (is_ok())
       return Result<U, E>::Ok(func());
-    return Result<U, E>::Err(error_);
+    return Result<U, E>::Err(data_.error);
   }
 
   /**
@@ -849,9 +1409,21 @@ public:
   template <typename F, typename E2 = std::invoke_result_t<F, E>>
   Result<void, E2> map_err(F &&func) const
       noexcept(noexcept(func(std::declval<E>()))) {
-    if (is_ok_)
+    if (is_ok())
       return Result<void, E2>::Ok();
-    return Result<void, E2>::Err(func(error_));
+    return Result<void, E2>::Err(func(data_.error));
+  }
+
+  /**
+   * @brief Calls func(E&) on the error if Err, modifying it in place.
+   */
+  template <typename F> Result &map_err_inplace(F &&func) & {
+    if (!is_ok())
+      std::forward<F>(func)(data_.error);
+    return *this;
+  }
+  template <typename F> Result &&map_err_inplace(F &&func) && {
+    return std::move(map_err_inplace(std::forward<F>(func)));
   }
 
   /**
@@ -867,9 +1439,9 @@ public:
    */
   template <typename F, typename R = std::invoke_result_t<F>>
   R and_then(F &&func) const noexcept(noexcept(func())) {
-    if (is_ok_)
+    if (is_ok())
       return func();
-    return R::Err(error_);
+    return R::Err(data_.error);
   }
 
   /**
@@ -890,12 +1462,12 @@ public:
    */
   E &expect_err(const char msg[]) noexcept {
     EXPECT_OR_ABORT(!is_ok_, msg);
-    return error_;
+    return data_.error;
   }
 
   const E &expect_err(const char msg[]) const noexcept {
     EXPECT_OR_ABORT(!is_ok_, msg);
-    return error_;
+    return data_.error;
   }
 
   /**
@@ -907,7 +1479,7 @@ public:
    */
   template <typename F>
   const Result &inspect(F &&func) const noexcept(noexcept(func())) {
-    if (is_ok_)
+    if (is_ok())
       func();
     return *this;
   }
@@ -922,8 +1494,8 @@ public:
   template <typename F>
   const Result &inspect_err(F &&func) const
       noexcept(noexcept(func(std::declval<const E &>()))) {
-    if (!is_ok_)
-      func(error_);
+    if (!is_ok())
+      func(data_.error);
     return *this;
   }
 
@@ -939,7 +1511,7 @@ public:
   template <typename Pred>
   bool is_err_and(Pred &&pred) const
       noexcept(noexcept(pred(std::declval<E>()))) {
-    return !is_ok_ && pred(error_);
+    return !is_ok() && pred(data_.error);
   }
 
   /**
@@ -953,11 +1525,20 @@ public:
    * @endcode
    */
   std::optional<E> err() const {
-    if (!is_ok_)
-      return error_;
+    if (!is_ok())
+      return data_.error;
     return std::nullopt;
   }
 
+  /// Moves the error out if Err, leaving Err(E{}) behind.
+  template <typename E2 = E,
+            std::enable_if_t<std::is_default_constructible_v<E2>, int> = 0>
+  std::optional<E> take_err() {
+    if (is_ok())
+      return std::nullopt;
+    return std::optional<E>(std::exchange(data_.error, E{}));
+  }
+
   /**
    * @brief Returns res if the result is Ok, otherwise returns self.
    * @code
@@ -968,9 +1549,9 @@ public:
    * @endcode
    */
   template <typename R2> auto and_(R2 &&res) const {
-    if (is_ok_)
+    if (is_ok())
       return std::forward<R2>(res);
-    return Result<void, E>::Err(error_);
+    return Result<void, E>::Err(data_.error);
   }
 
   /**
@@ -983,7 +1564,7 @@ public:
    * @endcode
    */
   template <typename R2> auto or_(R2 &&res) const {
-    if (!is_ok_)
+    if (!is_ok())
       return std::forward<R2>(res);
     return *this;
   }
@@ -997,7 +1578,7 @@ public:
    * @endcode
    */
   template <typename U, typename F> U map_or(U default_value, F &&func) const {
-    return is_ok_ ? func() : default_value;
+    return is_ok() ? func() : default_value;
   }
 
   /**
@@ -1011,7 +1592,7 @@ public:
    */
   template <typename D, typename F>
   auto map_or_else(D &&default_fn, F &&func) const {
-    return is_ok_ ? func() : default_fn();
+    return is_ok() ? func() : default_fn();
   }
 
   /**
@@ -1021,52 +1602,46 @@ public:
    * assert(err.contains_err("fail"));
    * @endcode
    */
-  bool contains_err(const E &error) const { return !is_ok_ && error_ == error; }
-
-  // Move semantics
-  Result(Result &&other) noexcept(std::is_nothrow_move_constructible_v<E>)
-      : is_ok_(other.is_ok_) {
-    if (!is_ok_)
-      new (&error_) E(std::move(other.error_));
-  }
-
-  Result &
-  operator=(Result &&other) noexcept(std::is_nothrow_move_assignable_v<E>) {
-    if (this != &other) {
-      is_ok_ = other.is_ok_;
-      if (!is_ok_)
-        new (&error_) E(std::move(other.error_));
-    }
-    return *this;
-  }
-
-  // Conditional copy semantics
-  Result(const Result &other) noexcept(std::is_nothrow_copy_constructible_v<E>)
-      : is_ok_(other.is_ok_) {
-    if (!is_ok_)
-      new (&error_) E(other.error_);
-  }
+  bool contains_err(const E &error) const { return !is_ok() && data_.error == error; }
 
-  Result &operator=(const Result &other) noexcept(
-      std::is_nothrow_copy_assignable_v<E>) {
-    if (this != &other) {
-      is_ok_ = other.is_ok_;
-      if (!is_ok_)
-        new (&error_) E(other.error_);
-    }
-    return *this;
-  }
+  Result(Result &&) = default;
+  Result &operator=(Result &&) = default;
+  Result(const Result &) = default;
+  Result &operator=(const Result &) = default;
 
 private:
-  E error_;
-  bool is_ok_;
-
-  Result() noexcept : is_ok_(true) {}
-  explicit Result(E err) noexcept : is_ok_(false) {
-    new (&error_) E(std::move(err));
-  }
+  Result() noexcept : Storage(detail::OkTag{}, detail::Unit{}) {}
+  template <typename U>
+  Result(detail::ErrTag, U &&err) noexcept(
+      std::is_nothrow_constructible_v<E, U &&>)
+      : Storage(detail::ErrTag{}, std::forward<U>(err)) {}
+  template <typename Ref>
+  Result(detail::Propagated<Ref> &&p, std::false_type) noexcept(
+      std::is_nothrow_constructible_v<E, Ref>)
+      : Storage(detail::ErrTag{}, static_cast<Ref>(p.error)) {}
+  template <typename Ref>
+  Result(detail::Propagated<Ref> &&, std::true_type) noexcept
+      : Storage(detail::NeverTag{}) {}
 };
 
+/**
+ * @brief is_ok() hinted as likely at this call site, whatever the type's
+ * result_bias.
+ * @code
+ * if (cpp_result::likely_ok(r)) fast_path(r.unwrap());
+ * @endcode
+ */
+template <typename T, typename E>
+constexpr bool likely_ok(const Result<T, E> &r) noexcept {
+  return detail::hint_ok<ResultBias::LikelyOk>(r.is_ok());
+}
+
+/// is_err() hinted as likely at this call site.
+template <typename T, typename E>
+constexpr bool likely_err(const Result<T, E> &r) noexcept {
+  return !detail::hint_ok<ResultBias::LikelyErr>(r.is_ok());
+}
+
 template <typename T, typename E> inline Result<T, E> Ok(T val) {
   return Result<T, E>::Ok(std::move(val));
 }
@@ -0,0 +1,51 @@
+/* Test plugin written in C against abi.h, loaded by abi_tests with dlopen. */
+
+#include <cpp_result/abi.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+cpp_result_abi_i64 plugin_divide(int64_t a, int64_t b) {
+  if (b == 0)
+    return CPP_RESULT_ABI_ERR(cpp_result_abi_i64, EDOM);
+  return CPP_RESULT_ABI_OK(cpp_result_abi_i64, a / b);
+}
+
+cpp_result_abi_void plugin_check_positive(int64_t v) {
+  if (v <= 0)
+    return CPP_RESULT_ABI_ERR(cpp_result_abi_void, ERANGE);
+  return (cpp_result_abi_void){.is_ok = CPP_RESULT_ABI_TAG_OK};
+}
+
+static void release_error(cpp_result_error *err) {
+  free((void *)err->message);
+  free(err);
+}
+
+cpp_result_abi_i64_boxed plugin_parse(const char *text) {
+  char *end = NULL;
+  errno = 0;
+  long long value = strtoll(text, &end, 10);
+  if (errno == 0 && end != text && *end == '\0')
+    return CPP_RESULT_ABI_OK(cpp_result_abi_i64_boxed, (int64_t)value);
+
+  cpp_result_error *err = malloc(sizeof(*err));
+  size_t len = strlen(text) + sizeof("not a number: ");
+  char *message = malloc(len);
+  snprintf(message, len, "not a number: %s", text);
+  err->code = errno ? errno : EINVAL;
+  err->message = message;
+  err->release = release_error;
+  return CPP_RESULT_ABI_ERR(cpp_result_abi_i64_boxed, err);
+}
+
+/* Calls back into the host and passes its result through unchanged. */
+cpp_result_abi_i64 plugin_apply(cpp_result_abi_i64 (*fn)(int64_t),
+                                int64_t arg) {
+  cpp_result_abi_i64 r = fn(arg);
+  if (r.is_ok)
+    r.u.ok *= 2;
+  return r;
+}
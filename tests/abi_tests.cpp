@@ -0,0 +1,111 @@
+#include <cerrno>
+#include <cpp_result/abi.hpp>
+#include <dlfcn.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using cpp_result::ErrorBox;
+using cpp_result::Result;
+
+static_assert(std::is_same_v<cpp_result::abi_result_t<cpp_result_abi_i64>,
+                             Result<std::int64_t, std::int32_t>>);
+static_assert(std::is_same_v<cpp_result::abi_result_t<cpp_result_abi_void>,
+                             Result<void, std::int32_t>>);
+static_assert(cpp_result::abi_in_registers_v<cpp_result_abi_i64>);
+static_assert(cpp_result::abi_in_registers_v<cpp_result_abi_i64_boxed>);
+
+TEST(AbiTest, RoundTripIsLossless) {
+  auto ok = cpp_result::to_abi<cpp_result_abi_f64>(
+      Result<double, std::int32_t>::Ok(2.5));
+  EXPECT_EQ(ok.is_ok, CPP_RESULT_ABI_TAG_OK);
+  EXPECT_EQ(cpp_result::from_abi(ok).unwrap(), 2.5);
+
+  auto err = cpp_result::to_abi<cpp_result_abi_f64>(
+      Result<double, std::int32_t>::Err(-3));
+  EXPECT_EQ(err.is_ok, CPP_RESULT_ABI_TAG_ERR);
+  EXPECT_EQ(cpp_result::from_abi(err).unwrap_err(), -3);
+
+  auto v = cpp_result::to_abi<cpp_result_abi_void>(
+      Result<void, std::int32_t>::Ok());
+  EXPECT_TRUE(cpp_result::from_abi(v).is_ok());
+}
+
+TEST(AbiTest, CustomLayout) {
+  struct Point {
+    float x, y;
+  };
+  CPP_RESULT_ABI_DECLARE(point_result, Point, std::uint16_t);
+  static_assert(sizeof(point_result) <= 16);
+  auto abi = cpp_result::to_abi<point_result>(
+      Result<Point, std::uint16_t>::Ok({1.f, 2.f}));
+  EXPECT_EQ(cpp_result::from_abi(abi).unwrap().y, 2.f);
+}
+
+TEST(AbiTest, BoxedErrorOwnsItsMessage) {
+  auto *raw = cpp_result::box_error(42, "out of cheese");
+  ErrorBox box(raw);
+  EXPECT_EQ(box.code(), 42);
+  EXPECT_EQ(box.message(), "out of cheese");
+  ErrorBox moved(std::move(box));
+  EXPECT_EQ(box.message(), "");
+  EXPECT_EQ(moved.message(), "out of cheese");
+}
+
+static cpp_result_abi_i64 host_square(std::int64_t v) {
+  if (v > 3037000499)
+    return cpp_result::to_abi<cpp_result_abi_i64>(
+        Result<std::int64_t, std::int32_t>::Err(EOVERFLOW));
+  return cpp_result::to_abi<cpp_result_abi_i64>(
+      Result<std::int64_t, std::int32_t>::Ok(v * v));
+}
+
+class AbiPluginTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    handle_ = dlopen(CPP_RESULT_ABI_PLUGIN, RTLD_NOW | RTLD_LOCAL);
+    ASSERT_NE(handle_, nullptr) << dlerror();
+  }
+  void TearDown() override {
+    if (handle_)
+      dlclose(handle_);
+  }
+  template <typename Fn> Fn *symbol(const char *name) {
+    return reinterpret_cast<Fn *>(dlsym(handle_, name));
+  }
+
+  void *handle_ = nullptr;
+};
+
+TEST_F(AbiPluginTest, ResultsCrossTheBoundaryByValue) {
+  auto divide = symbol<cpp_result_abi_i64(std::int64_t, std::int64_t)>(
+      "plugin_divide");
+  ASSERT_NE(divide, nullptr);
+  EXPECT_EQ(cpp_result::from_abi(divide(84, 2)).unwrap(), 42);
+  EXPECT_EQ(cpp_result::from_abi(divide(1, 0)).unwrap_err(), EDOM);
+
+  auto check = symbol<cpp_result_abi_void(std::int64_t)>(
+      "plugin_check_positive");
+  ASSERT_NE(check, nullptr);
+  EXPECT_TRUE(cpp_result::from_abi(check(5)).is_ok());
+  EXPECT_EQ(cpp_result::from_abi(check(-5)).unwrap_err(), ERANGE);
+}
+
+TEST_F(AbiPluginTest, BoxedErrorIsReleasedByThePlugin) {
+  auto parse = symbol<cpp_result_abi_i64_boxed(const char *)>("plugin_parse");
+  ASSERT_NE(parse, nullptr);
+  EXPECT_EQ(cpp_result::from_abi(parse("123")).unwrap(), 123);
+
+  auto bad = cpp_result::from_abi(parse("12x")).map_err(ErrorBox::adopt);
+  ASSERT_TRUE(bad.is_err());
+  EXPECT_EQ(bad.unwrap_err().code(), EINVAL);
+  EXPECT_EQ(bad.unwrap_err().message(), "not a number: 12x");
+}
+
+TEST_F(AbiPluginTest, PluginCallsBackIntoHost) {
+  auto apply = symbol<cpp_result_abi_i64(cpp_result_abi_i64 (*)(std::int64_t),
+                                         std::int64_t)>("plugin_apply");
+  ASSERT_NE(apply, nullptr);
+  EXPECT_EQ(cpp_result::from_abi(apply(host_square, 5)).unwrap(), 50);
+  EXPECT_EQ(cpp_result::from_abi(apply(host_square, 1LL << 40)).unwrap_err(),
+            EOVERFLOW);
+}
@@ -0,0 +1,37 @@
+// Every header in one translation unit: catches names that two optional
+// headers both declare, which per-header tests cannot see.
+#include <result.hpp>
+
+#include <cpp_result/abi.hpp>
+#include <cpp_result/byte_reader.hpp>
+#include <cpp_result/circuit_breaker.hpp>
+#include <cpp_result/codec.hpp>
+#include <cpp_result/columnar.hpp>
+#include <cpp_result/exception.hpp>
+#include <cpp_result/fallible.hpp>
+#include <cpp_result/format.hpp>
+#include <cpp_result/interop.hpp>
+#include <cpp_result/mapped_file.hpp>
+#include <cpp_result/memoize.hpp>
+#include <cpp_result/net.hpp>
+#include <cpp_result/object_pool.hpp>
+#include <cpp_result/pipeline.hpp>
+#include <cpp_result/poll.hpp>
+#include <cpp_result/posix.hpp>
+#include <cpp_result/result_tuple.hpp>
+#include <cpp_result/retry.hpp>
+#include <cpp_result/shm_queue.hpp>
+#include <cpp_result/site.hpp>
+#include <cpp_result/uring.hpp>
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <type_traits>
+
+TEST(AllHeadersTest, CodecAndTupleViewsAreDistinct) {
+  using Field = cpp_result::Result<std::uint32_t, int>;
+  cpp_result::ResultTuple<Field> tuple(Field::Ok(7));
+  static_assert(!std::is_same_v<decltype(tuple.get<0>()),
+                                cpp_result::ResultView<std::uint32_t, int>>);
+  EXPECT_EQ(tuple.get<0>().unwrap(), 7u);
+}
@@ -0,0 +1,140 @@
+#include <cpp_result/byte_reader.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+using cpp_result::ByteReader;
+using cpp_result::DecodeError;
+
+static void put_varint(std::vector<std::byte> &out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::byte>((v & 0x7f) | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::byte>(v));
+}
+
+template <typename T>
+static void put(std::vector<std::byte> &out, const T &value) {
+  const auto *p = reinterpret_cast<const std::byte *>(&value);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+TEST(ByteReaderTest, ReadScalars) {
+  std::vector<std::byte> buf;
+  put<std::uint32_t>(buf, 0xdeadbeef);
+  put<double>(buf, 2.5);
+  ByteReader r(buf.data(), buf.size());
+  EXPECT_EQ(r.read<std::uint32_t>().unwrap(), 0xdeadbeefu);
+  EXPECT_EQ(r.read<double>().unwrap(), 2.5);
+  EXPECT_TRUE(r.empty());
+}
+
+TEST(ByteReaderTest, ReadPastEndIsErrAndKeepsPosition) {
+  std::vector<std::byte> buf(3);
+  ByteReader r(buf.data(), buf.size());
+  auto res = r.read<std::uint32_t>();
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err(),
+            (DecodeError{DecodeError::Kind::UnexpectedEof, 0}));
+  EXPECT_EQ(r.position(), 0u);
+  EXPECT_EQ(r.read<std::uint16_t>().unwrap(), 0u);
+  EXPECT_EQ(r.read<std::uint16_t>().unwrap_err().offset, 2u);
+}
+
+TEST(ByteReaderTest, VarintRoundTrip) {
+  const std::uint64_t values[] = {0,
+                                  1,
+                                  127,
+                                  128,
+                                  300,
+                                  (1ull << 35) + 17,
+                                  (1ull << 56) - 1,
+                                  1ull << 56,
+                                  (1ull << 63) + 5,
+                                  ~0ull};
+  std::vector<std::byte> buf;
+  for (auto v : values)
+    put_varint(buf, v);
+  ByteReader r(buf.data(), buf.size());
+  for (auto v : values)
+    EXPECT_EQ(r.read_varint().unwrap(), v);
+  EXPECT_TRUE(r.empty());
+}
+
+TEST(ByteReaderTest, VarintFastPathWithTrailingData) {
+  std::vector<std::byte> buf;
+  put_varint(buf, 300);
+  put<std::uint64_t>(buf, 0xffffffffffffffffull);
+  ByteReader r(buf.data(), buf.size());
+  EXPECT_EQ(r.read_varint().unwrap(), 300u);
+  EXPECT_EQ(r.position(), 2u);
+}
+
+TEST(ByteReaderTest, VarintTruncated) {
+  std::vector<std::byte> buf{std::byte{0x80}, std::byte{0x80}};
+  ByteReader r(buf.data(), buf.size());
+  auto res = r.read_varint();
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err().kind, DecodeError::Kind::UnexpectedEof);
+  EXPECT_EQ(r.position(), 0u);
+}
+
+TEST(ByteReaderTest, VarintOverflow) {
+  std::vector<std::byte> buf(9, std::byte{0xff});
+  buf.push_back(std::byte{0x02});
+  ByteReader r(buf.data(), buf.size());
+  EXPECT_EQ(r.read_varint().unwrap_err().kind,
+            DecodeError::Kind::VarintOverflow);
+}
+
+TEST(ByteReaderTest, StringViewIsZeroCopy) {
+  std::vector<std::byte> buf;
+  put_varint(buf, 5);
+  for (char c : std::string_view("hello"))
+    buf.push_back(static_cast<std::byte>(c));
+  ByteReader r(buf.data(), buf.size());
+  auto s = r.read_string_view().unwrap();
+  EXPECT_EQ(s, "hello");
+  EXPECT_EQ(static_cast<const void *>(s.data()),
+            static_cast<const void *>(buf.data() + 1));
+}
+
+TEST(ByteReaderTest, StringViewTruncatedRewinds) {
+  std::vector<std::byte> buf;
+  put_varint(buf, 10);
+  buf.push_back(std::byte{'x'});
+  ByteReader r(buf.data(), buf.size());
+  auto res = r.read_string_view();
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err().offset, 0u);
+  EXPECT_EQ(r.position(), 0u);
+}
+
+TEST(ByteReaderTest, ReadBytesAndSkip) {
+  std::vector<std::byte> buf(8);
+  for (std::size_t i = 0; i < buf.size(); ++i)
+    buf[i] = static_cast<std::byte>(i);
+  ByteReader r(buf.data(), buf.size());
+  EXPECT_TRUE(r.skip(2).is_ok());
+  auto bytes = r.read_bytes(3).unwrap();
+  EXPECT_EQ(bytes.size(), 3u);
+  EXPECT_EQ(bytes[0], std::byte{2});
+  EXPECT_EQ(bytes.data(), buf.data() + 2);
+  EXPECT_TRUE(r.read_bytes(4).is_err());
+  EXPECT_TRUE(r.skip(4).is_err());
+}
+
+TEST(ByteReaderTest, ReserveThenReadUnchecked) {
+  std::vector<std::byte> buf;
+  put<std::uint32_t>(buf, 7);
+  put<std::uint16_t>(buf, 9);
+  ByteReader r(buf.data(), buf.size());
+  EXPECT_TRUE(r.reserve(7).is_err());
+  EXPECT_EQ(r.position(), 0u);
+  auto rec = r.reserve(6).unwrap();
+  EXPECT_EQ(r.position(), 6u);
+  EXPECT_EQ(rec.read<std::uint32_t>(), 7u);
+  EXPECT_EQ(rec.read<std::uint16_t>(), 9u);
+  EXPECT_EQ(rec.remaining(), 0u);
+}
@@ -0,0 +1,141 @@
+#include <atomic>
+#include <chrono>
+#include <cpp_result/circuit_breaker.hpp>
+#include <functional>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fake_clock.hpp"
+
+using cpp_result::BreakerPolicy;
+using cpp_result::BreakerState;
+using cpp_result::Result;
+using namespace std::chrono_literals;
+
+enum class Err { Unavailable, NotFound, Open };
+using R = Result<int, Err>;
+using Breaker = cpp_result::CircuitBreaker<Err, FakeClock>;
+
+static BreakerPolicy small_policy() {
+  BreakerPolicy policy;
+  policy.window = 1s;
+  policy.buckets = 10;
+  policy.failure_threshold = 0.5;
+  policy.min_calls = 4;
+  policy.cooldown = 500ms;
+  policy.probes = 2;
+  return policy;
+}
+
+TEST(CircuitBreakerTest, OpensOnFailureRateAndShortCircuits) {
+  Breaker breaker(Err::Open, small_policy());
+  int calls = 0;
+  auto ok = [&] { return ++calls, R::Ok(1); };
+  auto fail = [&] { return ++calls, R::Err(Err::Unavailable); };
+
+  (void)breaker.call(ok);
+  (void)breaker.call(ok);
+  (void)breaker.call(fail);
+  EXPECT_EQ(breaker.state(), BreakerState::Closed); // below min_calls
+  (void)breaker.call(fail);
+  EXPECT_EQ(breaker.state(), BreakerState::Open);
+  EXPECT_EQ(breaker.window().failures, 2u);
+  EXPECT_EQ(breaker.window().successes, 2u);
+
+  EXPECT_EQ(breaker.call(ok).unwrap_err(), Err::Open);
+  EXPECT_EQ(calls, 4);
+  EXPECT_EQ(breaker.rejected(), 1u);
+}
+
+TEST(CircuitBreakerTest, ClassifierDecidesWhatCounts) {
+  Breaker breaker(Err::Open, small_policy());
+  auto not_found = [] { return R::Err(Err::NotFound); };
+  auto retryable = [](Err e) { return e == Err::Unavailable; };
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(breaker.call(not_found, retryable).unwrap_err(), Err::NotFound);
+  EXPECT_EQ(breaker.state(), BreakerState::Closed);
+  EXPECT_EQ(breaker.window().successes, 10u);
+}
+
+TEST(CircuitBreakerTest, WindowSlides) {
+  Breaker breaker(Err::Open, small_policy());
+  auto fail = [] { return R::Err(Err::Unavailable); };
+  auto ok = [] { return R::Ok(1); };
+  (void)breaker.call(fail);
+  (void)breaker.call(fail);
+  (void)breaker.call(fail);
+  FakeClock::advance(2s); // old failures fall out of the window
+  EXPECT_EQ(breaker.window().failures, 0u);
+  (void)breaker.call(ok);
+  (void)breaker.call(ok);
+  (void)breaker.call(ok);
+  (void)breaker.call(fail);
+  EXPECT_EQ(breaker.state(), BreakerState::Closed);
+}
+
+TEST(CircuitBreakerTest, HalfOpenProbesCloseOrReopen) {
+  Breaker breaker(Err::Open, small_policy());
+  auto fail = [] { return R::Err(Err::Unavailable); };
+  auto ok = [] { return R::Ok(7); };
+  for (int i = 0; i < 4; ++i)
+    (void)breaker.call(fail);
+  ASSERT_EQ(breaker.state(), BreakerState::Open);
+
+  FakeClock::advance(600ms);
+  EXPECT_TRUE(breaker.call(fail).is_err());
+  EXPECT_EQ(breaker.state(), BreakerState::Open); // failed probe re-opens
+  EXPECT_EQ(breaker.call(ok).unwrap_err(), Err::Open);
+
+  FakeClock::advance(600ms);
+  EXPECT_EQ(breaker.call(ok).unwrap(), 7);
+  EXPECT_EQ(breaker.state(), BreakerState::HalfOpen);
+  EXPECT_EQ(breaker.call(ok).unwrap(), 7);
+  EXPECT_EQ(breaker.state(), BreakerState::Closed);
+  EXPECT_EQ(breaker.window().failures, 0u);
+}
+
+TEST(CircuitBreakerTest, HalfOpenLimitsConcurrentProbes) {
+  Breaker breaker(Err::Open, small_policy());
+  auto fail = [] { return R::Err(Err::Unavailable); };
+  for (int i = 0; i < 4; ++i)
+    (void)breaker.call(fail);
+  FakeClock::advance(600ms);
+
+  // Each probe starts another call before finishing: only `probes` run.
+  int entered = 0;
+  std::function<R()> nested = [&]() -> R {
+    ++entered;
+    (void)breaker.call(nested);
+    return R::Ok(1);
+  };
+  (void)breaker.call(nested);
+  EXPECT_EQ(entered, 2);
+  EXPECT_EQ(breaker.rejected(), 1u);
+  EXPECT_EQ(breaker.state(), BreakerState::Closed);
+}
+
+TEST(CircuitBreakerTest, CountsAreExactWithManyThreads) {
+  // More threads than stripes, so several share a bucket word.
+  Breaker breaker(Err::Open, small_policy());
+  constexpr int kThreads = 40, kCalls = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+    threads.emplace_back([&] {
+      for (int i = 0; i < kCalls; ++i)
+        (void)breaker.call([] { return R::Ok(1); });
+    });
+  for (auto &t : threads)
+    t.join();
+  EXPECT_EQ(breaker.window().successes, std::uint64_t{kThreads} * kCalls);
+  EXPECT_EQ(breaker.window().failures, 0u);
+}
+
+TEST(CircuitBreakerTest, WorksWithVoidAndStringResults) {
+  cpp_result::CircuitBreaker<std::string> breaker("circuit open");
+  auto r = breaker.call([] { return Result<void, std::string>::Ok(); });
+  EXPECT_TRUE(r.is_ok());
+  breaker.reset();
+  EXPECT_EQ(breaker.state(), BreakerState::Closed);
+}
@@ -0,0 +1,146 @@
+#include <cpp_result/codec.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using cpp_result::ByteReader;
+using cpp_result::ByteWriter;
+using cpp_result::DecodeError;
+using cpp_result::Result;
+
+struct Point {
+  int x;
+  int y;
+};
+
+TEST(CodecTest, TriviallyCopyableRoundTrip) {
+  auto ok = cpp_result::encode(Result<Point, int>::Ok({3, -4}));
+  EXPECT_EQ(ok.size(), 1 + sizeof(Point));
+  ByteReader r(ok.data(), ok.size());
+  auto decoded = cpp_result::decode<Point, int>(r);
+  ASSERT_TRUE(decoded.is_ok());
+  ASSERT_TRUE(decoded.unwrap().is_ok());
+  EXPECT_EQ(decoded.unwrap().unwrap().x, 3);
+  EXPECT_EQ(decoded.unwrap().unwrap().y, -4);
+  EXPECT_TRUE(r.empty());
+
+  auto err = cpp_result::encode(Result<Point, int>::Err(7));
+  ByteReader r2(err.data(), err.size());
+  auto derr = cpp_result::decode<Point, int>(r2);
+  ASSERT_TRUE(derr.is_ok());
+  ASSERT_TRUE(derr.unwrap().is_err());
+  EXPECT_EQ(derr.unwrap().unwrap_err(), 7);
+}
+
+TEST(CodecTest, StringsDecodeAsViewsIntoTheBuffer) {
+  auto buf = cpp_result::encode(
+      Result<int, std::string>::Err(std::string("disk full")));
+  ByteReader r(buf.data(), buf.size());
+  auto decoded = cpp_result::decode<int, std::string>(r);
+  ASSERT_TRUE(decoded.is_ok());
+  std::string_view msg = decoded.unwrap().unwrap_err();
+  EXPECT_EQ(msg, "disk full");
+  EXPECT_EQ(static_cast<const void *>(msg.data()),
+            static_cast<const void *>(buf.data() + 2));
+}
+
+TEST(CodecTest, VoidOkHasNoPayload) {
+  auto buf = cpp_result::encode(Result<void, int>::Ok());
+  EXPECT_EQ(buf.size(), 1u);
+  ByteReader r(buf.data(), buf.size());
+  auto decoded = cpp_result::decode<void, int>(r);
+  ASSERT_TRUE(decoded.is_ok());
+  EXPECT_TRUE(decoded.unwrap().is_ok());
+}
+
+TEST(CodecTest, RejectsUnknownVersionAndTruncatedInput) {
+  auto buf = cpp_result::encode(Result<int, int>::Ok(1));
+  buf[0] = std::byte{0x21};
+  ByteReader r(buf.data(), buf.size());
+  auto bad = cpp_result::decode<int, int>(r);
+  ASSERT_TRUE(bad.is_err());
+  EXPECT_EQ(bad.unwrap_err(), (DecodeError{DecodeError::Kind::InvalidTag, 0}));
+
+  auto full = cpp_result::encode(Result<int, int>::Ok(1));
+  ByteReader cut(full.data(), full.size() - 1);
+  auto eof = cpp_result::decode<int, int>(cut);
+  ASSERT_TRUE(eof.is_err());
+  EXPECT_EQ(eof.unwrap_err().kind, DecodeError::Kind::UnexpectedEof);
+}
+
+TEST(CodecTest, BatchRoundTripUsesOneBitPerTag) {
+  std::vector<Result<std::uint32_t, std::string>> in;
+  for (std::uint32_t i = 0; i < 20; ++i)
+    in.push_back(i % 3 ? Result<std::uint32_t, std::string>::Ok(i)
+                       : Result<std::uint32_t, std::string>::Err(
+                             "e" + std::to_string(i)));
+  std::vector<std::byte> buf;
+  ByteWriter w(buf);
+  cpp_result::encode_batch(w, in);
+
+  ByteReader r(buf.data(), buf.size());
+  auto out = cpp_result::decode_batch<std::uint32_t, std::string>(r);
+  ASSERT_TRUE(out.is_ok());
+  ASSERT_EQ(out.unwrap().size(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    ASSERT_EQ(out.unwrap()[i].is_ok(), in[i].is_ok());
+    if (in[i].is_ok())
+      EXPECT_EQ(out.unwrap()[i].unwrap(), in[i].unwrap());
+    else
+      EXPECT_EQ(out.unwrap()[i].unwrap_err(), in[i].unwrap_err());
+  }
+  EXPECT_TRUE(r.empty());
+}
+
+TEST(CodecTest, BatchWithCorruptCountFails) {
+  std::vector<std::byte> buf;
+  ByteWriter w(buf);
+  w.write(static_cast<std::uint8_t>(0x18));
+  w.write_varint(std::uint64_t{1} << 40);
+  ByteReader r(buf.data(), buf.size());
+  auto out = cpp_result::decode_batch<int, int>(r);
+  ASSERT_TRUE(out.is_err());
+  EXPECT_EQ(out.unwrap_err().kind, DecodeError::Kind::UnexpectedEof);
+}
+
+// A count near 2^64 used to wrap the bitmap size to 0 and index past it.
+TEST(CodecTest, BatchWithWrappingCountFails) {
+  const unsigned char input[] = {0x18, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                 0xff, 0xff, 0xff, 0x01, 0xff};
+  ByteReader r(reinterpret_cast<const std::byte *>(input), sizeof(input));
+  auto out = cpp_result::decode_batch<void, std::uint8_t>(r);
+  ASSERT_TRUE(out.is_err());
+  EXPECT_EQ(out.unwrap_err(),
+            (DecodeError{DecodeError::Kind::UnexpectedEof, 11}));
+}
+
+struct Status {
+  std::string reason;
+  int code;
+};
+
+template <> struct cpp_result::Encoder<Status> {
+  using view_type = std::pair<std::string_view, int>;
+  static void encode(ByteWriter &w, const Status &s) {
+    w.write_string(s.reason);
+    w.write(s.code);
+  }
+  static Result<view_type, DecodeError> decode(ByteReader &r) {
+    auto reason = r.read_string_view();
+    if (reason.is_err())
+      return Result<view_type, DecodeError>::Err(reason.unwrap_err());
+    auto code = r.read<int>();
+    if (code.is_err())
+      return Result<view_type, DecodeError>::Err(code.unwrap_err());
+    return Result<view_type, DecodeError>::Ok({reason.unwrap(), code.unwrap()});
+  }
+};
+
+TEST(CodecTest, CustomEncoder) {
+  auto buf = cpp_result::encode(Result<int, Status>::Err({"timeout", 504}));
+  ByteReader r(buf.data(), buf.size());
+  auto decoded = cpp_result::decode<int, Status>(r);
+  ASSERT_TRUE(decoded.is_ok());
+  EXPECT_EQ(decoded.unwrap().unwrap_err().first, "timeout");
+  EXPECT_EQ(decoded.unwrap().unwrap_err().second, 504);
+}
@@ -0,0 +1,28 @@
+# Compiles SOURCE to x86-64 assembly at -O2 and fails if it contains a
+# conditional jump. Usage:
+#   cmake -DCXX=<compiler> -DINCLUDE=<dir> -DSOURCE=<file> -DOUTPUT=<file.s>
+#         -P check_branchless.cmake
+
+execute_process(
+    COMMAND ${CXX} -std=c++17 -O2 -I${INCLUDE} -S -o ${OUTPUT} ${SOURCE}
+    RESULT_VARIABLE status
+    ERROR_VARIABLE errors)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "compiling ${SOURCE} failed:\n${errors}")
+endif()
+
+file(STRINGS ${OUTPUT} lines)
+set(function "")
+set(jumps "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^([A-Za-z_][A-Za-z0-9_]*):")
+        set(function ${CMAKE_MATCH_1})
+    elseif(line MATCHES "^[ \t]+(j[a-z]+)[ \t]" AND NOT CMAKE_MATCH_1 STREQUAL "jmp")
+        list(APPEND jumps "${function}: ${CMAKE_MATCH_1}")
+    endif()
+endforeach()
+
+if(jumps)
+    string(REPLACE ";" "\n  " jumps "${jumps}")
+    message(FATAL_ERROR "conditional jumps in ${OUTPUT}:\n  ${jumps}")
+endif()
@@ -0,0 +1,39 @@
+// Functions whose x86-64 code must contain no conditional jump; checked by
+// check_branchless.cmake on the compiler's -O2 assembly.
+#include <cstdint>
+#include <result.hpp>
+
+using cpp_result::Result;
+
+extern "C" {
+
+int select_or_int(const Result<int, int> &r, int fallback) {
+  return r.select_or(fallback);
+}
+
+std::uint64_t unwrap_or_zero_u64(const Result<std::uint64_t, short> &r) {
+  return r.unwrap_or_zero();
+}
+
+const char *select_or_ptr(const Result<const char *, int> &r,
+                          const char *fallback) {
+  return r.select_or(fallback);
+}
+
+std::uint32_t ok_mask_void(const Result<void, int> &r, std::uint32_t bits) {
+  return bits & r.ok_mask<std::uint32_t>();
+}
+
+struct Pair {
+  double x, y;
+};
+
+double select_or_double(const Result<double, int> &r, double fallback) {
+  return r.select_or(fallback);
+}
+
+Pair select_or_pair(const Result<Pair, int> &r, const Pair &fallback) {
+  return r.select_or(fallback);
+}
+
+} // extern "C"
@@ -0,0 +1,206 @@
+#include <cpp_result/columnar.hpp>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using cpp_result::ColumnarError;
+using cpp_result::Result;
+
+enum class Fault : std::uint8_t { Timeout, Refused, Corrupt };
+
+class ColumnarTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "columnar_" + std::to_string(getpid()) +
+            "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  }
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  std::string path_;
+};
+
+TEST_F(ColumnarTest, RoundTripWithRandomAccess) {
+  std::vector<Result<double, Fault>> rows;
+  for (int i = 0; i < 3000; ++i)
+    rows.push_back(i % 7 == 3 ? Result<double, Fault>::Err(
+                                    static_cast<Fault>(i % 3))
+                              : Result<double, Fault>::Ok(i * 0.5));
+  {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<double, Fault>::create(path_.c_str())
+            .unwrap());
+    for (auto &r : rows)
+      ASSERT_TRUE(w.append(r).is_ok());
+    EXPECT_EQ(w.finish().unwrap(), rows.size());
+  }
+
+  auto opened = cpp_result::ColumnarReader<double, Fault>::open(path_.c_str());
+  ASSERT_TRUE(opened.is_ok());
+  auto &col = opened.unwrap();
+  ASSERT_EQ(col.rows(), rows.size());
+  EXPECT_EQ(col.ok_rows() + col.err_rows(), col.rows());
+  EXPECT_EQ(col.dictionary().size(), 3u);
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    auto got = col.at(i);
+    ASSERT_EQ(got.is_ok(), rows[i].is_ok()) << i;
+    if (got.is_ok())
+      EXPECT_EQ(got.unwrap(), rows[i].unwrap());
+    else
+      EXPECT_EQ(got.unwrap_err(), rows[i].unwrap_err());
+  }
+  EXPECT_EQ(col.values()[1], 0.5);
+}
+
+TEST_F(ColumnarTest, FiltersAndRangeCounts) {
+  {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<std::uint32_t, Fault>::create(path_.c_str())
+            .unwrap());
+    for (std::uint32_t i = 0; i < 2000; ++i) {
+      if (i % 100 == 0)
+        (void)w.append_err(Fault::Timeout);
+      else if (i % 250 == 1)
+        (void)w.append_err(Fault::Refused);
+      else
+        (void)w.append_ok(i);
+    }
+    ASSERT_TRUE(w.finish().is_ok());
+  }
+  auto col = std::move(
+      cpp_result::ColumnarReader<std::uint32_t, Fault>::open(path_.c_str())
+          .unwrap());
+  EXPECT_EQ(col.count_errors_of(Fault::Timeout), 20u);
+  EXPECT_EQ(col.count_errors_of(Fault::Refused), 8u);
+  EXPECT_EQ(col.count_errors_of(Fault::Corrupt), 0u);
+  auto refused = col.errors_of(Fault::Refused);
+  ASSERT_EQ(refused.size(), 8u);
+  EXPECT_EQ(refused[0], 1u);
+  EXPECT_EQ(refused[1], 251u);
+
+  EXPECT_EQ(col.count_ok(), 2000u - 28u);
+  EXPECT_EQ(col.count_ok(0, 2000), col.count_ok());
+  EXPECT_EQ(col.count_ok(0, 100), 98u);  // rows 0 and 1 are errors
+  // 600, 700, 800, 900, 1000 and 751, 1001 are errors
+  EXPECT_EQ(col.count_ok(600, 1100), 493u);
+  EXPECT_EQ(col.count_ok(5, 5), 0u);
+}
+
+TEST_F(ColumnarTest, StringErrorsDecodeAsViews) {
+  {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<std::int64_t, std::string>::create(
+            path_.c_str())
+            .unwrap());
+    (void)w.append_ok(1);
+    (void)w.append_err("disk full");
+    (void)w.append_err("disk full");
+    (void)w.append_err("timeout");
+    ASSERT_TRUE(w.finish().is_ok());
+  }
+  auto col = std::move(
+      cpp_result::ColumnarReader<std::int64_t, std::string>::open(
+          path_.c_str())
+          .unwrap());
+  EXPECT_EQ(col.dictionary().size(), 2u);
+  EXPECT_EQ(col.at(2).unwrap_err(), "disk full");
+  EXPECT_EQ(col.count_errors_of(std::string("disk full")), 2u);
+  EXPECT_EQ(col.errors_of(std::string("timeout")),
+            (std::vector<std::uint64_t>{3}));
+}
+
+TEST_F(ColumnarTest, EmptyFile) {
+  {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<int, Fault>::create(path_.c_str()).unwrap());
+    EXPECT_EQ(w.finish().unwrap(), 0u);
+  }
+  auto col = cpp_result::ColumnarReader<int, Fault>::open(path_.c_str());
+  ASSERT_TRUE(col.is_ok());
+  EXPECT_EQ(col.unwrap().rows(), 0u);
+  EXPECT_EQ(col.unwrap().count_ok(0, 0), 0u);
+}
+
+TEST_F(ColumnarTest, RejectsUnfinishedOrMismatchedFiles) {
+  {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<int, Fault>::create(path_.c_str()).unwrap());
+    (void)w.append_ok(1);
+  } // never finished
+  auto unfinished = cpp_result::ColumnarReader<int, Fault>::open(path_.c_str());
+  ASSERT_TRUE(unfinished.is_err());
+  EXPECT_EQ(unfinished.unwrap_err().kind, ColumnarError::Kind::Format);
+
+  {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<int, Fault>::create(path_.c_str()).unwrap());
+    (void)w.append_ok(1);
+    ASSERT_TRUE(w.finish().is_ok());
+  }
+  auto wrong = cpp_result::ColumnarReader<double, Fault>::open(path_.c_str());
+  ASSERT_TRUE(wrong.is_err());
+  EXPECT_EQ(wrong.unwrap_err().kind, ColumnarError::Kind::Format);
+
+  auto missing =
+      cpp_result::ColumnarReader<int, Fault>::open("/nonexistent/x.col");
+  ASSERT_TRUE(missing.is_err());
+  EXPECT_EQ(missing.unwrap_err(),
+            (ColumnarError{ColumnarError::Kind::Open, cpp_result::Errno{ENOENT}}));
+}
+
+// A file with valid bounds but a bitmap, rank table or dictionary count
+// that disagrees with the footer must not open.
+TEST_F(ColumnarTest, RejectsInconsistentBitmapAndDictionary) {
+  using Footer = cpp_result::detail::ColumnarFooter;
+  auto write_file = [&] {
+    auto w = std::move(
+        cpp_result::ColumnarWriter<std::uint64_t, Fault>::create(path_.c_str())
+            .unwrap());
+    for (std::uint64_t i = 0; i < 1000; ++i)
+      (void)(i % 2 ? w.append_err(Fault::Timeout) : w.append_ok(i));
+    ASSERT_TRUE(w.finish().is_ok());
+  };
+  auto read_footer = [&](int fd, off_t &at) {
+    at = ::lseek(fd, 0, SEEK_END) - static_cast<off_t>(sizeof(Footer));
+    Footer f;
+    EXPECT_EQ(cpp_result::posix::pread_full(fd, &f, sizeof(f), at).unwrap(),
+              sizeof(f));
+    return f;
+  };
+  auto opens = [&] {
+    return cpp_result::ColumnarReader<std::uint64_t, Fault>::open(
+               path_.c_str())
+        .is_ok();
+  };
+
+  write_file();
+  ASSERT_TRUE(opens());
+  int fd = ::open(path_.c_str(), O_RDWR);
+  off_t at;
+  Footer f = read_footer(fd, at);
+  const std::uint64_t ones = ~std::uint64_t{0};
+  ASSERT_TRUE(cpp_result::posix::pwrite_full(
+                  fd, &ones, 8, static_cast<off_t>(f.bitmap_offset))
+                  .is_ok());
+  EXPECT_FALSE(opens()); // popcount above ok_rows
+  ::close(fd);
+
+  write_file();
+  fd = ::open(path_.c_str(), O_RDWR);
+  f = read_footer(fd, at);
+  const std::uint64_t bad_rank = 7;
+  ASSERT_TRUE(cpp_result::posix::pwrite_full(
+                  fd, &bad_rank, 8, static_cast<off_t>(f.ranks_offset + 8))
+                  .is_ok());
+  EXPECT_FALSE(opens());
+  ::close(fd);
+
+  write_file();
+  fd = ::open(path_.c_str(), O_RDWR);
+  f = read_footer(fd, at);
+  f.dict_entries = 0xffffffffu; // must not reserve 4G entries
+  ASSERT_TRUE(cpp_result::posix::pwrite_full(fd, &f, sizeof(f), at).is_ok());
+  EXPECT_FALSE(opens());
+  ::close(fd);
+}
@@ -0,0 +1,64 @@
+#include <cpp_result/exception.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using cpp_result::BadResultAccess;
+using cpp_result::Result;
+
+enum class ParseError { NotANumber, Overflow, Other };
+
+static Result<int, ParseError> parse(const std::string &s) {
+  return cpp_result::catch_as_result<ParseError>(
+      [&] { return std::stoi(s); },
+      [](const std::out_of_range &) { return ParseError::Overflow; },
+      [](const std::invalid_argument &) { return ParseError::NotANumber; });
+}
+
+TEST(ExceptionTest, CatchAsResultMapsSelectedExceptions) {
+  EXPECT_EQ(parse("42").unwrap(), 42);
+  EXPECT_EQ(parse("abc").unwrap_err(), ParseError::NotANumber);
+  EXPECT_EQ(parse("99999999999999999999").unwrap_err(), ParseError::Overflow);
+  // Unnamed exception types propagate.
+  EXPECT_THROW((void)cpp_result::catch_as_result<ParseError>(
+                   []() -> int { throw std::runtime_error("io"); },
+                   [](const std::logic_error &) { return ParseError::Other; }),
+               std::runtime_error);
+}
+
+TEST(ExceptionTest, HandlersMatchInOrderAndCatchAllIsLast) {
+  int calls = 0;
+  auto r = cpp_result::catch_as_result<std::string>(
+      [&] {
+        ++calls;
+        throw std::out_of_range("range");
+      },
+      [](const std::logic_error &e) { return std::string("logic: ") + e.what(); },
+      [](const std::out_of_range &) { return std::string("unreachable"); },
+      [] { return std::string("other"); });
+  static_assert(std::is_same_v<decltype(r), Result<void, std::string>>);
+  EXPECT_EQ(r.unwrap_err(), "logic: range");
+  EXPECT_EQ(calls, 1);
+  auto any = cpp_result::catch_as_result<std::string>(
+      []() -> int { throw 7; }, [] { return std::string("other"); });
+  EXPECT_EQ(any.unwrap_err(), "other");
+}
+
+TEST(ExceptionTest, ResultOrThrow) {
+  EXPECT_EQ(cpp_result::result_or_throw(Result<int, ParseError>::Ok(3)), 3);
+  try {
+    (void)cpp_result::result_or_throw(
+        Result<int, ParseError>::Err(ParseError::Overflow));
+    FAIL();
+  } catch (const BadResultAccess<ParseError> &e) {
+    EXPECT_EQ(e.error(), ParseError::Overflow);
+  }
+  EXPECT_THROW(cpp_result::result_or_throw(
+                   Result<void, std::invalid_argument>::Err(
+                       std::invalid_argument("bad"))),
+               std::invalid_argument);
+  EXPECT_THROW((void)cpp_result::result_or_throw(
+                   Result<int, ParseError>::Err(ParseError::NotANumber),
+                   [](ParseError) { return std::domain_error("parse"); }),
+               std::domain_error);
+}
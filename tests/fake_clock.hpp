@@ -0,0 +1,20 @@
+// fake_clock.hpp - Manually advanced clock shared by the tests
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+// A steady clock that moves only when a test calls advance(). It starts
+// well after the epoch, so a zero time point never looks recent.
+struct FakeClock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<FakeClock>;
+  static constexpr bool is_steady = true;
+  static inline std::atomic<rep> ticks{1000000000};
+  static time_point now() { return time_point(duration(ticks.load())); }
+  static void advance(duration d) { ticks += d.count(); }
+};
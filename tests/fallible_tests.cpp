@@ -0,0 +1,211 @@
+#include <cpp_result/fallible.hpp>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <string>
+
+using cpp_result::AllocError;
+using cpp_result::TryHashMap;
+using cpp_result::TryString;
+using cpp_result::TryVector;
+
+// The containers allocate only through the nothrow operator new; replacing
+// it here lets the tests make the next allocations fail. The other forms
+// are replaced too, so every new and delete pair uses malloc and free.
+static int g_fail_after = -1;
+
+static void *checked_alloc(std::size_t n, std::size_t align) noexcept {
+  if (g_fail_after == 0)
+    return nullptr;
+  if (g_fail_after > 0)
+    --g_fail_after;
+  return std::aligned_alloc(align, (n + align - 1) / align * align);
+}
+
+void *operator new(std::size_t n, const std::nothrow_t &) noexcept {
+  return checked_alloc(n ? n : 1, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new(std::size_t n, std::align_val_t a,
+                   const std::nothrow_t &) noexcept {
+  return checked_alloc(n ? n : 1, static_cast<std::size_t>(a));
+}
+void *operator new(std::size_t n) {
+  if (void *p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void *operator new(std::size_t n, std::align_val_t a) {
+  const auto align = static_cast<std::size_t>(a);
+  n = n ? n : 1;
+  if (void *p = std::aligned_alloc(align, (n + align - 1) / align * align))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+struct FailNext {
+  explicit FailNext(int after = 0) { g_fail_after = after; }
+  ~FailNext() { g_fail_after = -1; }
+};
+
+TEST(FallibleTest, VectorGrowsAndFailsWithoutChange) {
+  TryVector<std::string> v;
+  for (int i = 0; i < 100; ++i)
+    ASSERT_TRUE(v.try_push_back(std::to_string(i)).is_ok());
+  EXPECT_EQ(v.size(), 100u);
+  EXPECT_EQ(v[42], "42");
+
+  const std::size_t cap = v.capacity();
+  while (v.size() < cap)
+    ASSERT_TRUE(v.try_push_back("x").is_ok());
+  {
+    FailNext fail;
+    auto r = v.try_push_back("overflow");
+    ASSERT_TRUE(r.is_err());
+    EXPECT_EQ(r.unwrap_err().kind, AllocError::Kind::OutOfMemory);
+  }
+  EXPECT_EQ(v.size(), cap);
+  EXPECT_EQ(v[99], "99");
+  EXPECT_EQ(*v.try_emplace_back(3, 'z').unwrap(), "zzz");
+}
+
+TEST(FallibleTest, ReserveReportsOverflowAndOutOfMemory) {
+  TryVector<std::uint64_t> v;
+  auto overflow = v.try_reserve(~std::size_t{0} / 4);
+  ASSERT_TRUE(overflow.is_err());
+  EXPECT_EQ(overflow.unwrap_err().kind, AllocError::Kind::CapacityOverflow);
+
+  FailNext fail;
+  auto oom = v.try_reserve(1000);
+  ASSERT_TRUE(oom.is_err());
+  EXPECT_EQ(oom.unwrap_err(),
+            (AllocError{AllocError::Kind::OutOfMemory, 8000}));
+  EXPECT_EQ(v.capacity(), 0u);
+}
+
+TEST(FallibleTest, CloneAndResize) {
+  TryVector<int> v;
+  ASSERT_TRUE(v.try_resize(5).is_ok());
+  v[4] = 7;
+  auto copy = v.try_clone();
+  ASSERT_TRUE(copy.is_ok());
+  EXPECT_EQ(copy.unwrap().size(), 5u);
+  EXPECT_EQ(copy.unwrap()[4], 7);
+  ASSERT_TRUE(v.try_resize(2).is_ok());
+  EXPECT_EQ(v.size(), 2u);
+}
+
+TEST(FallibleTest, StringAppends) {
+  TryString s;
+  EXPECT_STREQ(s.c_str(), "");
+  ASSERT_TRUE(s.try_append("hello").is_ok());
+  ASSERT_TRUE(s.try_push_back(' ').is_ok());
+  ASSERT_TRUE(s.try_append("world").is_ok());
+  EXPECT_EQ(s.view(), "hello world");
+  EXPECT_STREQ(s.c_str(), "hello world");
+
+  const std::string big(s.capacity(), 'x');
+  FailNext fail;
+  EXPECT_TRUE(s.try_append(big).is_err());
+  EXPECT_EQ(s.view(), "hello world");
+}
+
+TEST(FallibleTest, VectorPushBackOfOwnElementWhileGrowing) {
+  TryVector<std::string> v;
+  ASSERT_TRUE(v.try_push_back(std::string(32, 'a')).is_ok());
+  while (v.size() < v.capacity())
+    ASSERT_TRUE(v.try_push_back(std::string(32, 'b')).is_ok());
+  ASSERT_TRUE(v.try_push_back(v[0]).is_ok());
+  EXPECT_EQ(v.back(), std::string(32, 'a'));
+  EXPECT_EQ(v[0], std::string(32, 'a'));
+}
+
+TEST(FallibleTest, HashMapEmplaceOfOwnValueWhileGrowing) {
+  TryHashMap<int, std::string> m;
+  const std::string big(40, 'v');
+  for (int k = 0; k < 7; ++k) // the next insert rehashes the 8-slot table
+    ASSERT_TRUE(m.try_emplace(k, big).is_ok());
+  auto placed = m.try_emplace(100, *m.find(0));
+  ASSERT_TRUE(placed.is_ok());
+  EXPECT_EQ(*placed.unwrap().first, big);
+  EXPECT_EQ(*m.find(100), big);
+  EXPECT_EQ(*m.find(0), big);
+}
+
+TEST(FallibleTest, StringAppendOfOwnViewWhileGrowing) {
+  TryString s;
+  ASSERT_TRUE(s.try_append("abc").is_ok());
+  while (s.size() * 2 <= s.capacity())
+    ASSERT_TRUE(s.try_append(s.view()).is_ok());
+  const std::string expected = std::string(s.view()) + std::string(s.view());
+  ASSERT_TRUE(s.try_append(s.view()).is_ok());
+  EXPECT_EQ(s.view(), expected);
+  EXPECT_STREQ(s.c_str(), expected.c_str());
+}
+
+TEST(FallibleTest, HashMapInsertFindErase) {
+  TryHashMap<int, std::string> m;
+  for (int i = 0; i < 1000; ++i) {
+    auto r = m.try_emplace(i, std::to_string(i));
+    ASSERT_TRUE(r.is_ok());
+    EXPECT_TRUE(r.unwrap().second);
+  }
+  EXPECT_EQ(m.size(), 1000u);
+  EXPECT_FALSE(m.try_emplace(5, "dup").unwrap().second);
+  EXPECT_EQ(*m.find(5), "5");
+  EXPECT_EQ(m.find(1000), nullptr);
+
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_TRUE(m.erase(i));
+  EXPECT_FALSE(m.erase(0));
+  EXPECT_EQ(m.size(), 500u);
+  std::size_t seen = 0;
+  m.for_each([&](int k, const std::string &v) {
+    EXPECT_EQ(k % 2, 1);
+    EXPECT_EQ(v, std::to_string(k));
+    ++seen;
+  });
+  EXPECT_EQ(seen, 500u);
+
+  // Erase and reinsert churn must not grow the table without bound.
+  for (int round = 0; round < 50; ++round)
+    for (int i = 2000; i < 2100; ++i) {
+      ASSERT_TRUE(m.try_emplace(i, "t").is_ok());
+      ASSERT_TRUE(m.erase(i));
+    }
+  EXPECT_EQ(m.size(), 500u);
+}
+
+TEST(FallibleTest, HashMapGrowthFailureKeepsEntries) {
+  TryHashMap<int, int> m;
+  ASSERT_TRUE(m.try_reserve(7).is_ok());
+  for (int i = 0; i < 7; ++i)
+    ASSERT_TRUE(m.try_emplace(i, i).is_ok());
+  FailNext fail;
+  EXPECT_TRUE(m.try_emplace(100, 100).is_err());
+  EXPECT_EQ(m.size(), 7u);
+  EXPECT_EQ(*m.find(6), 6);
+}
+
+TEST(FallibleTest, MakeUniqueAndShared) {
+  auto u = cpp_result::try_make_unique<std::string>(4, 'a');
+  ASSERT_TRUE(u.is_ok());
+  EXPECT_EQ(*u.unwrap(), "aaaa");
+
+  auto s = cpp_result::try_make_shared<std::string>("shared");
+  ASSERT_TRUE(s.is_ok());
+  std::shared_ptr<std::string> copy = s.unwrap();
+  EXPECT_EQ(copy.use_count(), 2);
+  EXPECT_EQ(*copy, "shared");
+
+  FailNext fail;
+  EXPECT_TRUE(cpp_result::try_make_unique<int>(1).is_err());
+  EXPECT_EQ(cpp_result::try_make_shared<int>(1).unwrap_err().kind,
+            AllocError::Kind::OutOfMemory);
+}
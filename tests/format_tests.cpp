@@ -0,0 +1,64 @@
+#if defined(CPP_RESULT_TEST_FMT)
+#include <fmt/format.h>
+#endif
+#include <cpp_result/format.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+using cpp_result::Result;
+
+struct Point {
+  int x, y;
+};
+
+template <> struct cpp_result::value_formatter<Point> {
+  static std::to_chars_result format(char *first, char *last, const Point &p) {
+    auto r = std::to_chars(first, last, p.x);
+    if (r.ec != std::errc{} || r.ptr == last)
+      return {last, std::errc::value_too_large};
+    *r.ptr++ = ',';
+    return std::to_chars(r.ptr, last, p.y);
+  }
+};
+
+enum class Code : short { Timeout = 7 };
+
+template <typename R> static std::string fmt_str(const R &r) {
+  char buf[64];
+  auto res = cpp_result::format_to(buf, buf + sizeof buf, r);
+  EXPECT_EQ(res.ec, std::errc{});
+  return std::string(buf, res.ptr);
+}
+
+TEST(FormatTest, FormatsBuiltinPayloads) {
+  EXPECT_EQ(fmt_str(Result<int, Code>::Ok(-42)), "Ok(-42)");
+  EXPECT_EQ(fmt_str(Result<int, Code>::Err(Code::Timeout)), "Err(7)");
+  EXPECT_EQ(fmt_str(Result<double, int>::Ok(0.5)), "Ok(0.5)");
+  EXPECT_EQ(fmt_str(Result<bool, int>::Ok(true)), "Ok(true)");
+  EXPECT_EQ(fmt_str(Result<int, std::string>::Err("no route")), "Err(no route)");
+  EXPECT_EQ(fmt_str(Result<int, const char *>::Err("eof")), "Err(eof)");
+  EXPECT_EQ(fmt_str(Result<void, int>::Ok()), "Ok(())");
+  EXPECT_EQ(fmt_str(Result<Result<int, int>, int>::Ok(Result<int, int>::Err(3))),
+            "Ok(Err(3))");
+  EXPECT_EQ(fmt_str(Result<int, cpp_result::Never>::Ok(1)), "Ok(1)");
+}
+
+TEST(FormatTest, CustomFormatterAndOverflow) {
+  EXPECT_EQ(fmt_str(Result<Point, int>::Ok({3, -4})), "Ok(3,-4)");
+  auto r = Result<int, int>::Ok(123456);
+  char buf[9]; // "Ok(123456)" needs 10
+  auto res = cpp_result::format_to(buf, buf + sizeof buf, r);
+  EXPECT_EQ(res.ec, std::errc::value_too_large);
+  EXPECT_EQ(res.ptr, buf + sizeof buf);
+  EXPECT_EQ(cpp_result::format_to(buf, buf + 3, r).ec,
+            std::errc::value_too_large);
+}
+
+#if defined(CPP_RESULT_TEST_FMT)
+TEST(FormatTest, FmtFormatter) {
+  EXPECT_EQ(fmt::format("{}", Result<int, Code>::Ok(5)), "Ok(5)");
+  std::string long_err(300, 'x');
+  EXPECT_EQ(fmt::format("[{}]", Result<int, std::string>::Err(long_err)),
+            "[Err(" + long_err + ")]");
+}
+#endif
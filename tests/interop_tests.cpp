@@ -0,0 +1,82 @@
+#include <cpp_result/interop.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using cpp_result::Result;
+
+// Counts copies, to check that the rvalue conversions only move.
+struct Tracked {
+  static inline int copies = 0;
+  std::vector<int> data;
+  explicit Tracked(std::vector<int> d) : data(std::move(d)) {}
+  Tracked(const Tracked &o) : data(o.data) { ++copies; }
+  Tracked(Tracked &&) noexcept = default;
+  Tracked &operator=(const Tracked &o) {
+    data = o.data;
+    ++copies;
+    return *this;
+  }
+  Tracked &operator=(Tracked &&) noexcept = default;
+};
+
+TEST(InteropTest, VariantRoundTripMoves) {
+  Tracked::copies = 0;
+  auto r = Result<Tracked, std::string>::Ok(Tracked({1, 2, 3}));
+  const int *buffer = r.unwrap().data.data();
+  auto v = cpp_result::to_variant(std::move(r));
+  ASSERT_EQ(v.index(), 0u);
+  auto back = cpp_result::from_variant(std::move(v));
+  EXPECT_EQ(back.unwrap().data.data(), buffer); // same heap buffer
+  EXPECT_EQ(Tracked::copies, 0);
+
+  std::variant<int, int> err(std::in_place_index<1>, 7);
+  auto e = cpp_result::from_variant(err);
+  EXPECT_EQ(e.unwrap_err(), 7); // by index, even with T == E
+  EXPECT_EQ(cpp_result::to_variant(e).index(), 1u);
+}
+
+TEST(InteropTest, OptionalConversions) {
+  auto some = cpp_result::ok_or(std::optional<std::string>("x"), 404);
+  EXPECT_EQ(some.unwrap(), "x");
+  auto none = cpp_result::ok_or(std::optional<std::string>(), 404);
+  EXPECT_EQ(none.unwrap_err(), 404);
+
+  int built = 0;
+  auto lazy = cpp_result::ok_or_else(std::optional<int>(5), [&] {
+    ++built;
+    return std::string("missing");
+  });
+  EXPECT_EQ(lazy.unwrap(), 5);
+  EXPECT_EQ(built, 0);
+
+  auto owned = Result<std::unique_ptr<int>, int>::Ok(std::make_unique<int>(9));
+  auto opt = cpp_result::to_optional(std::move(owned));
+  ASSERT_TRUE(opt.has_value());
+  EXPECT_EQ(**opt, 9);
+  EXPECT_FALSE(cpp_result::to_optional(Result<int, int>::Err(1)).has_value());
+}
+
+#if defined(__cpp_lib_expected)
+TEST(InteropTest, ExpectedRoundTripMoves) {
+  Tracked::copies = 0;
+  auto r = Result<Tracked, std::string>::Ok(Tracked({4, 5}));
+  const int *buffer = r.unwrap().data.data();
+  std::expected<Tracked, std::string> x = cpp_result::to_expected(std::move(r));
+  ASSERT_TRUE(x.has_value());
+  auto back = cpp_result::from_expected(std::move(x));
+  EXPECT_EQ(back.unwrap().data.data(), buffer);
+  EXPECT_EQ(Tracked::copies, 0);
+
+  auto err = cpp_result::to_expected(Result<int, std::string>::Err("bad"));
+  EXPECT_EQ(err.error(), "bad");
+  EXPECT_EQ(cpp_result::from_expected(err).unwrap_err(), "bad");
+
+  auto unit = cpp_result::to_expected(Result<void, int>::Ok());
+  EXPECT_TRUE(unit.has_value());
+  EXPECT_TRUE(cpp_result::from_expected(std::move(unit)).is_ok());
+}
+#endif
@@ -0,0 +1,108 @@
+#include <cpp_result/mapped_file.hpp>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using cpp_result::Advice;
+using cpp_result::IoError;
+using cpp_result::MappedFile;
+
+class MappedFileTest : public ::testing::Test {
+protected:
+  void TearDown() override {
+    if (!path_.empty())
+      ::unlink(path_.c_str());
+  }
+
+  const char *write_file(const std::string &contents) {
+    char tmpl[] = "/tmp/cpp_result_mapped_XXXXXX";
+    int fd = ::mkstemp(tmpl);
+    EXPECT_NE(fd, -1);
+    EXPECT_TRUE(cpp_result::posix::write_full(fd, contents.data(),
+                                              contents.size())
+                    .is_ok());
+    ::close(fd);
+    path_ = tmpl;
+    return path_.c_str();
+  }
+
+  static std::vector<std::string>
+  collect(const cpp_result::RecordRange &range) {
+    std::vector<std::string> out;
+    for (auto rec : range)
+      out.push_back(rec.is_ok() ? std::string(rec.unwrap()) : "<err>");
+    return out;
+  }
+
+  std::string path_;
+};
+
+TEST_F(MappedFileTest, ViewsMapTheWholeFile) {
+  auto file = MappedFile::open(write_file("hello\nworld"));
+  ASSERT_TRUE(file.is_ok());
+  auto &f = file.unwrap();
+  EXPECT_EQ(f.size(), 11u);
+  EXPECT_EQ(f.view(), "hello\nworld");
+  EXPECT_EQ(f.bytes().data(), f.data());
+  cpp_result::ByteReader reader(f.bytes());
+  EXPECT_EQ(reader.read<char>().unwrap(), 'h');
+}
+
+TEST_F(MappedFileTest, LinesPointIntoTheMapping) {
+  auto file = MappedFile::open(write_file("a\n\nbcd\nlast"));
+  ASSERT_TRUE(file.is_ok());
+  auto &f = file.unwrap();
+  EXPECT_EQ(collect(f.lines()),
+            (std::vector<std::string>{"a", "", "bcd", "last"}));
+  auto first = *f.lines().begin();
+  EXPECT_EQ(first.unwrap().data(), f.view().data());
+}
+
+TEST_F(MappedFileTest, TrailingDelimiterHasNoEmptyRecord) {
+  auto file = MappedFile::open(write_file("x;y;"));
+  EXPECT_EQ(collect(file.unwrap().records(';')),
+            (std::vector<std::string>{"x", "y"}));
+}
+
+TEST_F(MappedFileTest, OversizedRecordIsErrAndIterationContinues) {
+  auto file = MappedFile::open(write_file("ok\ntoo long\nok2\n"));
+  auto &f = file.unwrap();
+  EXPECT_EQ(collect(f.lines(3)),
+            (std::vector<std::string>{"ok", "<err>", "ok2"}));
+  auto it = f.lines(3).begin();
+  ++it;
+  EXPECT_EQ((*it).unwrap_err(),
+            (IoError{IoError::Op::Record, cpp_result::Errno{EMSGSIZE}}));
+}
+
+TEST_F(MappedFileTest, EmptyFile) {
+  auto file = MappedFile::open(write_file(""));
+  ASSERT_TRUE(file.is_ok());
+  EXPECT_TRUE(file.unwrap().empty());
+  EXPECT_TRUE(collect(file.unwrap().lines()).empty());
+  EXPECT_TRUE(file.unwrap().advise(Advice::WillNeed).is_ok());
+}
+
+TEST_F(MappedFileTest, AdviseAndMove) {
+  auto file = MappedFile::open(write_file("data"),
+                               Advice::Sequential | Advice::WillNeed);
+  ASSERT_TRUE(file.is_ok());
+  EXPECT_TRUE(file.unwrap().advise(Advice::Random).is_ok());
+  MappedFile moved = std::move(file.unwrap());
+  EXPECT_TRUE(file.unwrap().empty());
+  EXPECT_EQ(moved.view(), "data");
+}
+
+TEST(MappedFileErrorTest, MissingFile) {
+  auto file = MappedFile::open("/nonexistent/cpp_result");
+  ASSERT_TRUE(file.is_err());
+  EXPECT_EQ(file.unwrap_err().op, IoError::Op::Open);
+  EXPECT_EQ(file.unwrap_err().error, ENOENT);
+}
+
+TEST(MappedFileErrorTest, DirectoryCannotBeMapped) {
+  auto file = MappedFile::open("/");
+  ASSERT_TRUE(file.is_err());
+  EXPECT_EQ(file.unwrap_err().op, IoError::Op::Map);
+}
@@ -0,0 +1,136 @@
+#include <atomic>
+#include <chrono>
+#include <cpp_result/memoize.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fake_clock.hpp"
+
+using cpp_result::MemoizePolicy;
+using cpp_result::Result;
+using namespace std::chrono_literals;
+
+static Result<int, std::string> lookup(int key) {
+  if (key < 0)
+    return Result<int, std::string>::Err("negative");
+  return Result<int, std::string>::Ok(key * 10);
+}
+
+TEST(MemoizeTest, CachesOkAndErrSeparately) {
+  int calls = 0;
+  auto memo = cpp_result::memoize([&](int key) {
+    ++calls;
+    return lookup(key);
+  });
+  EXPECT_EQ(memo(4).unwrap(), 40);
+  EXPECT_EQ(memo(4).unwrap(), 40);
+  EXPECT_EQ(memo(-1).unwrap_err(), "negative");
+  EXPECT_EQ(memo(-1).unwrap_err(), "negative");
+  EXPECT_EQ(calls, 2);
+  auto stats = memo.stats();
+  EXPECT_EQ(stats.ok_hits, 1u);
+  EXPECT_EQ(stats.err_hits, 1u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.5);
+
+  memo.invalidate(4);
+  EXPECT_EQ(memo(4).unwrap(), 40);
+  EXPECT_EQ(calls, 3);
+}
+
+TEST(MemoizeTest, ErrorsExpireIndependently) {
+  MemoizePolicy policy;
+  policy.err_ttl = 100ms;
+  policy.ok_ttl = 10s;
+  int calls = 0;
+  auto f = [&](const int &key) {
+    ++calls;
+    return lookup(key);
+  };
+  cpp_result::Memoized<int, decltype(f), FakeClock> memo(f, policy);
+  (void)memo(1);
+  (void)memo(-1);
+  FakeClock::advance(200ms);
+  (void)memo(1);
+  (void)memo(-1);
+  EXPECT_EQ(calls, 3); // only the error was recomputed
+  FakeClock::advance(20s);
+  (void)memo(1);
+  EXPECT_EQ(calls, 4);
+  EXPECT_EQ(memo.stats().evictions, 2u);
+}
+
+TEST(MemoizeTest, EvictsLeastRecentlyUsed) {
+  MemoizePolicy policy;
+  policy.shards = 1;
+  policy.ok_capacity = 2;
+  std::vector<int> calls;
+  auto memo = cpp_result::memoize(
+      [&](int key) {
+        calls.push_back(key);
+        return lookup(key);
+      },
+      policy);
+  (void)memo(1);
+  (void)memo(2);
+  (void)memo(1); // 2 is now least recently used
+  (void)memo(3); // evicts 2
+  (void)memo(1);
+  (void)memo(2);
+  EXPECT_EQ(calls, (std::vector<int>{1, 2, 3, 2}));
+}
+
+TEST(MemoizeTest, NegativeCachingCanBeDisabled) {
+  MemoizePolicy policy;
+  policy.err_capacity = 0;
+  int calls = 0;
+  auto memo = cpp_result::memoize<int>(
+      [&](auto key) {
+        ++calls;
+        return lookup(key);
+      },
+      policy);
+  (void)memo(-1);
+  (void)memo(-1);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(MemoizeTest, ConcurrentMissesAreCoalesced) {
+  std::atomic<int> calls{0};
+  std::atomic<bool> release{false};
+  auto memo = cpp_result::memoize([&](const std::string &key) {
+    ++calls;
+    while (!release)
+      std::this_thread::yield();
+    return Result<std::size_t, int>::Ok(key.size());
+  });
+  std::vector<std::thread> threads;
+  std::atomic<int> done{0};
+  for (int i = 0; i < 8; ++i)
+    threads.emplace_back([&] {
+      EXPECT_EQ(memo(std::string("hello")).unwrap(), 5u);
+      ++done;
+    });
+  while (memo.stats().misses + memo.stats().coalesced < 8)
+    std::this_thread::yield();
+  release = true;
+  for (auto &t : threads)
+    t.join();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(memo.stats().coalesced, 7u);
+}
+
+#if defined(__cpp_exceptions)
+TEST(MemoizeTest, ThrowingLeaderLetsWaitersRetry) {
+  int calls = 0;
+  auto memo = cpp_result::memoize([&](int key) {
+    if (++calls == 1)
+      throw std::runtime_error("boom");
+    return lookup(key);
+  });
+  EXPECT_THROW((void)memo(3), std::runtime_error);
+  EXPECT_EQ(memo(3).unwrap(), 30);
+}
+#endif
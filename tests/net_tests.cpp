@@ -0,0 +1,161 @@
+#include <cpp_result/net.hpp>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using cpp_result::Errno;
+using cpp_result::Poll;
+using cpp_result::Result;
+namespace net = cpp_result::net;
+
+// Blocking client connected to 127.0.0.1:port.
+static int connect_loopback(std::uint16_t port) {
+  int fd = net::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC).unwrap();
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  EXPECT_TRUE(
+      net::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))
+          .is_ok());
+  return fd;
+}
+
+TEST(NetTest, DataPathReportsPendingInsteadOfEagain) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv), 0);
+  char buf[8];
+  EXPECT_TRUE(net::recv(sv[0], buf, sizeof(buf)).is_pending());
+  EXPECT_EQ(net::send(sv[1], "ping", 4).unwrap(), 4u);
+  EXPECT_EQ(net::recv(sv[0], buf, sizeof(buf)).unwrap(), 4u);
+  ::close(sv[1]);
+  EXPECT_EQ(net::recv(sv[0], buf, sizeof(buf)).unwrap(), 0u); // peer closed
+  EXPECT_EQ(net::send(sv[0], "x", 1).unwrap_err(), EPIPE);
+  ::close(sv[0]);
+
+  EXPECT_TRUE(net::would_block(Result<int, Errno>::Err(Errno{EAGAIN}))
+                  .is_pending());
+  EXPECT_EQ(net::would_block(Result<int, Errno>::Err(Errno{EBADF}))
+                .unwrap_err(),
+            EBADF);
+  EXPECT_EQ(net::recv(-1, buf, 1).unwrap_err(), EBADF);
+}
+
+TEST(NetTest, BatchedDatagrams) {
+  int sv[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, sv), 0);
+  char out[3][4] = {{'a'}, {'b', 'b'}, {'c', 'c', 'c'}};
+  char in[3][4];
+  iovec oiov[3], iiov[3];
+  mmsghdr omsg[3] = {}, imsg[3] = {};
+  for (int i = 0; i < 3; ++i) {
+    oiov[i] = {out[i], static_cast<std::size_t>(i + 1)};
+    iiov[i] = {in[i], sizeof(in[i])};
+    omsg[i].msg_hdr.msg_iov = &oiov[i];
+    omsg[i].msg_hdr.msg_iovlen = 1;
+    imsg[i].msg_hdr.msg_iov = &iiov[i];
+    imsg[i].msg_hdr.msg_iovlen = 1;
+  }
+  EXPECT_TRUE(net::recvmmsg(sv[0], imsg, 3).is_pending());
+  EXPECT_EQ(net::sendmmsg(sv[1], omsg, 3).unwrap(), 3u);
+  ASSERT_EQ(net::recvmmsg(sv[0], imsg, 3).unwrap(), 3u);
+  EXPECT_EQ(imsg[2].msg_len, 3u);
+  EXPECT_EQ(std::string(in[1], imsg[1].msg_len), "bb");
+  ::close(sv[0]);
+  ::close(sv[1]);
+}
+
+TEST(NetTest, NonBlockingConnectCompletesThroughSoError) {
+  int lfd = net::listen_tcp("127.0.0.1", 0).unwrap();
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(net::local_port(lfd).unwrap());
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int fd =
+      net::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC).unwrap();
+  auto started =
+      net::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+  if (started.is_err()) {
+    ASSERT_EQ(started.unwrap_err(), EINPROGRESS);
+  }
+  pollfd p{fd, POLLOUT, 0};
+  ASSERT_EQ(::poll(&p, 1, 5000), 1);
+  EXPECT_TRUE(net::connect_result(fd).is_ok());
+  ::close(fd);
+  ::close(lfd);
+
+  // A refused connection is reported by connect or by connect_result.
+  fd = net::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC)
+           .unwrap();
+  started =
+      net::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+  if (started.is_err() && started.unwrap_err() == EINPROGRESS) {
+    p = {fd, POLLOUT, 0};
+    ASSERT_EQ(::poll(&p, 1, 5000), 1);
+    started = net::connect_result(fd);
+  }
+  EXPECT_EQ(started.unwrap_err(), ECONNREFUSED);
+  ::close(fd);
+}
+
+// An echo server whose connection handlers close on EOF or error.
+TEST(NetTest, ReactorEchoesAndClosesOnErr) {
+  auto created = net::Reactor<Errno>::create();
+  ASSERT_TRUE(created.is_ok());
+  auto &reactor = created.unwrap();
+  int lfd = net::listen_tcp("127.0.0.1", 0).unwrap();
+  const std::uint16_t port = net::local_port(lfd).unwrap();
+  EXPECT_TRUE(net::listen_tcp("not an address", 0).is_err());
+
+  int closed = 0;
+  reactor.on_close([&](int, const Errno &e) {
+    EXPECT_EQ(e.code, 0);
+    ++closed;
+  });
+  auto echo = [](int fd, std::uint32_t) -> Result<void, Errno> {
+    char buf[256];
+    for (;;) {
+      auto n = net::recv(fd, buf, sizeof(buf));
+      if (n.is_pending())
+        return Result<void, Errno>::Ok();
+      std::size_t got = TRY_INTO(std::move(n).into_result());
+      if (got == 0)
+        return Result<void, Errno>::Err(Errno{0}); // peer closed
+      auto sent = net::send(fd, buf, got);
+      if (!sent.is_ok()) // a full send buffer counts as a failure here
+        return Result<void, Errno>::Err(sent.is_err() ? sent.unwrap_err()
+                                                      : Errno{EAGAIN});
+    }
+  };
+  ASSERT_TRUE(reactor
+                  .add(lfd, EPOLLIN,
+                       [&](int fd, std::uint32_t) -> Result<void, Errno> {
+                         for (;;) {
+                           auto conn = net::accept4(fd);
+                           if (conn.is_pending())
+                             return Result<void, Errno>::Ok();
+                           int c = TRY_INTO(std::move(conn).into_result());
+                           auto added = reactor.add(c, EPOLLIN, echo);
+                           if (added.is_err())
+                             ::close(c);
+                         }
+                       })
+                  .is_ok());
+
+  int client = connect_loopback(port);
+  while (reactor.size() < 2)
+    ASSERT_TRUE(reactor.run_once(1000).is_ok());
+  ASSERT_EQ(::write(client, "hello", 5), 5);
+  ASSERT_TRUE(reactor.run_once(1000).is_ok());
+  char buf[8];
+  ASSERT_EQ(::read(client, buf, sizeof(buf)), 5);
+  EXPECT_EQ(std::string(buf, 5), "hello");
+
+  ::close(client);
+  while (reactor.size() > 1)
+    ASSERT_TRUE(reactor.run_once(1000).is_ok());
+  EXPECT_EQ(closed, 1);
+  EXPECT_TRUE(reactor.add(-1, EPOLLIN, echo).is_err());
+}
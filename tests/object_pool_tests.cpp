@@ -0,0 +1,99 @@
+#include <atomic>
+#include <chrono>
+#include <cpp_result/object_pool.hpp>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using cpp_result::ObjectPool;
+using cpp_result::PoolError;
+using namespace std::chrono_literals;
+
+TEST(ObjectPoolTest, LendsEveryObjectThenFailsFast) {
+  ObjectPool<std::string> pool(3, "init");
+  std::vector<ObjectPool<std::string>::Handle> held;
+  std::set<std::string *> seen;
+  for (int i = 0; i < 3; ++i) {
+    auto h = pool.try_acquire();
+    ASSERT_TRUE(h.is_ok());
+    EXPECT_EQ(*h.unwrap(), "init");
+    seen.insert(h.unwrap().get());
+    held.push_back(std::move(h.unwrap()));
+  }
+  EXPECT_EQ(seen.size(), 3u);
+  auto none = pool.try_acquire();
+  ASSERT_TRUE(none.is_err());
+  EXPECT_EQ(none.unwrap_err(), PoolError{PoolError::Kind::Exhausted});
+
+  held.pop_back();
+  EXPECT_TRUE(pool.try_acquire().is_ok());
+}
+
+TEST(ObjectPoolTest, HandleReturnsObjectOnDestructionAndMove) {
+  ObjectPool<int> pool(1);
+  {
+    auto h = std::move(pool.try_acquire().unwrap());
+    *h = 42;
+    ObjectPool<int>::Handle moved = std::move(h);
+    EXPECT_FALSE(h);
+    EXPECT_TRUE(moved);
+    EXPECT_TRUE(pool.try_acquire().is_err());
+  }
+  auto again = std::move(pool.try_acquire().unwrap());
+  EXPECT_EQ(*again, 42); // objects are reused as returned
+  again.reset();
+  EXPECT_FALSE(again);
+  EXPECT_TRUE(pool.try_acquire().is_ok());
+}
+
+TEST(ObjectPoolTest, AcquireForTimesOutOrWakesOnRelease) {
+  ObjectPool<int> pool(1);
+  auto h = std::move(pool.try_acquire().unwrap());
+
+  const auto start = std::chrono::steady_clock::now();
+  auto late = pool.acquire_for(20ms);
+  ASSERT_TRUE(late.is_err());
+  EXPECT_EQ(late.unwrap_err().kind, PoolError::Kind::Timeout);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(10ms);
+    h.reset();
+  });
+  auto woke = pool.acquire_for(std::chrono::nanoseconds::max());
+  releaser.join();
+  EXPECT_TRUE(woke.is_ok());
+}
+
+TEST(ObjectPoolTest, ConcurrentAcquireNeverSharesAnObject) {
+  struct Slot {
+    std::atomic<int> owners{0};
+  };
+  ObjectPool<Slot> pool(8);
+  std::atomic<int> violations{0}, acquired{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t)
+    threads.emplace_back([&] {
+      for (int i = 0; i < 20000; ++i) {
+        auto h = pool.try_acquire();
+        if (h.is_err())
+          continue;
+        ++acquired;
+        if (h.unwrap()->owners.fetch_add(1) != 0)
+          ++violations;
+        h.unwrap()->owners.fetch_sub(1);
+      }
+    });
+  for (auto &t : threads)
+    t.join();
+  EXPECT_EQ(violations.load(), 0);
+  EXPECT_GT(acquired.load(), 0);
+
+  std::vector<ObjectPool<Slot>::Handle> all;
+  for (auto h = pool.try_acquire(); h.is_ok(); h = pool.try_acquire())
+    all.push_back(std::move(h.unwrap()));
+  EXPECT_EQ(all.size(), 8u); // nothing lost
+}
@@ -0,0 +1,157 @@
+#include <charconv>
+#include <cpp_result/pipeline.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using cpp_result::PipelineError;
+using cpp_result::PipelineOptions;
+using cpp_result::run_pipeline;
+using cpp_result::string_reader;
+
+using IntResult = cpp_result::Result<int, std::string>;
+
+static IntResult parse_int(std::string_view s) {
+  int value = 0;
+  auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (ec != std::errc() || end != s.data() + s.size())
+    return IntResult::Err("Invalid integer: " + std::string(s));
+  return IntResult::Ok(value);
+}
+
+struct Collected {
+  std::vector<int> values;
+  std::vector<std::pair<std::size_t, std::string>> errors;
+
+  auto ok_sink() {
+    return [this](int &&v) { values.push_back(v); };
+  }
+  auto err_sink() {
+    return [this](std::string &&e, std::size_t line) {
+      errors.emplace_back(line, std::move(e));
+    };
+  }
+};
+
+static std::string numbers(int n, int bad_every = 0) {
+  std::string out;
+  for (int i = 0; i < n; ++i)
+    out += (bad_every && i % bad_every == 0 ? "x" : std::to_string(i)) + "\n";
+  return out;
+}
+
+TEST(PipelineTest, ParsesRecordsAndReportsErrorsWithLineNumbers) {
+  Collected c;
+  auto stats = run_pipeline(string_reader("1\nabc\n3"), parse_int,
+                            c.ok_sink(), c.err_sink());
+  ASSERT_TRUE(stats.is_ok());
+  EXPECT_EQ(stats.unwrap().records, 3u);
+  EXPECT_EQ(stats.unwrap().ok, 2u);
+  EXPECT_EQ(stats.unwrap().errors, 1u);
+  EXPECT_EQ(stats.unwrap().bytes, 7u);
+  EXPECT_EQ(c.values, (std::vector<int>{1, 3}));
+  ASSERT_EQ(c.errors.size(), 1u);
+  EXPECT_EQ(c.errors[0].first, 2u);
+  EXPECT_EQ(c.errors[0].second, "Invalid integer: abc");
+}
+
+TEST(PipelineTest, SmallChunksCarryPartialRecords) {
+  const std::string input = numbers(1000);
+  Collected c;
+  PipelineOptions opts;
+  opts.chunk_size = 7;
+  auto stats =
+      run_pipeline(string_reader(input), parse_int, c.ok_sink(), c.err_sink(),
+                   opts);
+  ASSERT_TRUE(stats.is_ok());
+  ASSERT_EQ(c.values.size(), 1000u);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(c.values[i], i);
+}
+
+TEST(PipelineTest, ThreadedParsePreservesOrder) {
+  const std::string input = numbers(100000, 97);
+  PipelineOptions opts;
+  opts.threads = 4;
+  opts.chunk_size = 4096;
+  Collected threaded, inline_;
+  auto a = run_pipeline(string_reader(input), parse_int, threaded.ok_sink(),
+                        threaded.err_sink(), opts);
+  auto b = run_pipeline(string_reader(input), parse_int, inline_.ok_sink(),
+                        inline_.err_sink());
+  ASSERT_TRUE(a.is_ok());
+  ASSERT_TRUE(b.is_ok());
+  EXPECT_EQ(threaded.values, inline_.values);
+  EXPECT_EQ(threaded.errors, inline_.errors);
+  EXPECT_EQ(a.unwrap().errors, 1031u);
+}
+
+TEST(PipelineTest, AbortsAfterMaxErrors) {
+  Collected c;
+  PipelineOptions opts;
+  opts.max_errors = 2;
+  auto res = run_pipeline(string_reader(numbers(100, 10)), parse_int,
+                          c.ok_sink(), c.err_sink(), opts);
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err().kind, PipelineError::Kind::ErrorBudget);
+  EXPECT_EQ(res.unwrap_err().stats.errors, 3u);
+  EXPECT_EQ(res.unwrap_err().stats.records, 21u);
+  EXPECT_EQ(c.errors.size(), 3u);
+}
+
+TEST(PipelineTest, AbortsWhenErrorRateExceeded) {
+  Collected c;
+  PipelineOptions opts;
+  opts.max_error_rate = 0.05;
+  opts.min_records_for_rate = 100;
+  auto ok = run_pipeline(string_reader(numbers(1000, 50)), parse_int,
+                         c.ok_sink(), c.err_sink(), opts);
+  EXPECT_TRUE(ok.is_ok());
+  auto res = run_pipeline(string_reader(numbers(1000, 10)), parse_int,
+                          c.ok_sink(), c.err_sink(), opts);
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err().kind, PipelineError::Kind::ErrorBudget);
+  EXPECT_EQ(res.unwrap_err().stats.records, 101u);
+}
+
+TEST(PipelineTest, RecordLongerThanChunk) {
+  Collected c;
+  PipelineOptions opts;
+  opts.chunk_size = 4;
+  auto res = run_pipeline(string_reader("1\n123456\n"), parse_int,
+                          c.ok_sink(), c.err_sink(), opts);
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err().kind, PipelineError::Kind::RecordTooLong);
+  EXPECT_EQ(c.values, (std::vector<int>{1}));
+}
+
+TEST(PipelineTest, ReadErrorStopsTheRun) {
+  Collected c;
+  int calls = 0;
+  auto reader = [&](char *buf, std::size_t) {
+    using R = cpp_result::Result<std::size_t, cpp_result::Errno>;
+    if (calls++ == 0) {
+      std::memcpy(buf, "5\n", 2);
+      return R::Ok(2);
+    }
+    return R::Err(cpp_result::Errno{EIO});
+  };
+  auto res = run_pipeline(reader, parse_int, c.ok_sink(), c.err_sink());
+  ASSERT_TRUE(res.is_err());
+  EXPECT_EQ(res.unwrap_err().kind, PipelineError::Kind::Read);
+  EXPECT_EQ(res.unwrap_err().error, EIO);
+  EXPECT_EQ(c.values, (std::vector<int>{5}));
+}
+
+TEST(PipelineTest, IstreamReaderAndCustomDelimiter) {
+  std::istringstream in("4;5;x;");
+  Collected c;
+  PipelineOptions opts;
+  opts.delimiter = ';';
+  auto res = run_pipeline(cpp_result::istream_reader(in), parse_int,
+                          c.ok_sink(), c.err_sink(), opts);
+  ASSERT_TRUE(res.is_ok());
+  EXPECT_EQ(c.values, (std::vector<int>{4, 5}));
+  EXPECT_EQ(c.errors.size(), 1u);
+}
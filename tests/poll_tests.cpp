@@ -0,0 +1,105 @@
+#include <cpp_result/poll.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using cpp_result::Poll;
+using cpp_result::Result;
+
+enum class IoError { Reset };
+using P = Poll<int, IoError>;
+
+static_assert(sizeof(Poll<int, IoError>) == sizeof(Result<int, IoError>));
+static_assert(std::is_trivially_copyable_v<Poll<int, IoError>>);
+
+// A source that would block `pending` times before yielding `value`.
+struct Source {
+  int pending;
+  int value;
+  Poll<int, IoError> poll() {
+    if (pending > 0) {
+      --pending;
+      return cpp_result::pending;
+    }
+    if (value < 0)
+      return Poll<int, IoError>::Err(IoError::Reset);
+    return Poll<int, IoError>::Ok(value);
+  }
+};
+
+static Poll<std::string, IoError> poll_twice(Source &a, Source &b) {
+  int x = TRY_READY(a.poll());
+  int y = TRY_READY(b.poll());
+  return Poll<std::string, IoError>::Ok(std::to_string(x + y));
+}
+
+// TRY_INTO on a Result also works in a function returning a Poll.
+static P poll_checked(Source &s, Result<int, IoError> limit) {
+  int max = TRY_INTO(limit);
+  int v = TRY_READY(s.poll());
+  return P::Ok(v < max ? v : max);
+}
+
+TEST(PollTest, StatesAndConversions) {
+  auto p = Poll<int, IoError>::Pending();
+  EXPECT_TRUE(p.is_pending());
+  EXPECT_FALSE(p.is_ready() || p.is_ok() || p.is_err());
+
+  Poll<int, IoError> ok = Result<int, IoError>::Ok(4);
+  EXPECT_TRUE(ok.is_ready() && ok.is_ok());
+  EXPECT_EQ(ok.unwrap(), 4);
+  Poll<int, IoError> err = Result<int, IoError>::Err(IoError::Reset);
+  EXPECT_EQ(err.unwrap_err(), IoError::Reset);
+  EXPECT_EQ(std::move(ok).into_result().unwrap(), 4);
+  EXPECT_EQ(err.into_result().unwrap_err(), IoError::Reset);
+
+  Poll<void, IoError> done = Poll<void, IoError>::Ok();
+  EXPECT_TRUE(done.is_ok());
+  Poll<std::unique_ptr<int>, IoError> owned =
+      Poll<std::unique_ptr<int>, IoError>::Ok(std::make_unique<int>(9));
+  auto moved = std::move(owned);
+  EXPECT_EQ(*moved.unwrap(), 9);
+}
+
+TEST(PollTest, CombinatorsPassPendingThrough) {
+  auto twice = [](int v) { return v * 2; };
+  EXPECT_EQ(P::Ok(5).map(twice).unwrap(), 10);
+  EXPECT_TRUE(P::Pending().map(twice).is_pending());
+  EXPECT_TRUE(P::Err(IoError::Reset).map(twice).is_err());
+
+  auto name = P::Err(IoError::Reset).map_err(
+      [](IoError) { return std::string("reset"); });
+  EXPECT_EQ(name.unwrap_err(), "reset");
+  EXPECT_TRUE(P::Pending()
+                  .map_err([](IoError) { return 0; })
+                  .is_pending());
+
+  auto half = [](int v) {
+    return v % 2 ? Result<int, IoError>::Err(IoError::Reset)
+                 : Result<int, IoError>::Ok(v / 2);
+  };
+  EXPECT_EQ(P::Ok(8).and_then(half).unwrap(), 4);
+  EXPECT_TRUE(P::Ok(3).and_then(half).is_err());
+  EXPECT_TRUE(P::Pending().and_then(half).is_pending());
+  auto later = [](int) { return Poll<void, IoError>::Pending(); };
+  EXPECT_TRUE(P::Ok(1).and_then(later).is_pending());
+}
+
+TEST(PollTest, TryReadyPropagatesPendingAndErrors) {
+  Source a{1, 2}, b{2, 3};
+  int polls = 0;
+  Poll<std::string, IoError> p = cpp_result::pending;
+  while ((p = poll_twice(a, b)).is_pending())
+    ++polls;
+  EXPECT_EQ(polls, 3);
+  EXPECT_EQ(p.unwrap(), "5");
+
+  Source bad{0, -1};
+  EXPECT_EQ(poll_twice(bad, b).unwrap_err(), IoError::Reset);
+
+  Source c{1, 9};
+  EXPECT_TRUE(poll_checked(c, Result<int, IoError>::Ok(5)).is_pending());
+  EXPECT_EQ(poll_checked(c, Result<int, IoError>::Ok(5)).unwrap(), 5);
+  EXPECT_TRUE(
+      poll_checked(c, Result<int, IoError>::Err(IoError::Reset)).is_err());
+}
@@ -0,0 +1,176 @@
+#include <cpp_result/posix.hpp>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+
+using cpp_result::Errno;
+using cpp_result::Result;
+namespace posix = cpp_result::posix;
+
+static_assert(std::is_trivially_copyable_v<Result<std::size_t, Errno>>,
+              "Result<size_t, Errno> must be trivially copyable");
+static_assert(sizeof(Result<std::size_t, Errno>) <= 2 * sizeof(void *),
+              "Result<size_t, Errno> must fit in two registers");
+static_assert(std::is_trivially_copyable_v<Result<void, Errno>>,
+              "Result<void, Errno> must be trivially copyable");
+
+class PosixTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    char tmpl[] = "/tmp/cpp_result_posix_XXXXXX";
+    fd_ = ::mkstemp(tmpl);
+    ASSERT_NE(fd_, -1);
+    path_ = tmpl;
+  }
+  void TearDown() override {
+    if (fd_ != -1)
+      ::close(fd_);
+    ::unlink(path_.c_str());
+  }
+
+  int fd_ = -1;
+  std::string path_;
+};
+
+TEST_F(PosixTest, WriteFullThenReadBack) {
+  const std::string data(100000, 'x');
+  auto written = posix::write_full(fd_, data.data(), data.size());
+  ASSERT_TRUE(written.is_ok());
+  EXPECT_EQ(written.unwrap(), data.size());
+  EXPECT_EQ(posix::fstat(fd_).unwrap().st_size,
+            static_cast<off_t>(data.size()));
+
+  EXPECT_EQ(posix::lseek(fd_, 0, SEEK_SET).unwrap(), 0);
+  std::string back(data.size() + 10, '\0');
+  auto n = posix::read_full(fd_, back.data(), back.size());
+  ASSERT_TRUE(n.is_ok());
+  EXPECT_EQ(n.unwrap(), data.size());
+  back.resize(n.unwrap());
+  EXPECT_EQ(back, data);
+}
+
+TEST_F(PosixTest, PositionalAndVectoredIo) {
+  ASSERT_TRUE(posix::pwrite_full(fd_, "hello world", 11, 0).is_ok());
+  char buf[5];
+  EXPECT_EQ(posix::pread_full(fd_, buf, sizeof(buf), 6).unwrap(), 5u);
+  EXPECT_EQ(std::string(buf, 5), "world");
+
+  char a[5], b[6];
+  iovec iov[2] = {{a, sizeof(a)}, {b, sizeof(b)}};
+  EXPECT_EQ(posix::preadv(fd_, iov, 2, 0).unwrap(), 11u);
+  EXPECT_EQ(std::string(a, 5), "hello");
+  EXPECT_EQ(std::string(b, 6), " world");
+
+  const char x[] = "ab", y[] = "cd";
+  iovec out[2] = {{const_cast<char *>(x), 2}, {const_cast<char *>(y), 2}};
+  EXPECT_EQ(posix::pwritev(fd_, out, 2, 11).unwrap(), 4u);
+  EXPECT_TRUE(posix::fsync(fd_).is_ok());
+  EXPECT_TRUE(posix::fdatasync(fd_).is_ok());
+  EXPECT_EQ(posix::fstat(fd_).unwrap().st_size, 15);
+  EXPECT_TRUE(posix::ftruncate(fd_, 5).is_ok());
+  EXPECT_EQ(posix::fstat(fd_).unwrap().st_size, 5);
+}
+
+TEST_F(PosixTest, MmapMunmap) {
+  ASSERT_TRUE(posix::write_full(fd_, "mapped", 6).is_ok());
+  auto addr = posix::mmap(nullptr, 6, PROT_READ, MAP_PRIVATE, fd_, 0);
+  ASSERT_TRUE(addr.is_ok());
+  EXPECT_EQ(std::string(static_cast<const char *>(addr.unwrap()), 6),
+            "mapped");
+  EXPECT_TRUE(posix::madvise(addr.unwrap(), 6, MADV_SEQUENTIAL).is_ok());
+  EXPECT_TRUE(posix::munmap(addr.unwrap(), 6).is_ok());
+  EXPECT_EQ(posix::mmap(nullptr, 0, PROT_READ, MAP_PRIVATE, fd_, 0)
+                .unwrap_err(),
+            EINVAL);
+}
+
+TEST_F(PosixTest, OpenAndClose) {
+  auto fd = posix::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  ASSERT_TRUE(fd.is_ok());
+  EXPECT_TRUE(posix::close(fd.unwrap()).is_ok());
+  EXPECT_EQ(posix::close(fd.unwrap()).unwrap_err(), EBADF);
+}
+
+TEST(PosixErrorTest, OpenMissingFile) {
+  auto fd = posix::open("/nonexistent/cpp_result", O_RDONLY);
+  ASSERT_TRUE(fd.is_err());
+  EXPECT_EQ(fd.unwrap_err(), ENOENT);
+  EXPECT_STRNE(fd.unwrap_err().message(), "");
+}
+
+TEST(PosixErrorTest, ReadBadFd) {
+  char c;
+  EXPECT_EQ(posix::read(-1, &c, 1).unwrap_err(), EBADF);
+  EXPECT_EQ(posix::write(-1, &c, 1).unwrap_err(), EBADF);
+  EXPECT_EQ(posix::fstat(-1).unwrap_err(), EBADF);
+}
+
+TEST(PosixErrorTest, RetryEintr) {
+  int calls = 0;
+  auto res = posix::retry_eintr([&]() -> Result<std::size_t, Errno> {
+    if (++calls < 3)
+      return Result<std::size_t, Errno>::Err(Errno{EINTR});
+    return Result<std::size_t, Errno>::Ok(7);
+  });
+  EXPECT_EQ(res.unwrap(), 7u);
+  EXPECT_EQ(calls, 3);
+
+  calls = 0;
+  auto err = posix::retry_eintr([&]() -> Result<std::size_t, Errno> {
+    ++calls;
+    return Result<std::size_t, Errno>::Err(Errno{EIO});
+  });
+  EXPECT_EQ(err.unwrap_err(), EIO);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(PosixErrorTest, PipeRoundTrip) {
+  auto fds = posix::pipe(O_CLOEXEC).unwrap();
+  EXPECT_EQ(posix::write(fds.write_end, "ping", 4).unwrap(), 4u);
+  char buf[4];
+  EXPECT_EQ(posix::read_full(fds.read_end, buf, 4).unwrap(), 4u);
+  EXPECT_EQ(std::string(buf, 4), "ping");
+  EXPECT_TRUE(posix::close(fds.read_end).is_ok());
+  EXPECT_TRUE(posix::close(fds.write_end).is_ok());
+}
+
+TEST(PosixErrorTest, WriteFullReportsProgressOnError) {
+  auto fds = posix::pipe(O_CLOEXEC | O_NONBLOCK).unwrap();
+  std::string data(1 << 20, 'x'); // larger than the pipe buffer
+  std::size_t written = 0;
+  auto r = posix::write_full(fds.write_end, data.data(), data.size(), &written);
+  EXPECT_EQ(r.unwrap_err(), EAGAIN);
+  EXPECT_GT(written, 0u);
+  EXPECT_LT(written, data.size());
+
+  // Drain what was written, then resume where the write stopped.
+  std::string back(written, '\0');
+  EXPECT_EQ(posix::read_full(fds.read_end, &back[0], written).unwrap(),
+            written);
+  std::size_t more = 0;
+  (void)posix::write_full(fds.write_end, data.data() + written, 1, &more);
+  EXPECT_EQ(more, 1u);
+  EXPECT_TRUE(posix::close(fds.read_end).is_ok());
+  EXPECT_TRUE(posix::close(fds.write_end).is_ok());
+}
+
+TEST(PosixErrorTest, ReadFullReportsProgressOnError) {
+  auto fds = posix::pipe(O_CLOEXEC | O_NONBLOCK).unwrap();
+  ASSERT_EQ(posix::write_full(fds.write_end, "abc", 3).unwrap(), 3u);
+  char buf[8] = {};
+  std::size_t got = 0;
+  auto r = posix::read_full(fds.read_end, buf, sizeof(buf), &got);
+  EXPECT_EQ(r.unwrap_err(), EAGAIN);
+  EXPECT_EQ(got, 3u);
+  EXPECT_EQ(std::string(buf, got), "abc");
+
+  // Resume after more data arrives; end of file ends the read.
+  ASSERT_EQ(posix::write_full(fds.write_end, "de", 2).unwrap(), 2u);
+  EXPECT_TRUE(posix::close(fds.write_end).is_ok());
+  EXPECT_EQ(posix::read_full(fds.read_end, buf + got, sizeof(buf) - got, &got)
+                .unwrap(),
+            2u);
+  EXPECT_EQ(got, 2u);
+  EXPECT_EQ(std::string(buf, 5), "abcde");
+  EXPECT_TRUE(posix::close(fds.read_end).is_ok());
+}
@@ -417,3 +417,233 @@ TEST(ResultTest, VoidContainsErr) {
   EXPECT_FALSE(err.contains_err(Error{"nope"}));
   EXPECT_FALSE(ok.contains_err(Error{"fail"}));
 }
+
+TEST(ResultTest, SameValueAndErrorType) {
+  auto ok = cpp_result::Ok<int, int>(1);
+  auto err = cpp_result::Err<int, int>(2);
+  EXPECT_TRUE(ok.is_ok());
+  EXPECT_EQ(ok.unwrap(), 1);
+  EXPECT_TRUE(err.is_err());
+  EXPECT_EQ(err.unwrap_err(), 2);
+}
+
+TEST(ResultTest, TriviallyCopyableWhenPayloadsAre) {
+  static_assert(std::is_trivially_copyable_v<cpp_result::Result<int, long>>);
+  static_assert(std::is_trivially_copyable_v<cpp_result::Result<void, int>>);
+  static_assert(!std::is_trivially_copyable_v<Result<int>>);
+  static_assert(!std::is_trivially_copyable_v<cpp_result::Result<void, Error>>);
+  auto res = cpp_result::Err<int, long>(5);
+  auto copy = res;
+  EXPECT_EQ(copy.unwrap_err(), 5);
+  copy = cpp_result::Ok<int, long>(3);
+  EXPECT_EQ(copy.unwrap(), 3);
+}
+
+TEST(ResultTest, VoidErrAssignmentReplacesError) {
+  auto a = cpp_result::Err<Error>({"first"});
+  auto b = cpp_result::Err<Error>({"second"});
+  a = b;
+  EXPECT_EQ(a.unwrap_err().message, "second");
+  a = cpp_result::Ok<Error>();
+  EXPECT_TRUE(a.is_ok());
+}
+
+using cpp_result::Never;
+
+static cpp_result::Result<int, Never> doubled(int x) {
+  return cpp_result::Result<int, Never>::Ok(2 * x);
+}
+
+static Result<int> add_doubled(int x) {
+  int v = TRY(doubled(x));
+  TRY_ASSIGN(w, doubled(v));
+  return Ok<int>(v + w);
+}
+
+static Result<int> parse_digit(const cpp_result::Result<int, std::string> &r) {
+  int v = TRY_INTO(r); // std::string converts to Error
+  return Ok<int>(v);
+}
+
+TEST(ResultTest, NeverResultCannotFail) {
+  static_assert(sizeof(cpp_result::Result<int, Never>) == sizeof(int));
+  static_assert(sizeof(cpp_result::Result<std::string, Never>) ==
+                sizeof(std::string));
+  static_assert(!cpp_result::Result<int, Never>::can_fail);
+  static_assert(cpp_result::Result<int, Error>::can_fail);
+  auto r = doubled(4);
+  static_assert(!r.is_err());
+  EXPECT_EQ(std::move(r).into_ok(), 8);
+  EXPECT_EQ(add_doubled(1).unwrap(), 6);
+  using Infallible = cpp_result::Result<std::string, cpp_result::Infallible>;
+  EXPECT_EQ(Infallible::Ok("x").into_ok(), "x");
+}
+
+TEST(ResultTest, NeverValueAlwaysFails) {
+  using Failing = cpp_result::Result<Never, Error>;
+  static_assert(sizeof(Failing) == sizeof(Error));
+  static_assert(!Failing::can_succeed);
+  auto f = Failing::Err({"always"});
+  static_assert(f.is_err());
+  EXPECT_EQ(std::move(f).into_err().message, "always");
+}
+
+TEST(ResultTest, TryIntoConvertsErrorAndKeepsLvalues) {
+  auto bad = cpp_result::Result<int, std::string>::Err("not a digit");
+  EXPECT_EQ(parse_digit(bad).unwrap_err().message, "not a digit");
+  EXPECT_EQ(bad.unwrap_err(), "not a digit"); // copied, not moved from
+  EXPECT_EQ(parse_digit(cpp_result::Result<int, std::string>::Ok(7)).unwrap(),
+            7);
+}
+
+TEST(ResultTest, TryInDeducedReturnType) {
+  using R = cpp_result::Result<int, std::string>;
+  auto f = [](int x) { return x ? R::Ok(x) : R::Err("zero"); };
+  auto g = [&](int x) {
+    auto v = TRY(f(x));
+    return R::Ok(v + 1);
+  };
+  auto h = [&](int x) {
+    TRY_ASSIGN(v, g(x));
+    return R::Ok(v * 10);
+  };
+  EXPECT_EQ(g(1).unwrap(), 2);
+  EXPECT_EQ(g(0).unwrap_err(), "zero");
+  EXPECT_EQ(h(1).unwrap(), 20);
+  EXPECT_EQ(h(0).unwrap_err(), "zero");
+
+  // A Never error adds no return statement, so nothing to deduce from.
+  auto infallible = [] {
+    int v = TRY(doubled(2));
+    TRY_ASSIGN(w, doubled(v));
+    return R::Ok(w);
+  };
+  EXPECT_EQ(infallible().unwrap(), 8);
+}
+
+struct CacheMiss {
+  int key;
+};
+struct Malformed {
+  std::string what;
+};
+
+// Specialized with qualified names, as in the result_bias documentation.
+template <typename T>
+struct cpp_result::result_bias<T, CacheMiss>
+    : std::integral_constant<cpp_result::ResultBias,
+                             cpp_result::ResultBias::LikelyErr> {};
+template <>
+struct cpp_result::result_bias<void, Malformed>
+    : std::integral_constant<cpp_result::ResultBias,
+                             cpp_result::ResultBias::LikelyOk> {};
+
+using Probe = cpp_result::Result<int, CacheMiss>;
+using Check = cpp_result::Result<void, Malformed>;
+
+static Probe probe(int key) {
+  return key % 2 ? Probe::Ok(key * 10) : Probe::Err({key});
+}
+
+static Probe probe_twice(int key) {
+  int v = TRY(probe(key));
+  TRY_ASSIGN(w, probe(v / 10));
+  return Probe::Ok(v + w);
+}
+
+static Check check(const std::string &s) {
+  return s.empty() ? Check::Err({"empty"}) : Check::Ok();
+}
+
+TEST(ResultTest, BiasedResultsBehaveLikeUnbiased) {
+  static_assert(cpp_result::result_bias<int, CacheMiss>::value ==
+                cpp_result::ResultBias::LikelyErr);
+  static_assert(cpp_result::result_bias<void, Malformed>::value ==
+                cpp_result::ResultBias::LikelyOk);
+  static_assert(cpp_result::result_bias<int, Error>::value ==
+                cpp_result::ResultBias::Unbiased);
+
+  EXPECT_EQ(probe(3).map([](int v) { return v + 1; }).unwrap(), 31);
+  EXPECT_EQ(probe(4).map([](int v) { return v + 1; }).unwrap_err().key, 4);
+  EXPECT_EQ(probe(3).and_then(probe).unwrap_err().key, 30);
+  EXPECT_EQ(probe(1).and_then([](int v) { return probe(v + 1); }).unwrap(),
+            110);
+  EXPECT_EQ(probe_twice(3).unwrap(), 60);
+  EXPECT_EQ(probe_twice(2).unwrap_err().key, 2);
+
+  EXPECT_TRUE(check("x").is_ok());
+  EXPECT_EQ(check("").map_err([](Malformed m) { return m.what.size(); })
+                .unwrap_err(),
+            5u);
+}
+
+TEST(ResultTest, CallSiteBiasHints) {
+  EXPECT_TRUE(cpp_result::likely_ok(probe(1)));
+  EXPECT_FALSE(cpp_result::likely_ok(probe(2)));
+  EXPECT_TRUE(cpp_result::likely_err(probe(2)));
+  EXPECT_FALSE(cpp_result::likely_err(probe(1)));
+  EXPECT_TRUE(cpp_result::likely_ok(check("x")));
+  EXPECT_TRUE(cpp_result::likely_err(check("")));
+  EXPECT_TRUE(cpp_result::likely_ok(Ok<int>(1)));
+  EXPECT_TRUE(cpp_result::likely_err(Err<int>({"e"})));
+}
+
+TEST(ResultTest, BranchlessAccessors) {
+  using R = cpp_result::Result<double, int>;
+  EXPECT_EQ(R::Ok(2.5).select_or(1.0), 2.5);
+  EXPECT_EQ(R::Err(7).select_or(1.0), 1.0);
+  EXPECT_EQ(R::Err(7).unwrap_or_zero(), 0.0);
+  EXPECT_EQ(R::Ok(1.0).ok_mask(), ~std::uint64_t{0});
+  EXPECT_EQ(R::Err(1).ok_mask<std::uint8_t>(), 0u);
+  EXPECT_EQ(cpp_result::Ok<int>().ok_mask(), ~std::uint64_t{0});
+
+  struct Wide {
+    std::uint64_t a, b, c;
+  };
+  using W = cpp_result::Result<Wide, char>;
+  EXPECT_EQ(W::Ok({1, 2, 3}).select_or({4, 5, 6}).c, 3u);
+  EXPECT_EQ(W::Err('x').select_or({4, 5, 6}).b, 5u);
+}
+
+TEST(ResultTest, UnwrapOrByReference) {
+  const std::string fallback = "fallback";
+  auto ok = cpp_result::Result<std::string, int>::Ok("value");
+  auto err = cpp_result::Result<std::string, int>::Err(1);
+  EXPECT_EQ(&ok.unwrap_or_ref(fallback), &ok.unwrap());
+  EXPECT_EQ(&err.unwrap_or_ref(fallback), &fallback);
+  std::string moved = std::move(ok).unwrap_or("unused");
+  EXPECT_EQ(moved, "value");
+  EXPECT_EQ(err.unwrap_or("other"), "other");
+}
+
+TEST(ResultTest, InPlaceCombinators) {
+  auto r = cpp_result::Result<std::string, int>::Ok("hello");
+  const std::string *slot = &r.unwrap();
+  r.map_inplace([](std::string &s) { s += " world"; })
+      .map_err_inplace([](int &e) { e = -1; });
+  EXPECT_EQ(r.unwrap(), "hello world");
+  EXPECT_EQ(&r.unwrap(), slot);
+
+  auto old = r.replace_ok("next");
+  EXPECT_EQ(old.unwrap(), "hello world");
+  EXPECT_EQ(r.unwrap(), "next");
+
+  auto e = cpp_result::Result<std::string, int>::Err(3);
+  e.map_inplace([](std::string &s) { s = "unused"; })
+      .map_err_inplace([](int &v) { v *= 10; });
+  EXPECT_EQ(e.unwrap_err(), 30);
+  EXPECT_EQ(e.replace_ok("fixed").unwrap_err(), 30);
+  EXPECT_EQ(e.unwrap(), "fixed");
+}
+
+TEST(ResultTest, TakeLeavesDefaultBehind) {
+  auto r = cpp_result::Result<std::string, std::string>::Ok("payload");
+  EXPECT_EQ(r.take_ok(), "payload");
+  EXPECT_TRUE(r.is_ok());
+  EXPECT_EQ(r.unwrap(), "");
+  EXPECT_EQ(r.take_err(), std::nullopt);
+
+  auto v = cpp_result::Err<Error>({"gone"});
+  EXPECT_EQ(v.take_err()->message, "gone");
+  EXPECT_EQ(v.unwrap_err().message, "");
+}
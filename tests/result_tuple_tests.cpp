@@ -0,0 +1,73 @@
+#include <cpp_result/result_tuple.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+using cpp_result::Result;
+using cpp_result::ResultTuple;
+
+enum class ErrCode : std::uint16_t { Missing, Range };
+using Field = Result<std::uint32_t, ErrCode>;
+
+template <std::size_t> using FieldAt = Field;
+
+template <std::size_t... I>
+static auto make_record(std::index_sequence<I...>) {
+  return ResultTuple<FieldAt<I>...>(Field::Ok(I)...);
+}
+
+TEST(ResultTupleTest, SixteenFieldsShareOneHeader) {
+  auto rec = make_record(std::make_index_sequence<16>{});
+  static_assert(sizeof(rec) == 68);
+  static_assert(sizeof(Field) * 16 == 128);
+  static_assert(std::is_trivially_copyable_v<decltype(rec)>);
+  EXPECT_TRUE(rec.all_ok());
+  EXPECT_EQ(rec.first_err(), 16u);
+  EXPECT_EQ(rec.get<9>().unwrap(), 9u);
+
+  rec.set_err<11>(ErrCode::Range);
+  rec.set_err<4>(ErrCode::Missing);
+  EXPECT_FALSE(rec.all_ok());
+  EXPECT_EQ(rec.first_err(), 4u);
+  EXPECT_EQ(rec.ok_bits(), 0xffff & ~(1u << 11) & ~(1u << 4));
+  EXPECT_EQ(rec.get<11>().unwrap_err(), ErrCode::Range);
+  EXPECT_EQ(rec.get<4>().unwrap_or(77), 77u);
+
+  auto copy = rec;
+  copy.set<4>(Field::Ok(40));
+  copy.set_ok<11>(110);
+  EXPECT_TRUE(copy.all_ok());
+  EXPECT_EQ(copy.to_result<4>().unwrap(), 40u);
+  EXPECT_TRUE(rec.get<4>().is_err());
+}
+
+TEST(ResultTupleTest, NonTrivialPayloadsAreCopiedAndMoved) {
+  using Name = Result<std::string, std::string>;
+  using Id = Result<std::uint64_t, ErrCode>;
+  ResultTuple<Name, Id, Name> t(Name::Ok("alice"), Id::Err(ErrCode::Missing),
+                                Name::Err("too long"));
+  static_assert(!std::is_trivially_copyable_v<decltype(t)>);
+  EXPECT_EQ(t.first_err(), 1u);
+  EXPECT_EQ(t.get<0>().unwrap(), "alice");
+  EXPECT_EQ(t.get<2>().unwrap_err(), "too long");
+
+  auto copy = t;
+  copy.set_ok<2>("bob");
+  EXPECT_EQ(copy.get<2>().unwrap(), "bob");
+  EXPECT_EQ(t.get<2>().unwrap_err(), "too long");
+
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved.get<0>().unwrap(), "alice");
+  moved = t;
+  EXPECT_TRUE(moved.get<2>().is_err());
+  EXPECT_EQ(moved.to_result<2>().unwrap_err(), "too long");
+}
+
+TEST(ResultTupleTest, MixedAlignmentsPackInOrder) {
+  using Byte = Result<std::uint8_t, std::uint8_t>;
+  using Wide = Result<double, std::uint8_t>;
+  ResultTuple<Byte, Byte, Wide> t(Byte::Ok(1), Byte::Err(2), Wide::Ok(0.5));
+  static_assert(sizeof(t) == 24); // 2 bytes, pad to 8, 8 bytes, header
+  EXPECT_EQ(t.get<1>().unwrap_err(), 2);
+  EXPECT_EQ(t.get<2>().unwrap(), 0.5);
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cpp_result/retry.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using cpp_result::RetryBudget;
+using cpp_result::RetryPolicy;
+using cpp_result::Result;
+using namespace std::chrono_literals;
+
+enum class Rpc { Unavailable, Invalid };
+using R = Result<int, Rpc>;
+
+static std::vector<std::chrono::nanoseconds> g_sleeps;
+static void record_sleep(std::chrono::nanoseconds d) { g_sleeps.push_back(d); }
+
+static RetryPolicy test_policy() {
+  RetryPolicy policy;
+  policy.max_attempts = 4;
+  policy.base_delay = 10ms;
+  policy.max_delay = 25ms;
+  policy.jitter = 0.0;
+  policy.sleep = &record_sleep;
+  g_sleeps.clear();
+  return policy;
+}
+
+TEST(RetryTest, RetriesUntilOkWithBackoff) {
+  int calls = 0;
+  auto r = cpp_result::retry(
+      [&] { return ++calls < 3 ? R::Err(Rpc::Unavailable) : R::Ok(calls); },
+      test_policy());
+  EXPECT_EQ(r.unwrap(), 3);
+  ASSERT_EQ(g_sleeps.size(), 2u);
+  EXPECT_EQ(g_sleeps[0], 10ms);
+  EXPECT_EQ(g_sleeps[1], 20ms);
+}
+
+TEST(RetryTest, StopsAtMaxAttemptsAndCapsDelay) {
+  int calls = 0;
+  auto r = cpp_result::retry([&] { return ++calls, R::Err(Rpc::Unavailable); },
+                             test_policy());
+  EXPECT_EQ(r.unwrap_err(), Rpc::Unavailable);
+  EXPECT_EQ(calls, 4);
+  ASSERT_EQ(g_sleeps.size(), 3u);
+  EXPECT_EQ(g_sleeps[2], 25ms);
+}
+
+TEST(RetryTest, ClassifierRejectsPermanentErrors) {
+  int calls = 0;
+  auto r = cpp_result::retry([&] { return ++calls, R::Err(Rpc::Invalid); },
+                             test_policy(),
+                             [](Rpc e) { return e == Rpc::Unavailable; });
+  EXPECT_EQ(r.unwrap_err(), Rpc::Invalid);
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(g_sleeps.empty());
+}
+
+TEST(RetryTest, JitterStaysWithinDelay) {
+  RetryPolicy policy = test_policy();
+  policy.max_attempts = 50;
+  policy.base_delay = policy.max_delay = 1ms;
+  policy.jitter = 1.0;
+  (void)cpp_result::retry([] { return R::Err(Rpc::Unavailable); }, policy);
+  ASSERT_EQ(g_sleeps.size(), 49u);
+  bool varied = false;
+  for (auto d : g_sleeps) {
+    EXPECT_GE(d, 0ns);
+    EXPECT_LE(d, 1ms);
+    varied |= d != g_sleeps[0];
+  }
+  EXPECT_TRUE(varied);
+}
+
+// A dependency that is down: every call fails. Without a budget each
+// request costs max_attempts calls; with a 10% budget the extra load stays
+// near 10% once the reserve is spent.
+TEST(RetryTest, BudgetBoundsLoadUnderOverload) {
+  constexpr int kRequests = 10000;
+  RetryPolicy policy = test_policy();
+  policy.max_attempts = 5;
+  long calls = 0;
+  auto down = [&] { return ++calls, R::Err(Rpc::Unavailable); };
+
+  for (int i = 0; i < kRequests; ++i)
+    (void)cpp_result::retry(down, policy);
+  EXPECT_EQ(calls, 5L * kRequests);
+
+  RetryBudget budget(0.1, 10);
+  policy.budget = &budget;
+  calls = 0;
+  for (int i = 0; i < kRequests; ++i)
+    (void)cpp_result::retry(down, policy);
+  EXPECT_LE(calls, kRequests + kRequests / 10 + 10);
+  EXPECT_EQ(budget.retries(), static_cast<std::uint64_t>(calls - kRequests));
+  EXPECT_GT(budget.denied(), 0u);
+}
+
+TEST(RetryTest, BudgetRefillsWithSuccessfulTraffic) {
+  RetryBudget budget(0.5, 1);
+  EXPECT_TRUE(budget.try_withdraw());
+  EXPECT_FALSE(budget.try_withdraw());
+  budget.deposit();
+  budget.deposit();
+  EXPECT_DOUBLE_EQ(budget.tokens(), 1.0);
+  for (int i = 0; i < 10; ++i)
+    budget.deposit();
+  EXPECT_DOUBLE_EQ(budget.tokens(), 1.0); // capped at the reserve
+  EXPECT_TRUE(budget.try_withdraw());
+  EXPECT_EQ(budget.retries(), 2u);
+  EXPECT_EQ(budget.denied(), 1u);
+}
@@ -0,0 +1,180 @@
+#include <chrono>
+#include <cpp_result/shm_queue.hpp>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <utility>
+#include <vector>
+
+using cpp_result::QueueError;
+using cpp_result::QueueMode;
+using Queue = cpp_result::ShmQueue<std::uint64_t, int>;
+using Item = Queue::Item;
+using namespace std::chrono_literals;
+
+static int wait_child(pid_t pid) {
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+TEST(ShmQueueTest, PushPopInOneProcess) {
+  auto q = std::move(Queue::create(4).unwrap());
+  EXPECT_EQ(q.capacity(), 4u);
+  auto tx = std::move(q.producer().unwrap());
+  auto rx = std::move(q.consumer().unwrap());
+
+  EXPECT_EQ(rx.try_pop().unwrap_err().kind, QueueError::Kind::Empty);
+  for (std::uint64_t i = 0; i < 4; ++i)
+    ASSERT_TRUE(i == 2 ? tx.try_push(Item::Err(7)).is_ok()
+                       : tx.try_push(Item::Ok(i)).is_ok());
+  EXPECT_EQ(tx.try_push(Item::Ok(9)).unwrap_err().kind,
+            QueueError::Kind::Full);
+
+  EXPECT_EQ(rx.try_pop().unwrap().unwrap(), 0u);
+  EXPECT_EQ(rx.pop().unwrap().unwrap(), 1u);
+  EXPECT_EQ(rx.pop().unwrap().unwrap_err(), 7);
+  EXPECT_EQ(rx.pop().unwrap().unwrap(), 3u);
+  EXPECT_EQ(rx.pop(1ms).unwrap_err().kind, QueueError::Kind::Timeout);
+}
+
+TEST(ShmQueueTest, BatchPushWrapsAround) {
+  auto q = std::move(Queue::create(8).unwrap());
+  auto tx = std::move(q.producer().unwrap());
+  auto rx = std::move(q.consumer().unwrap());
+  std::vector<Item> in;
+  for (std::uint64_t i = 0; i < 6; ++i)
+    in.push_back(Item::Ok(i));
+  std::vector<Item> out;
+  for (int round = 0; round < 3; ++round) {
+    ASSERT_TRUE(tx.push_n(in.data(), in.size(), 0ns).is_ok());
+    out.clear();
+    ASSERT_EQ(rx.pop_n(out, 100).unwrap(), 6u);
+    for (std::uint64_t i = 0; i < 6; ++i)
+      EXPECT_EQ(out[i].unwrap(), i);
+  }
+}
+
+TEST(ShmQueueTest, SingleProducerAndConsumerLeases) {
+  auto q = std::move(Queue::create(8).unwrap());
+  auto tx = std::move(q.producer().unwrap());
+  EXPECT_EQ(q.producer().unwrap_err().kind, QueueError::Kind::Busy);
+  auto rx = std::move(q.consumer().unwrap());
+  EXPECT_EQ(q.consumer().unwrap_err().kind, QueueError::Kind::Busy);
+}
+
+TEST(ShmQueueTest, ForkedProducersDeliverEverything) {
+  constexpr int kProducers = 4;
+  constexpr std::uint64_t kPerProducer = 20000;
+  auto q = std::move(Queue::create(256, QueueMode::Mpsc).unwrap());
+  std::vector<pid_t> children;
+  for (int p = 0; p < kProducers; ++p) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      int rc = 0;
+      {
+        auto tx = std::move(q.producer().unwrap());
+        std::vector<Item> batch;
+        for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+          batch.push_back(i % 100 == 0 ? Item::Err(p) : Item::Ok(i));
+          if (batch.size() == 32 || i + 1 == kPerProducer) {
+            rc |= tx.push_n(batch.data(), batch.size()).is_err();
+            batch.clear();
+          }
+        }
+      }
+      _exit(rc);
+    }
+    children.push_back(pid);
+  }
+
+  auto rx = std::move(q.consumer().unwrap());
+  std::vector<Item> out;
+  std::uint64_t sum = 0, errors = 0, total = 0;
+  for (;;) {
+    out.clear();
+    auto got = rx.pop_n(out, 64, 10s);
+    if (got.is_err()) {
+      EXPECT_EQ(got.unwrap_err().kind, QueueError::Kind::Closed);
+      break;
+    }
+    for (auto &item : out) {
+      ++total;
+      if (item.is_ok())
+        sum += item.unwrap();
+      else
+        ++errors;
+    }
+  }
+  for (pid_t pid : children)
+    EXPECT_EQ(wait_child(pid), 0);
+  EXPECT_EQ(total, kProducers * kPerProducer);
+  EXPECT_EQ(errors, kProducers * kPerProducer / 100);
+  std::uint64_t expected = 0;
+  for (std::uint64_t i = 0; i < kPerProducer; ++i)
+    if (i % 100)
+      expected += i;
+  EXPECT_EQ(sum, kProducers * expected);
+}
+
+TEST(ShmQueueTest, CrashedProducerIsPeerDead) {
+  auto q = std::move(Queue::create(16).unwrap());
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    auto tx = std::move(q.producer().unwrap());
+    (void)tx.push(Item::Ok(1));
+    _exit(0); // Leaves the lease held, like a crash.
+  }
+  auto rx = std::move(q.consumer().unwrap());
+  EXPECT_EQ(rx.pop(10s).unwrap().unwrap(), 1u);
+  EXPECT_EQ(rx.pop(10s).unwrap_err().kind, QueueError::Kind::PeerDead);
+  wait_child(pid);
+}
+
+TEST(ShmQueueTest, CrashedConsumerIsPeerDead) {
+  auto q = std::move(Queue::create(2).unwrap());
+  int ready[2];
+  ASSERT_EQ(pipe(ready), 0);
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    auto rx = std::move(q.consumer().unwrap());
+    (void)!write(ready[1], "x", 1);
+    _exit(0);
+  }
+  char c;
+  ASSERT_EQ(read(ready[0], &c, 1), 1);
+  wait_child(pid);
+  auto tx = std::move(q.producer().unwrap());
+  ASSERT_TRUE(tx.try_push(Item::Ok(1)).is_ok());
+  ASSERT_TRUE(tx.try_push(Item::Ok(2)).is_ok());
+  EXPECT_EQ(tx.push(Item::Ok(3), 10s).unwrap_err().kind,
+            QueueError::Kind::PeerDead);
+  close(ready[0]);
+  close(ready[1]);
+}
+
+TEST(ShmQueueTest, AttachChecksLayout) {
+  auto q = std::move(Queue::create(8).unwrap());
+  auto same = Queue::attach(dup(q.fd()));
+  ASSERT_TRUE(same.is_ok());
+  EXPECT_EQ(same.unwrap().capacity(), 8u);
+  {
+    auto tx = std::move(same.unwrap().producer().unwrap());
+    ASSERT_TRUE(tx.try_push(Item::Ok(5)).is_ok());
+  }
+  EXPECT_EQ(q.consumer().unwrap().try_pop().unwrap().unwrap(), 5u);
+
+  using Other = cpp_result::ShmQueue<char, char>;
+  auto other = Other::attach(dup(q.fd()));
+  ASSERT_TRUE(other.is_err());
+  EXPECT_EQ(other.unwrap_err().kind, QueueError::Kind::Incompatible);
+}
+
+TEST(ShmQueueTest, RejectsCapacityThatCannotRoundUp) {
+  auto q = Queue::create(Queue::kMaxCapacity + 1);
+  ASSERT_TRUE(q.is_err());
+  EXPECT_EQ(q.unwrap_err(),
+            (QueueError{QueueError::Kind::Create, cpp_result::Errno{EINVAL}}));
+}
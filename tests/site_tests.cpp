@@ -0,0 +1,60 @@
+#include <cpp_result/site.hpp>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+using cpp_result::Result;
+using cpp_result::Traced;
+
+enum class ParseError { Empty, BadDigit };
+struct ConfigError {
+  ParseError cause;
+  ConfigError(ParseError e) : cause(e) {}
+};
+
+static unsigned g_empty_line;
+
+static Result<int, Traced<ParseError>> parse_digit(const std::string &s) {
+  using R = Result<int, Traced<ParseError>>;
+  if (s.empty()) {
+    g_empty_line = __LINE__ + 1;
+    return R::Err(ERR_HERE(ParseError::Empty));
+  }
+  if (s[0] < '0' || s[0] > '9')
+    return R::Err(ERR_HERE_MSG(ParseError::BadDigit, "not a digit"));
+  return R::Ok(s[0] - '0');
+}
+
+static Result<int, Traced<ConfigError>> load_port(const std::string &s) {
+  int d = TRY_INTO(parse_digit(s));
+  return Result<int, Traced<ConfigError>>::Ok(8000 + d);
+}
+
+TEST(SiteTest, ErrorRecordsWhereItWasRaised) {
+  static_assert(sizeof(Traced<ParseError>) == 2 * sizeof(void *));
+  auto r = parse_digit("");
+  const cpp_result::Site *site = r.unwrap_err().site();
+  ASSERT_NE(site, nullptr);
+  EXPECT_NE(std::strstr(site->file, "site_tests.cpp"), nullptr);
+  EXPECT_EQ(site->line, g_empty_line);
+  EXPECT_STREQ(site->function, "parse_digit");
+  EXPECT_EQ(site->message, nullptr);
+  EXPECT_STREQ(parse_digit("x").unwrap_err().site()->message, "not a digit");
+}
+
+TEST(SiteTest, SitesAreStaticConstants) {
+  auto a = parse_digit("");
+  auto b = parse_digit("");
+  EXPECT_EQ(a.unwrap_err().site(), b.unwrap_err().site());
+  EXPECT_NE(a.unwrap_err().site(), parse_digit("x").unwrap_err().site());
+  EXPECT_EQ(a.unwrap_err(), b.unwrap_err());
+}
+
+TEST(SiteTest, TryKeepsTheOriginatingSite) {
+  auto r = load_port("");
+  ASSERT_TRUE(r.is_err());
+  EXPECT_EQ(r.unwrap_err().error().cause, ParseError::Empty);
+  EXPECT_EQ(r.unwrap_err().site()->line, g_empty_line);
+  EXPECT_STREQ(r.unwrap_err().site()->function, "parse_digit");
+  EXPECT_EQ(load_port("7").unwrap(), 8007);
+}
@@ -0,0 +1,101 @@
+#include <cpp_result/uring.hpp>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using cpp_result::BatchIo;
+using cpp_result::IoOp;
+using cpp_result::IoUring;
+
+class UringTest : public ::testing::TestWithParam<BatchIo::Backend> {
+protected:
+  void SetUp() override {
+    char tmpl[] = "/tmp/cpp_result_uring_XXXXXX";
+    fd_ = ::mkstemp(tmpl);
+    ASSERT_NE(fd_, -1);
+    ::unlink(tmpl);
+    std::string data;
+    for (int i = 0; i < 64; ++i)
+      data += std::string(4096, static_cast<char>('a' + i % 26));
+    ASSERT_TRUE(
+        cpp_result::posix::write_full(fd_, data.data(), data.size()).is_ok());
+  }
+  void TearDown() override { ::close(fd_); }
+
+  BatchIo make_io(unsigned entries) {
+    if (GetParam() == BatchIo::Backend::Sync)
+      return BatchIo::create_sync();
+    auto io = BatchIo::create(entries);
+    if (io.backend() != BatchIo::Backend::IoUring)
+      ADD_FAILURE() << "io_uring unavailable";
+    return io;
+  }
+
+  int fd_ = -1;
+};
+
+TEST_P(UringTest, BatchReadsCompleteInOrder) {
+  if (GetParam() == BatchIo::Backend::IoUring &&
+      IoUring::create(4).is_err())
+    GTEST_SKIP() << "io_uring unavailable";
+  auto io = make_io(4);
+  std::vector<std::string> bufs(10, std::string(4096, '\0'));
+  std::vector<IoOp> ops;
+  for (std::size_t i = 0; i < bufs.size(); ++i)
+    ops.push_back(IoOp::read(fd_, bufs[i].data(), 4096,
+                             static_cast<std::uint64_t>(9 - i) * 4096));
+  auto done = io.submit(ops);
+  ASSERT_TRUE(done.is_ok());
+  ASSERT_EQ(done.unwrap().size(), ops.size());
+  EXPECT_TRUE(done.unwrap().all_ok());
+  for (std::size_t i = 0; i < bufs.size(); ++i) {
+    EXPECT_EQ(done.unwrap()[i].unwrap(), 4096u);
+    EXPECT_EQ(bufs[i][0], static_cast<char>('a' + (9 - i)));
+  }
+}
+
+TEST_P(UringTest, PerOperationErrors) {
+  if (GetParam() == BatchIo::Backend::IoUring &&
+      IoUring::create(4).is_err())
+    GTEST_SKIP() << "io_uring unavailable";
+  auto io = make_io(8);
+  char buf[16];
+  std::vector<IoOp> ops = {IoOp::read(fd_, buf, sizeof(buf), 0),
+                           IoOp::read(-1, buf, sizeof(buf), 0),
+                           IoOp::read(fd_, buf, sizeof(buf), 1u << 30)};
+  auto done = io.submit(ops).unwrap();
+  EXPECT_EQ(done[0].unwrap(), sizeof(buf));
+  EXPECT_EQ(done[1].unwrap_err(), EBADF);
+  EXPECT_EQ(done[2].unwrap(), 0u);
+  EXPECT_FALSE(done.all_ok());
+  EXPECT_EQ(done.error_count(), 1u);
+}
+
+TEST_P(UringTest, WritesThenReads) {
+  if (GetParam() == BatchIo::Backend::IoUring &&
+      IoUring::create(4).is_err())
+    GTEST_SKIP() << "io_uring unavailable";
+  auto io = make_io(2);
+  const std::string a = "first", b = "second";
+  auto wrote = io.submit({IoOp::write(fd_, a.data(), 5, 0),
+                          IoOp::write(fd_, b.data(), 6, 5)});
+  ASSERT_TRUE(wrote.unwrap().all_ok());
+  char buf[11];
+  auto read = io.submit({IoOp::read(fd_, buf, sizeof(buf), 0)});
+  EXPECT_EQ(read.unwrap()[0].unwrap(), sizeof(buf));
+  EXPECT_EQ(std::string(buf, sizeof(buf)), "firstsecond");
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, UringTest,
+                         ::testing::Values(BatchIo::Backend::IoUring,
+                                           BatchIo::Backend::Sync));
+
+TEST(IoUringTest, MoveKeepsRingUsable) {
+  auto ring = IoUring::create(8);
+  if (ring.is_err())
+    GTEST_SKIP() << "io_uring unavailable";
+  IoUring moved = std::move(ring.unwrap());
+  EXPECT_GE(moved.capacity(), 8u);
+  EXPECT_TRUE(moved.submit(nullptr, 0).unwrap().empty());
+}